@@ -0,0 +1,59 @@
+#include <lcs/lcs.h>
+
+// All classes of the libLCS are defined in the namespace lcs.
+using namespace lcs;
+
+int main(void)
+{
+    // The definition of a one bit full adder built from primitive cells. The definition
+    // is only a description; it is simulated after it is instantiated and flattened.
+    Circuit fa("fulladder");
+    int a = fa.addInput("a"), b = fa.addInput("b"), c = fa.addInput("c");
+    int s = fa.addOutput("s"), cout = fa.addOutput("cout");
+    int ab = fa.addNet("ab"), axb = fa.addNet("axb"), cx = fa.addNet("cx");
+
+    fa.addCell(PARITY_CELL, a, b, axb);
+    fa.addCell(PARITY_CELL, axb, c, s);
+    fa.addCell(AND_CELL, a, b, ab);
+    fa.addCell(AND_CELL, axb, c, cx);
+    fa.addCell(OR_CELL, ab, cx, cout);
+
+    // A two bit adder made of two instances of the full adder definition.
+    Circuit adder("adder");
+    int x = adder.addInput("x", 2), y = adder.addInput("y", 2);
+    int sum = adder.addOutput("sum", 3);
+    int c1 = adder.addNet("c1");
+
+    int u0 = adder.addInstance("u0", fa), u1 = adder.addInstance("u1", fa);
+    adder.connect(u0, "a", x);
+    adder.connect(u0, "b", y);
+    adder.connect(u0, "c", adder.addConstant(LOW));
+    adder.connect(u0, "s", sum);
+    adder.connect(u0, "cout", c1);
+    adder.connect(u1, "a", x+1);
+    adder.connect(u1, "b", y+1);
+    adder.connect(u1, "c", c1);
+    adder.connect(u1, "s", sum+1);
+    adder.connect(u1, "cout", sum+2);
+
+    // The adder is flattened into a netlist of cells before it is simulated.
+    FlatNetlist flat(adder);
+
+    Bus<2> X, Y;
+    Bus<3> S;
+
+    NetlistSimulator sim(flat);
+    sim.bindInput("x", X);
+    sim.bindInput("y", Y);
+    sim.bindOutput("sum", S);
+
+    ChangeMonitor<4> inputMonitor((X,Y), "Input", DUMP_ON);
+    ChangeMonitor<3> outputMonitor(S, "Sum", DUMP_ON);
+
+    Tester<4> tester((X,Y));
+
+    Simulation::setStopTime(2000);
+    Simulation::start();
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/bus.h>
+#include <lcs/tester.h>
+#include <lcs/simul.h>
+#include <lcs/changeMonitor.h>
+
+// All classes of the libLCS are defined in the namespace lcs.
+using namespace lcs;
+
+int main(void)
+{
+    // In the expression graph mode, the continuous assignments are evaluated together
+    // in a single shared graph instead of in a hidden module each.
+    Simulation::setExpressionGraphMode(true);
+
+    Bus<1> a, b, c, d;
+
+    // The line b is assigned the line a directly, and hence follows a leaf of the graph.
+    // The lines c and d follow expressions of a.
+    b.cass<0>(a);
+    c.cass<0>(~a);
+    d.cass<2>(a);
+
+    ChangeMonitor<1> input(a, "a", DUMP_ON);
+    ChangeMonitor<3> output((b,c,d), "(b,c,d)", DUMP_ON);
+
+    Tester<1> tester(a);
+
+    Simulation::setStopTime(500);
+    Simulation::start();
+
+    return 0;
+}
@@ -26,6 +26,7 @@
 #include <lcs/bus.h>
 #include <lcs/clock.h>
 #include <lcs/module.h>
+#include <lcs/nonblocking.h>
 #include <lcs/simul.h>
 #include <lcs/changeMonitor.h>
 
@@ -75,6 +76,12 @@ Counter::~Counter()
 
 void Counter::onPosEdge(int portId)
 {
+    // The new count is written through a nonblocking assignment,
+    // so that other modules triggered by the same clock edge
+    // read the count as it was before the edge, irrespective
+    // of the order in which they are notified.
+    NonblockingAssignment nba;
+
     int val = outBus.toInt(); 
 
     if (val == 15) // If the bus holds a value of fifteen, then reset the value to zero.
@@ -0,0 +1,120 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/bus.h>
+#include <lcs/tester.h>
+#include <lcs/simul.h>
+#include <lcs/changeMonitor.h>
+
+// All classes of the libLCS are defined in the namespace lcs.
+using namespace lcs;
+
+using namespace std;
+
+// Define a class OnesCounter. The instances of this class count the number of lines of an
+// 8-bit input bus which are HIGH. Instead of counting all the input lines again whenever
+// an input changes, the module keeps the count and only adjusts it for the lines which
+// changed.
+class OnesCounter : public Module
+{
+public:
+    // The constructor takes the 4-bit output bus and the 8-bit input bus.
+    OnesCounter(const Bus<4> &Count, const InputBus<8> &In);
+
+    // Destructor.
+    //
+    ~OnesCounter();
+
+    // This function is re-implemented from the class lcs::Module.
+    // As the module registers with its input bus using lcs::InputBus::notifyBits, the
+    // bus calls this function with the indices of the input lines which changed, and the
+    // states which those lines had before the change.
+    virtual void onBitsChange(int portId, const BitChange *changes, int count);
+
+private:
+    Bus<4> out;
+    InputBus<8> in;
+    int ones;
+};
+
+OnesCounter::OnesCounter(const Bus<4> &Count, const InputBus<8> &In)
+         : Module(), out(Count), in(In), ones(0)
+{
+    // Registering through notifyBits, instead of notify, lets the module know which of
+    // the lines of the bus changed.
+    in.notifyBits(this, 0);
+
+    for (int i = 0; i < 8; i++)
+    {
+        if (in.get(i) == HIGH)
+            ones++;
+    }
+
+    out = ones;
+}
+
+OnesCounter::~OnesCounter()
+{
+    // A module registered using notifyBits is de-registered in the usual manner.
+    in.stopNotification(this, LINE_STATE_CHANGE, 0);
+}
+
+void OnesCounter::onBitsChange(int portId, const BitChange *changes, int count)
+{
+    // Only the lines which changed are looked at. Every change holds the index of the line
+    // and the state of the line before the change; the current state is read from the bus.
+    for (int k = 0; k < count; k++)
+    {
+        if (changes[k].previous == HIGH)
+            ones--;
+
+        if (in.get(changes[k].bit) == HIGH)
+            ones++;
+    }
+
+    out = ones;
+}
+
+int main(void)
+{
+    // Declaring the busses involved in out circuit.
+    Bus<8> data(0);
+    Bus<4> ones;
+
+    // Initialising the counter module.
+    OnesCounter counter(ones, data);
+
+    // Initialising lcs::ChangeMonitor objects which monitor the input and the count.
+    ChangeMonitor<8> inputMonitor(data, "Data");
+    ChangeMonitor<4> outputMonitor(ones, "Ones");
+
+    // The tester object which will feed in a different input at every clock
+    // state change, starting from 0 in sequence.
+    Tester<8> tester(data);
+
+    Simulation::setStopTime(4000); // Set the time upto which the simulation should run.
+    Simulation::start();           // Start the simulation.
+
+    return 0;
+}
@@ -25,7 +25,7 @@
 #ifndef __LCS_AND_H__
 #define __LCS_AND_H__
 
-#include "module.h"
+#include "dyngate.h"
 #include "bus.h"
 #include "linestate.h"
 
@@ -39,18 +39,8 @@ namespace lcs
 /// to N. The second template parameter indicates the propogation delay from the input
 /// to the output of the AND gate.
 template <unsigned int width = 1, unsigned int delay = 0>
-class And : public Module
+class And : public DynGate
 {
-public:
-
-    /// A constant integer which denotes the port id for the input port/bus.
-    ///
-    static const int INPUT;
-
-    /// A constant integer which denotes the port id for the output bus/port.
-    ///
-    static const int OUTPUT;
-
 public:
 
     /// This is the only meaningfull constructor for the class.
@@ -60,55 +50,29 @@ public:
     /// \param output The single line output bus of the gate.
     /// \param input The multiline input bus to the gate.
     /// \param width The number of lines in the input bus.
+    /// \param evaluation The manner in which the gate evaluates its output. See
+    /// \p lcs::GateEvaluation.
     ///
-    And(const Bus<1> &output, const InputBus<width> &in1);
-
-    /// Destructor.
-    ///
-    virtual ~And();
+    And(const Bus<1> &output, const InputBus<width> &input,
+        GateEvaluation evaluation = AUTOMATIC_GATE_EVALUATION);
 
-    /// Propogates the input data line states to the output when the line states of the
-    /// input bus change. Specifically, an AND operation is performed on the line states
-    /// of the data lines of the input bus, and the result is propogated to the single line
-    /// output bus when a call is made to this function.
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output is driven with the delay of the gate; see \p lcs::DynGate::onStateChange.
     virtual void onStateChange(int portId);
-
-private:
-    Bus<1> outBus;
-    InputBus<width> inBus;
 };
 
-template <unsigned int width, unsigned int delay> const int And<width, delay>::INPUT   = 0;
-template <unsigned int width, unsigned int delay> const int And<width, delay>::OUTPUT  = 1;
-
 template <unsigned int width, unsigned int delay>
-And<width, delay>::And(const Bus<1>& output, const InputBus<width> &in)
-                    : Module(), outBus(output), inBus(in)
+And<width, delay>::And(const Bus<1> &output, const InputBus<width> &input,
+                       GateEvaluation evaluation)
+    : DynGate(AND_GATE, output, input, delay, evaluation)
 {
-    inBus.notify(this, LINE_STATE_CHANGE, INPUT);
-    onStateChange(0);
-}
-
-template <unsigned int width, unsigned int delay>
-And<width, delay>::~And()
-{
-    inBus.stopNotification(this, LINE_STATE_CHANGE, INPUT);
+    setBatchEvaluator(&DynGate::evaluateBatch<delay>);
 }
 
 template <unsigned int width, unsigned int delay>
 void And<width, delay>::onStateChange(int portId)
 {
-    for (unsigned int i = 0; i < width; i++)
-    {
-        if (inBus[i] == LOW || inBus[i] == UNKNOWN || inBus[i] == HIGH_IMPEDENCE)
-        {
-            outBus = (delay, LOW);
-            return;
-        }
-    }
-
-    outBus = (delay, HIGH);
-    return;
+    evaluate<delay>(portId);
 }
 
 } // End of namespace lcs
@@ -40,8 +40,9 @@ template <int bits>
 class BitBuff;
 
 /// A class which is denotes a single bit. A bit object holds a \p lcs::LineState value.
-/// Users of libLCS will not need to directly use \p Bit objects under normal circumstances. One has
-/// to use objects of class \p lcs::BitBuffer, which bundles one or more \p Bit objects, as neccesary.
+/// The modules registered with a bit are notified only when its state changes. Users of libLCS
+/// will not need to directly use \p Bit objects under normal circumstances. One has to use
+/// objects of class \p lcs::BitBuff, which holds one or more bits packed together, as neccesary.
 class Bit
 {
 
@@ -84,16 +85,13 @@ private:
 
     /// A \p lcs::Module (or its derivative) should register to be notified by the bit about
     /// a bit state change using this function. However, since this function is declared as a
-    /// private member, one cannot use this function directly. See \p lcs::BitBuff::notify
-    /// for more information. The \p lcs::Bit::notify is called by the function
-    /// \p lcs::BitBuff::notify.
+    /// private member, one cannot use this function directly.
     void notify(Module *mod);
 
     /// A lcs::Module (or its derivative) can de-register itself from being notified by the
     /// bit using this function. See \p lcs::Bit::notify for more information. As with
     /// \p lcs::Bit::notify, even this function is declared private and hence cannot be
-    /// used directly. One has to use \p lcs::BitBuff::stopNotification, which internally makes
-    /// a call to \p lcs::Bit::stopNotification.
+    /// used directly.
     void stopNotification(Module *mod);
 
 private:
@@ -26,9 +26,9 @@
 #define __LCS_BIT_BUFF_H__
 
 #include "linestate.h"
-#include "array1d.h"
+#include "bitplanes.h"
 #include "expression.h"
-#include "bit.h"
+#include "wordstate.h"
 #include <sstream>
 
 namespace lcs
@@ -40,10 +40,15 @@ class InputBus;
 template <int w, ExprType Type, typename LExprType, typename RExprType>
 class Expression;
 
-/// A utility class which encapsulates a group of \p lcs::Bit objects. Objects of this class should
-/// typically be used as temporary/intermediate data storage buffers.
+/// A utility class which encapsulates a group of bits. Objects of this class should
+/// typically be used as temporary/intermediate data storage buffers. The states of the bits
+/// are held packed in an \p lcs::BitPlanes object, which is shared by the copies of the
+/// buffer and by the part-selects and bit-selects taken from it. Assignments from
+/// expressions, busses and other buffers are made a whole word at a time, and the modules
+/// registered with the buffer are notified only if a bit they are interested in has
+/// changed, once per assignment.
 template <int bits = 1>
-class BitBuff : protected Array1D<Bit, bits>
+class BitBuff
 {
 
 template <int w, ExprType Type, typename LExprType, typename RExprType>
@@ -54,11 +59,11 @@ friend class BitBuff;
 
 public:
 
-    /// Default constructor.
+    /// Default constructor. All the bits are initialised to \p lcs::UNKNOWN.
     ///
     BitBuff(void);
 
-    /// Copy constructor.
+    /// Copy constructor. The new buffer shares the bits of \p reg.
     ///
     BitBuff(const BitBuff<bits> &reg);
 
@@ -67,8 +72,9 @@ public:
     virtual ~BitBuff();
 
     /// Returns a part-buffer formed from a set of consecutive bits of the original
-    /// \p BitBuffer object. If \p s+w goes beyond the range of the original bus
-    /// width, then, only the bits within range are assigned to the bits of the new bus object.
+    /// \p BitBuffer object. The part-buffer shares the bits of the original buffer. If
+    /// \p s+w goes beyond the range of the original bus width, then, the part-buffer is a
+    /// new buffer to which only the bits within range are copied.
     ///
     /// \param w The width of the part-buffer.
     /// \param s The start bit from where the part-buffer should be accumulated.
@@ -99,8 +105,16 @@ public:
     ///
     std::string toStr(void) const;
 
-    /// Assignment operator.
+    /// Returns the states of all the bits of the buffer.
     ///
+    const WordState<bits> word(void) const;
+
+    /// Assignment operator. The buffer is made to share the bits of \p rhs.
+    ///
+    BitBuff<bits>& operator=(const BitBuff<bits>& rhs);
+
+    /// Assignment operator which copies the states of the bits of a buffer of a different
+    /// width.
     template <int rbits>
     BitBuff<bits>& operator=(const BitBuff<rbits>& rhs);
 
@@ -126,33 +140,65 @@ public:
     /// bitwise operations.
     Expression<1, BITBUFF_EXPR, void, void> operator[](int index) throw (OutOfRangeException<int>);
 
+private:
+
+    /// Constructs a buffer which shares the bits of \p planes starting at the index
+    /// \p offset.
+    BitBuff(BitPlanes *planes, int offset);
+
+    /// Returns the state of the bit at the index \p index.
+    ///
+    const LineState get(int index) const { return planes_->get(offset_ + index); }
+
+    /// Writes the low bits of \p value to the buffer. If \p value is narrower than the
+    /// buffer, the bits beyond its width are left unchanged.
+    template <int w>
+    void assign(const WordState<w> &value);
+
+    BitPlanes *planes_;
+    int offset_;
 };
 
 template <int bits>
 BitBuff<bits>::BitBuff(void)
-              : Array1D<Bit, bits>()
+              : planes_(new BitPlanes(bits)), offset_(0)
 {}
 
 template <int bits>
 BitBuff<bits>::BitBuff(const BitBuff<bits> &reg)
-              : Array1D<Bit, bits>(reg)
-{}
+              : planes_(reg.planes_), offset_(reg.offset_)
+{
+    planes_->acquire();
+}
+
+template <int bits>
+BitBuff<bits>::BitBuff(BitPlanes *planes, int offset)
+              : planes_(planes), offset_(offset)
+{
+    planes_->acquire();
+}
 
 template <int bits>
 BitBuff<bits>::~BitBuff(void)
-{}
+{
+    planes_->release();
+}
 
 template <int bits>
 template <int w>
 const BitBuff<w> BitBuff<bits>::partSelect(int s)
 {
-    BitBuff<w> newBuff;
-    Bit *ndata = newBuff.dataPtr->data;
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
+    if (s >= 0 && s + w <= bits)
+        return BitBuff<w>(planes_, offset_ + s);
 
+    BitBuff<w> newBuff;
     for (int i = s; (i < bits && i-s < w); i++)
     {
-        ndata[i-s] = data[i];
+        if (i >= 0)
+        {
+            unsigned int state = get(i), value = state & 1, unknown = state >> 1;
+            newBuff.planes_->write(i-s, 1, &value, &unknown);
+        }
     }
 
     return newBuff;
@@ -161,56 +207,32 @@ const BitBuff<w> BitBuff<bits>::partSelect(int s)
 template <int bits>
 void BitBuff<bits>::notify(Module *mod, int bit)
 {
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-
     if (bit < 0)
-    {
-        for (int i = 0; i < bits; i++)
-            data[i].notify(mod);
-    }
+        planes_->notify(mod, offset_, bits);
     else if (bit < bits)
-    {
-        data[bit].notify(mod);
-    }
+        planes_->notify(mod, offset_ + bit, 1);
 }
 
 template <int bits>
 void BitBuff<bits>::stopNotification(Module *mod, int bit)
 {
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-
     if (bit < 0)
-    {
-        for (int i = 0; i < bits; i++)
-            data[i].stopNotification(mod);
-    }
+        planes_->stopNotification(mod, offset_, bits);
     else if (bit < bits)
-    {
-        data[bit].stopNotification(mod);
-    }
+        planes_->stopNotification(mod, offset_ + bit, 1);
 }
 
 template <int bits>
 unsigned long BitBuff<bits>::toInt(void) const
 {
-    unsigned long val = 0;
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-
-
-    for (int i = 0; i < bits; i++)
-    {
-        unsigned long bitVal = 0;
-        if (data[i].state() == HIGH)
-            bitVal = 1;
-        else if (data[i].state() == UNKNOWN || data[i].state() == HIGH_IMPEDENCE)
-        {
-            val = 0;
-            break;
-        }
+    const WordState<bits> value = word();
+    if (!value.isKnown())
+        return 0;
 
-        bitVal <<= i;
-        val += bitVal;
-    }
+    // The bits which do not fit in an unsigned long are dropped.
+    unsigned long val = 0;
+    for (int k = 0; k < WordState<bits>::LIMBS && k*32 < static_cast<int>(sizeof(unsigned long))*8; k++)
+        val |= static_cast<unsigned long>(value.limb(k)) << (k*32);
 
     return val;
 }
@@ -218,12 +240,11 @@ unsigned long BitBuff<bits>::toInt(void) const
 template <int bits>
 std::string BitBuff<bits>::toStr(void) const
 {
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
     std::stringstream ss;
 
     for (int i = 0; i < bits; i++)
     {
-        LineState state = data[i].state();
+        LineState state = get(i);
         char bitVal = '0';
 
         if (state == HIGH)
@@ -240,37 +261,62 @@ std::string BitBuff<bits>::toStr(void) const
 }
 
 template <int bits>
-template <int rbits>
-BitBuff<bits>& BitBuff<bits>::operator=(const BitBuff<rbits> &rhs)
+const WordState<bits> BitBuff<bits>::word(void) const
+{
+    unsigned int value[WordState<bits>::LIMBS], unknown[WordState<bits>::LIMBS];
+    planes_->read(offset_, bits, value, unknown);
+
+    WordState<bits> result;
+    for (int k = 0; k < WordState<bits>::LIMBS; k++)
+        result.setLimb(k, value[k], unknown[k]);
+
+    return result;
+}
+
+template <int bits>
+template <int w>
+void BitBuff<bits>::assign(const WordState<w> &value)
 {
-    Bit *data     = Array1D<Bit, bits>::dataPtr->data;
-    Bit *rhs_data = rhs.dataPtr->data;
-    if (rbits > bits)
+    const WordState<bits> word(value);
+
+    unsigned int val[WordState<bits>::LIMBS], unknown[WordState<bits>::LIMBS];
+    for (int k = 0; k < WordState<bits>::LIMBS; k++)
     {
-        for (unsigned int i = 0; i < bits; i++)
-            data[i] = rhs_data[i];
+        val[k] = word.limb(k);
+        unknown[k] = word.unknownLimb(k);
     }
-    else
-        for (unsigned int i = 0; i < rbits; i++)
-            data[i] = rhs_data[i];
+
+    planes_->write(offset_, (w < bits) ? w : bits, val, unknown);
+}
+
+template <int bits>
+BitBuff<bits>& BitBuff<bits>::operator=(const BitBuff<bits> &rhs)
+{
+    if (planes_ == rhs.planes_ && offset_ == rhs.offset_)
+        return *this;
+
+    rhs.planes_->acquire();
+    planes_->release();
+
+    planes_ = rhs.planes_;
+    offset_ = rhs.offset_;
 
     return *this;
 }
 
 template <int bits>
 template <int rbits>
-BitBuff<bits>& BitBuff<bits>::operator=(const InputBus<rbits> &rhs)
+BitBuff<bits>& BitBuff<bits>::operator=(const BitBuff<rbits> &rhs)
 {
-    Bit *data     = Array1D<Bit, bits>::dataPtr->data;
-    if (rbits > bits)
-    {
-        for (unsigned int i = 0; i < bits; i++)
-            data[i] = rhs[i];
-    }
-    else
-        for (unsigned int i = 0; i < rbits; i++)
-            data[i] = rhs[i];
+    assign(rhs.word());
+    return *this;
+}
 
+template <int bits>
+template <int rbits>
+BitBuff<bits>& BitBuff<bits>::operator=(const InputBus<rbits> &rhs)
+{
+    assign(Expression<rbits, BUS_EXPR, void, void>(rhs).word());
     return *this;
 }
 
@@ -279,16 +325,7 @@ template <int w, ExprType Type, typename LExprType, typename RExprType>
 BitBuff<bits>& BitBuff<bits>::operator=(const Expression<w, Type,
                                                            LExprType, RExprType> &expr)
 {
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-    if (static_cast<unsigned int>(w) > bits)
-    {
-        for (unsigned int i = 0; i < bits; i++)
-            data[i] = expr[i];
-    }
-    else
-        for (int i = 0; i < w; i++)
-            data[i] = expr[i];
-
+    assign(expr.word());
     return *this;
 }
 
@@ -299,14 +336,7 @@ const Expression<1, BITBUFF_EXPR, void, void> BitBuff<bits>::operator[](int inde
     if (index < 0 || index >= static_cast<int>(bits))
         throw OutOfRangeException<int>(0, bits-1, index);
 
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-    Bit b = data[index];
-
-    BitBuff<1> buff;
-    Bit *buffData = buff.dataPtr->data;
-    buffData[0] = b;
-
-    return Expression<1, BITBUFF_EXPR, void, void>(buff);
+    return Expression<1, BITBUFF_EXPR, void, void>(BitBuff<1>(planes_, offset_ + index));
 }
 
 template <int bits>
@@ -316,14 +346,7 @@ Expression<1, BITBUFF_EXPR, void, void> BitBuff<bits>::operator[](int index)
     if (index < 0 || index >= static_cast<int>(bits))
         throw OutOfRangeException<int>(0, bits-1, index);
 
-    Bit *data = Array1D<Bit, bits>::dataPtr->data;
-    Bit b = data[index];
-
-    BitBuff<1> buff;
-    Bit *buffData = buff.dataPtr->data;
-    buffData[0] = b;
-
-    return Expression<1, BITBUFF_EXPR, void, void>(buff);
+    return Expression<1, BITBUFF_EXPR, void, void>(BitBuff<1>(planes_, offset_ + index));
 }
 
 } // End of namespace lcs.
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_BIT_CHANGE_H__
+#define __LCS_BIT_CHANGE_H__
+
+#include "linestate.h"
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A structure which describes a state change of a single line of a bus connected to a
+/// module port. A module registered with a bus through \p lcs::InputBus::notifyBits is
+/// passed the changes of the lines of the bus through \p lcs::Module::onBitsChange, so that
+/// it can update only the part of its state which depends on the lines which changed.
+struct BitChange
+{
+    /// The id of the module port to which the bus is connected.
+    ///
+    int portId;
+
+    /// The index of the line in the bus.
+    ///
+    int bit;
+
+    /// The state of the line before the change. The state after the change is the current
+    /// state of the line.
+    LineState previous;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_BIT_CHANGE_H__
@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_BIT_DEP_MAP_H__
+#define __LCS_BIT_DEP_MAP_H__
+
+#include <map>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+class Line;
+class Module;
+
+/// A class which records, for a module driven by an expression, the output bits which
+/// depend on each of the distinct lines (nets) used in the expression. Every distinct
+/// net is registered with the module exactly once, with a port id which is one more
+/// than the index of the net in the map. The port id 0 is reserved to denote a change
+/// which requires all the output bits to be recomputed. A user of libLCS will, under
+/// normal circumstances, never need to use this class directly.
+///
+/// A map can be dynamic. The conditional expressions add only the nets of their selected
+/// branches to a dynamic map, and add the nets of their conditions as control nets. When a
+/// control net changes, the module rebuilds the map between calls to \p beginUpdate and
+/// \p endUpdate. The nets which are no longer added are de-registered, but retain their
+/// port ids so that they can be registered again with the same ids later.
+class BitDependencyMap
+{
+public:
+
+    /// The only useful constructor.
+    ///
+    /// \param mod The module which should be notified of the state changes on the nets
+    /// added to the map.
+    /// \param dynamic Pass \p true to create a dynamic map.
+    BitDependencyMap(Module *mod, bool dynamic = false);
+
+    /// Destructor. De-registers the module from all the nets in the map.
+    ///
+    ~BitDependencyMap();
+
+    /// Records that the output bit \p outBit depends on the net of the line \p line. If
+    /// the net is being added for the first time, the module is registered to be notified
+    /// of its state changes.
+    ///
+    /// \param line The line whose net is a dependency.
+    /// \param outBit The index of the output bit which depends on the net.
+    void add(const Line &line, int outBit);
+
+    /// Returns \p true if the map is dynamic.
+    ///
+    bool isDynamic(void) const { return dynamic_; }
+
+    /// Sets whether the nets added hereafter are control nets. Returns the previous setting,
+    /// so that the setting can be restored after the nets of a condition have been added.
+    bool setControl(bool control);
+
+    /// Returns \p true if the net registered with the port id \p portId is a control net.
+    ///
+    bool isControl(int portId) const;
+
+    /// Starts rebuilding the map. All the nets are marked unused, and their lists of
+    /// dependent output bits are cleared.
+    void beginUpdate(void);
+
+    /// Finishes rebuilding the map. The nets which have not been added since the call to
+    /// \p beginUpdate are de-registered.
+    void endUpdate(void);
+
+    /// Returns the module associated with the map.
+    ///
+    Module* getModule(void) const { return mod_; }
+
+    /// Returns the number of distinct nets in the map.
+    ///
+    int size(void) const { return static_cast<int>(nets_.size()); }
+
+    /// Returns the number of output bits which depend on the net registered with the
+    /// port id \p portId.
+    int bitCount(int portId) const;
+
+    /// Returns the \p k-th output bit which depends on the net registered with the port
+    /// id \p portId.
+    int bit(int portId, int k) const { return bits_[portId-1][k]; }
+
+    /// Returns the list of the output bits which depend on the net registered with the
+    /// port id \p portId.
+    const std::vector<int>& bits(int portId) const { return bits_[portId-1]; }
+
+private:
+
+    /// Copying a dependency map is not allowed.
+    ///
+    BitDependencyMap(const BitDependencyMap &map);
+
+    Module *mod_;
+    bool dynamic_, control_;
+    std::map<const void*, int> index_;
+    std::vector<bool> active_, used_, isControl_;
+    std::vector<Line*> nets_;
+    std::vector< std::vector<int> > bits_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_BIT_DEP_MAP_H__
@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_BIT_PLANES_H__
+#define __LCS_BIT_PLANES_H__
+
+#include "linestate.h"
+#include "module.h"
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class which holds the states of the bits of an \p lcs::BitBuff object, packed in two
+/// bit planes as in \p lcs::WordState. The planes are shared by all the copies of a bit
+/// buffer, and by the part-selects and bit-selects taken from it, and are reference
+/// counted. A single list of the modules to be notified of the bit state changes is kept
+/// for all of them, each module with the range of bits it is interested in. A write
+/// compares the new states with the old ones first, and notifies a module only if a bit
+/// of its range has changed, and then only once. A user of libLCS will, under normal
+/// circumstances, never need to use this class directly.
+class BitPlanes
+{
+public:
+
+    /// Constructor. All the \p width bits are initialised to \p lcs::UNKNOWN. The reference
+    /// count starts at one.
+    BitPlanes(int width);
+
+    /// Increments the reference count.
+    ///
+    void acquire(void) { refCount_++; }
+
+    /// Decrements the reference count, and deletes the planes when it drops to zero.
+    ///
+    void release(void);
+
+    /// Returns the state of the bit at the index \p index.
+    ///
+    const LineState get(int index) const;
+
+    /// Reads the \p count bits starting at the index \p offset into the planes \p value and
+    /// \p unknown, starting at their bit 0. The bits of the last limbs beyond \p count are
+    /// cleared.
+    void read(int offset, int count, unsigned int *value, unsigned int *unknown) const;
+
+    /// Writes the \p count bits starting at the index \p offset from the planes \p value
+    /// and \p unknown, starting at their bit 0, and notifies the modules interested in the
+    /// bits which changed.
+    void write(int offset, int count, const unsigned int *value, const unsigned int *unknown);
+
+    /// Registers the module \p mod to be notified, through \p lcs::Module::onStateChange
+    /// with the port id 0, of the state changes of the \p count bits starting at the index
+    /// \p first. A module registered for the same range more than once is notified once.
+    void notify(Module *mod, int first, int count);
+
+    /// De-registers the module \p mod registered for the same range through
+    /// \p lcs::BitPlanes::notify.
+    void stopNotification(Module *mod, int first, int count);
+
+private:
+
+    /// Copying the planes is not allowed.
+    ///
+    BitPlanes(const BitPlanes &planes);
+
+    /// Assigning the planes is not allowed.
+    ///
+    BitPlanes& operator=(const BitPlanes &planes);
+
+    /// Returns the \p count (at most 32) bits of \p plane starting at the index \p pos.
+    ///
+    static unsigned int extract(const std::vector<unsigned int> &plane, int pos, int count);
+
+    /// Replaces the \p count (at most 32) bits of \p plane starting at the index \p pos by
+    /// the low bits of \p bits.
+    static void deposit(std::vector<unsigned int> &plane, int pos, int count, unsigned int bits);
+
+    struct Subscriber
+    {
+        Module *mod;
+        int first, count;
+    };
+
+    std::vector<unsigned int> value_, unknown_;
+    std::vector<Subscriber> subscribers_;
+    int width_, refCount_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_BIT_PLANES_H__
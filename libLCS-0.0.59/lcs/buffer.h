@@ -25,7 +25,7 @@
 #ifndef __LCS_BUFFER_H__
 #define __LCS_BUFFER_H__
 
-#include "module.h"
+#include "dyngate.h"
 #include "bus.h"
 
 namespace lcs
@@ -38,52 +38,32 @@ namespace lcs
 /// This module can also be used as a delay element by specifying the desired amount of
 /// propogation delay.
 template <unsigned int lines = 1, unsigned int delay = 0>
-class Buffer : public Module
+class Buffer : public DynGate
 {
 public:
 
     /// The only usefull constructor. The default constructor, if generated by the compiler, is of no
-    /// practical use.
-    Buffer(const Bus<lines> &output, const InputBus<lines> &input);
+    /// practical use. See \p lcs::GateEvaluation for the manners of \p evaluation.
+    Buffer(const Bus<lines> &output, const InputBus<lines> &input,
+           GateEvaluation evaluation = AUTOMATIC_GATE_EVALUATION);
 
-    /// Destructor.
-    ///
-    ~Buffer();
-
-    /// This is the workhorse function of the module class. A user of libLCS will, under normal
-    /// circumstances, never need to call this function explicitly.
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output is driven with the delay of the gate; see \p lcs::DynGate::onStateChange.
     virtual void onStateChange(int portId);
-
-private:
-    Bus<lines> output_;
-    InputBus<lines> input_;
 };
 
 template <unsigned int lines, unsigned int delay>
-Buffer<lines, delay>::Buffer(const Bus<lines> &output, const InputBus<lines> &input)
-             : Module(), output_(output), input_(input)
-{
-    input_.notify(this, LINE_STATE_CHANGE, 0);
-
-    for (unsigned int i = 0; i < lines; i++)
-    {
-        output_[i] = input_[i];
-    }
-}
-
-template <unsigned int lines, unsigned int delay>
-Buffer<lines, delay>::~Buffer()
+Buffer<lines, delay>::Buffer(const Bus<lines> &output, const InputBus<lines> &input,
+                             GateEvaluation evaluation)
+    : DynGate(BUFFER_GATE, output, input, delay, evaluation)
 {
-    input_.stopNotification(this, LINE_STATE_CHANGE, 0);
+    setBatchEvaluator(&DynGate::evaluateBatch<delay>);
 }
 
 template <unsigned int lines, unsigned int delay>
 void Buffer<lines, delay>::onStateChange(int portId)
 {
-    for (unsigned int i = 0; i < lines; i++)
-    {
-        output_[i] = (delay, input_[i]);
-    }
+    evaluate<delay>(portId);
 }
 
 } // End of namespace lcs
@@ -29,7 +29,11 @@
 #include "expression.h"
 #include "contassmod.h"
 #include "hiddenmodman.h"
+#include "exprgraph.h"
 #include "delbuspair.h"
+#include "writegroup.h"
+#include <new>
+#include <vector>
 
 namespace lcs
 { // Start of namespace lcs.
@@ -88,6 +92,12 @@ public:
     /// \param line The line object which is encapsulated in the resultant bus object.
     Bus(const Line &line) throw(OutOfRangeException<int>);
 
+    /// Creates a bus which shares the lines of the view \p view. A view can hence be
+    /// passed wherever a \p Bus is expected.
+    ///
+    /// \param view The view whose lines are used to create the new \p Bus object.
+    Bus(const BusView<bits> &view);
+
     /// Destructor.
     ///
     virtual ~Bus();
@@ -105,10 +115,13 @@ public:
     /// All template parameters except the parameter \p delay are deduced from the
     /// expression passed as an argument to the function. Hence, a call to this function
     /// will have to explicitly specify a single parameter which indicates the assignment
-    /// delay.
+    /// delay. If \p sensitivity is \p lcs::DYNAMIC_SENSITIVITY, the assignment ignores
+    /// the changes on the nets which are used only in the unselected branches of the
+    /// conditional and mux expressions (see \p lcs::select and \p lcs::mux).
     template <unsigned int delay, int exBits, ExprType Type,
               typename LExprType, typename RExprType>
-    void cass(const Expression<exBits, Type, LExprType, RExprType> &expr);
+    void cass(const Expression<exBits, Type, LExprType, RExprType> &expr,
+              Sensitivity sensitivity = STATIC_SENSITIVITY);
 
     /// A template function to assign a continuous assignment to the bus from an
     /// \p lcs::InputBus object. The template parameter \p width is deduced from the width
@@ -118,8 +131,9 @@ public:
     template <unsigned int delay, int width>
     void cass(const InputBus<width> &b);
 
-    /// Assigns the binary bit equivalent of an integer to the bus lines.
-    ///
+    /// Assigns the binary bit equivalent of an integer to the bus lines. As with every other
+    /// assignment to a bus, all the lines take their new states before any module driven by
+    /// the bus is notified of the change; see \p lcs::WriteGroup.
     void operator=(int a);
 
     /// Assigns a desired linestate to all the lines of the bus.
@@ -180,6 +194,22 @@ public:
     /// parentheses enclosing the delay-state pair.
     void operator=(const DelayStatePair &dsp);
 
+    /// Assigns the state \p state to the line at the index \p index with the delay
+    /// \p delay. The statement <tt>bus.set<5>(0, lcs::HIGH);</tt> has the same effect as
+    /// <tt>bus[0] = (5, lcs::HIGH);</tt>, but as the delay is a template parameter, the
+    /// choice between a zero delay assignment and a scheduled one is made at compile time,
+    /// and no \p lcs::DelayStatePair or part-bus is made. This suits the modules whose
+    /// delays are template parameters. An \p OutOfRangeException is thrown if the index
+    /// value \p index is beyond the bus width.
+    template <unsigned int delay>
+    void set(unsigned int index, const LineState &state) throw(OutOfRangeException<unsigned int>);
+
+    /// Assigns the states of the lines of the bus \p bus to the lines of this bus with
+    /// the delay \p delay. This is the same as <tt>(delay, bus)</tt> assigned to this bus,
+    /// with the delay resolved at compile time as with \p lcs::Bus::set.
+    template <unsigned int delay>
+    void assign(const InputBus<bits> &bus);
+
     /// Overloaded operator which returns a suitable expression object corresponding
     /// to the line at index \p i. This is done so that bit-selects can be used in expressions of
     /// bitwise operations. An \p OutOfRangeException is thrown if the index value \p i is beyond
@@ -229,6 +259,13 @@ private:
                           const int &line = -1) throw(OutOfRangeException<int>)
     {}
 
+    /// Adds the continuous assignment of the expression \p expr to the shared
+    /// \p lcs::ExpressionGraph. Returns \p false if a bit of the expression cannot be
+    /// represented in the graph, in which case the nodes added for the other bits are
+    /// removed and the graph is left as it was.
+    template <typename ExprT>
+    bool graphAssign(ExprT &expr, unsigned int delay);
+
 };
 
 template <int bits>
@@ -270,23 +307,61 @@ Bus<bits>::Bus(const Bus<bits> &bus)
    : InputBus<bits>(bus)
 {}
 
+template <int bits>
+Bus<bits>::Bus(const BusView<bits> &view)
+   : InputBus<bits>(view)
+{}
+
 template <int bits>
 Bus<bits>::~Bus()
 {}
 
+template <int bits>
+template <typename ExprT>
+bool Bus<bits>::graphAssign(ExprT &expr, unsigned int delay)
+{
+    int n = (expr.width() < bits) ? expr.width() : bits;
+    int mark = ExpressionGraph::size();
+    std::vector<int> nodes(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        nodes[i] = expr.graphNode(i);
+        if (nodes[i] < 0)
+        {
+            ExpressionGraph::truncate(mark);
+            return false;
+        }
+    }
+
+    Line *data = InputBus<bits>::dataPtr->data;
+    for (int i = 0; i < n; i++)
+        ExpressionGraph::drive(nodes[i], data[i], delay);
+
+    return true;
+}
+
 template <int bits>
 template <unsigned int delay, int exBits, ExprType Type,
           typename LExprType, typename RExprType>
-void Bus<bits>::cass(const Expression<exBits, Type, LExprType, RExprType> &expr)
+void Bus<bits>::cass(const Expression<exBits, Type, LExprType, RExprType> &expr,
+                     Sensitivity sensitivity)
 {
-    ContinuousAssignmentModule<
-                                bits, Expression<exBits, Type, LExprType, RExprType>, delay
-                              > *mod
-    = new ContinuousAssignmentModule<
+    if (ExpressionGraph::isEnabled())
+    {
+        Expression<exBits, Type, LExprType, RExprType> e(expr);
+        if (graphAssign(e, delay))
+            return;
+    }
+
+    typedef ContinuousAssignmentModule<
                                 bits, Expression<exBits, Type, LExprType, RExprType>, delay
-                                    >(*this, expr);
+                                      > CassModule;
+
+    CassModule *mod = new (HiddenModuleManager::allocate(sizeof(CassModule)))
+                          CassModule(*this, expr, sensitivity);
 
-    HiddenModuleManager::registerModule(mod);
+    HiddenModuleManager::registerModule(mod, true);
 }
 
 template <int bits>
@@ -295,20 +370,24 @@ void Bus<bits>::cass(const InputBus<width> &b)
 {
     Expression<width, BUS_EXPR, void, void> expr(b);
 
-    ContinuousAssignmentModule<
-                                bits, Expression<width, BUS_EXPR, void, void>, delay
-                              > *mod
-    = new ContinuousAssignmentModule<
+    if (ExpressionGraph::isEnabled() && graphAssign(expr, delay))
+        return;
+
+    typedef ContinuousAssignmentModule<
                                 bits, Expression<width, BUS_EXPR, void, void>, delay
-                                    >(*this, expr);
+                                      > CassModule;
+
+    CassModule *mod = new (HiddenModuleManager::allocate(sizeof(CassModule)))
+                          CassModule(*this, expr);
 
-    HiddenModuleManager::registerModule(mod);
+    HiddenModuleManager::registerModule(mod, true);
 
 }
 
 template <int bits>
 void Bus<bits>::operator=(int value)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
 
     for (int i = 0; i < bits; i++)
@@ -327,6 +406,7 @@ void Bus<bits>::operator=(int value)
 template <int bits>
 void Bus<bits>::operator=(const LineState &l)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
 
     for (int i = 0; i < bits; i++)
@@ -339,6 +419,7 @@ template <int bits>
 template <int w>
 void Bus<bits>::operator=(const InputBus<w> &bus)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
     if (w > bits)
     {
@@ -354,6 +435,7 @@ template <int bits>
 template <int w>
 void Bus<bits>::operator=(const Bus<w> &bus)
 {
+    WriteGroup group;
     Line *data = Bus<bits>::dataPtr->data;
     if (w > bits)
     {
@@ -368,6 +450,7 @@ void Bus<bits>::operator=(const Bus<w> &bus)
 template <int bits>
 void Bus<bits>::operator=(const Bus<bits> &bus)
 {
+    WriteGroup group;
     Line *data = Bus<bits>::dataPtr->data;
     for (unsigned int i = 0; i < bits; i++)
             data[i] = bus.get(i);
@@ -377,21 +460,25 @@ template <int bits>
 template <int w, ExprType Type, typename LExprType, typename RExprType>
 void Bus<bits>::operator=(const Expression<w, Type, LExprType, RExprType> &expr)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
+    const WordState<w> value = expr.word();
+
     if (w > bits)
     {
         for (unsigned int i = 0; i < bits; i++)
-            data[i] = expr[i];
+            data[i] = value.get(i);
     }
     else
         for (int i = 0; i < w; i++)
-            data[i] = expr[i];
+            data[i] = value.get(i);
 }
 
 template <int bits>
 template <int w>
 void Bus<bits>::operator=(const DelayBusPair<w> &dbp)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
     InputBus<w> bus(dbp.getBus());
     unsigned int delay = dbp.getDelay();
@@ -399,55 +486,66 @@ void Bus<bits>::operator=(const DelayBusPair<w> &dbp)
     if (w > bits)
     {
         for (unsigned int i = 0; i < bits; i++)
-        {
-            data[i].setAssDelay(delay);
-            data[i] = bus.get(i);
-        }
+            data[i].assign(bus.get(i), delay);
     }
     else
         for (int i = 0; i < w; i++)
-        {
-            data[i].setAssDelay(delay);
-            data[i] = bus.get(i);
-        }
+            data[i].assign(bus.get(i), delay);
 }
 
 template <int bits>
 template <int w, ExprType Type, typename LExprType, typename RExprType>
 void Bus<bits>::operator=(const DelayExprPair<w, Type, LExprType, RExprType> &dep)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
     Expression<w, Type, LExprType, RExprType> expr = dep.getExpr();
+    const WordState<w> value = expr.word();
     unsigned int delay = dep.getDelay();
 
     if (w > bits)
     {
         for (unsigned int i = 0; i < bits; i++)
-        {
-            data[i].setAssDelay(delay);
-            data[i] = expr[i];
-        }
+            data[i].assign(value.get(i), delay);
     }
     else
         for (int i = 0; i < w; i++)
-        {
-            data[i].setAssDelay(delay);
-            data[i] = expr[i];
-        }
+            data[i].assign(value.get(i), delay);
 }
 
 template <int bits>
 void Bus<bits>::operator=(const DelayStatePair &dsp)
 {
+    WriteGroup group;
     Line *data = InputBus<bits>::dataPtr->data;
     LineState state = dsp.getState();
     unsigned int delay = dsp.getDelay();
 
     for (unsigned int i = 0; i < bits; i++)
-    {
-        data[i].setAssDelay(delay);
-        data[i] = state;
-    }
+        data[i].assign(state, delay);
+}
+
+template <int bits>
+template <unsigned int delay>
+void Bus<bits>::set(unsigned int index, const LineState &state)
+                    throw(OutOfRangeException<unsigned int>)
+{
+    if (index >= bits)
+        throw OutOfRangeException<unsigned int>(0, static_cast<unsigned int>(bits-1), index);
+
+    WriteGroup group;
+    InputBus<bits>::dataPtr->data[index].assign(state, delay);
+}
+
+template <int bits>
+template <unsigned int delay>
+void Bus<bits>::assign(const InputBus<bits> &bus)
+{
+    WriteGroup group;
+    Line *data = InputBus<bits>::dataPtr->data;
+
+    for (int i = 0; i < bits; i++)
+        data[i].assign(bus.get(i), delay);
 }
 
 template <int bits>
@@ -0,0 +1,214 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_BUS_VIEW_H__
+#define __LCS_BUS_VIEW_H__
+
+#include "line.h"
+#include "linestate.h"
+#include "outofrange_exception.h"
+#include <sstream>
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs
+
+template <int w>
+class InputBus;
+
+template <int w>
+class Bus;
+
+/// A class whose objects are non-owning views of \p bits lines of one or more busses.
+/// Unlike the busses returned by \p lcs::InputBus::partSelect and the concatenation
+/// operators, a view does not copy the lines: it only holds pointers to the lines of the
+/// busses it was taken from, in an array inside the view object. Hence, taking slices of
+/// busses and concatenating them through views allocates no memory, and does not touch the
+/// reference lists of the lines. A view should not outlive the busses whose lines it refers
+/// to.
+///
+/// A view is obtained using \p lcs::InputBus::view or \p lcs::InputBus::slice, and views are
+/// concatenated using the comma operator. The \p lcs::InputBus and \p lcs::Bus classes
+/// can be constructed from a view of the same width, sharing the lines of the view. Hence,
+/// a view can be passed directly to the constructor of a module which takes busses; the
+/// lines are copied only once, into the bus held by the module. For example, to connect the
+/// lines 4 to 7 of the bus \p a and the lines 0 to 3 of the bus \p b to the 8 bit input of
+/// a module:
+///
+/// \code
+/// MyModule mod(out, (a.slice<4>(4), b.slice<4>(0)));
+/// \endcode
+///
+/// \param bits The number of lines in the view.
+template <int bits = 1>
+class BusView
+{
+
+template <int w>
+friend class BusView;
+
+template <int w>
+friend class InputBus;
+
+template <int w>
+friend class Bus;
+
+public:
+
+    /// Returns the number of lines in the view.
+    ///
+    int width(void) const { return bits; }
+
+    /// Returns the line state of the line at index \p index. An
+    /// \p lcs::OutOfRangeException is thrown if the index is not within the view width.
+    const LineState get(int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the view of the line at index \p index. An \p lcs::OutOfRangeException is
+    /// thrown if the index is not within the view width.
+    const BusView<1> operator[](int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the view of the \p w lines starting at index \p s. An
+    /// \p lcs::OutOfRangeException is thrown if the lines are not all within the view.
+    template <int w>
+    const BusView<w> slice(int s) const throw (OutOfRangeException<int>);
+
+    /// Joins the lines of this view and the view \p view into a new view. The lines of
+    /// \p view take the MSB locations of the new view.
+    template <int w>
+    const BusView<bits+w> operator,(const BusView<w> &view) const;
+
+    /// Converts the binary value on the lines to a decimal integer. Returns 0 if any of
+    /// the lines is not \p lcs::LOW or \p lcs::HIGH.
+    unsigned long toInt(void) const;
+
+    /// Converts the line states to a string representation.
+    ///
+    std::string toStr(void) const;
+
+private:
+
+    /// Constructs a view whose lines are to be filled in.
+    ///
+    BusView(void) {}
+
+    /// Pointers to the lines of the view.
+    ///
+    const Line *lines_[bits];
+};
+
+template <int bits>
+const LineState BusView<bits>::get(int index) const throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= bits)
+        throw OutOfRangeException<int>(0, bits-1, index);
+
+    return lines_[index]->operator()();
+}
+
+template <int bits>
+const BusView<1> BusView<bits>::operator[](int index) const throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= bits)
+        throw OutOfRangeException<int>(0, bits-1, index);
+
+    BusView<1> view;
+    view.lines_[0] = lines_[index];
+
+    return view;
+}
+
+template <int bits>
+template <int w>
+const BusView<w> BusView<bits>::slice(int s) const throw (OutOfRangeException<int>)
+{
+    if (s < 0 || s + w > bits)
+        throw OutOfRangeException<int>(0, bits-w, s);
+
+    BusView<w> view;
+    for (int i = 0; i < w; i++)
+        view.lines_[i] = lines_[s+i];
+
+    return view;
+}
+
+template <int bits>
+template <int w>
+const BusView<bits+w> BusView<bits>::operator,(const BusView<w> &view) const
+{
+    BusView<bits+w> joined;
+
+    for (int i = 0; i < bits; i++)
+        joined.lines_[i] = lines_[i];
+
+    for (int i = 0; i < w; i++)
+        joined.lines_[bits+i] = view.lines_[i];
+
+    return joined;
+}
+
+template <int bits>
+unsigned long BusView<bits>::toInt(void) const
+{
+    unsigned long val = 0;
+
+    for (int i = 0; i < bits; i++)
+    {
+        LineState state = lines_[i]->operator()();
+
+        if (state == UNKNOWN || state == HIGH_IMPEDENCE)
+            return 0;
+
+        if (state == HIGH)
+            val += 1ul << i;
+    }
+
+    return val;
+}
+
+template <int bits>
+std::string BusView<bits>::toStr(void) const
+{
+    std::stringstream ss;
+
+    for (int i = 0; i < bits; i++)
+    {
+        LineState state = lines_[i]->operator()();
+        char bitVal = '0';
+
+        if (state == HIGH)
+            bitVal = '1';
+        else if (state == HIGH_IMPEDENCE)
+            bitVal = 'z';
+        else if (state == UNKNOWN)
+            bitVal = 'x';
+
+        ss << bitVal;
+    }
+
+    return ss.str();
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_BUS_VIEW_H__
@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_CELL_TYPE_H__
+#define __LCS_CELL_TYPE_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the primitive cell types which can be used in the netlists built
+/// using \p lcs::Circuit. As with the gate modules like \p lcs::And, the logic gate cells
+/// treat \p lcs::UNKNOWN and \p lcs::HIGH_IMPEDENCE inputs as \p lcs::LOW, and hence always
+/// drive \p lcs::LOW or \p lcs::HIGH.
+enum CellType
+{
+
+    /// A buffer. The output follows the only input, including the \p lcs::UNKNOWN and
+    /// \p lcs::HIGH_IMPEDENCE states.
+    BUFFER_CELL  = 6144,
+
+    /// An inverter with a single input.
+    ///
+    NOT_CELL     = 6145,
+
+    /// An AND gate with one or more inputs.
+    ///
+    AND_CELL     = 6146,
+
+    /// An OR gate with one or more inputs.
+    ///
+    OR_CELL      = 6147,
+
+    /// A parity gate with one or more inputs, as the \p xor primitive of Verilog. The
+    /// output is \p lcs::HIGH if an odd number of inputs are \p lcs::HIGH. Note that this
+    /// differs from \p lcs::Xor, whose output is \p lcs::HIGH only if exactly one input is
+    /// \p lcs::HIGH; the two agree for two inputs.
+    PARITY_CELL  = 6148,
+
+    /// A NAND gate with one or more inputs.
+    ///
+    NAND_CELL    = 6149,
+
+    /// A NOR gate with one or more inputs.
+    ///
+    NOR_CELL     = 6150,
+
+    /// The complement of \p lcs::PARITY_CELL, as the \p xnor primitive of Verilog. The
+    /// output is \p lcs::HIGH if an even number of inputs are \p lcs::HIGH.
+    NPARITY_CELL = 6151,
+
+    /// A positive edge triggered D flipflop. The inputs are, in order, the D input, the
+    /// clock input and, optionally, the reset input. As with \p lcs::DFlipFlop, the output
+    /// is \p lcs::LOW while the reset input is \p lcs::HIGH.
+    DFF_CELL     = 6152,
+
+    /// A negetive edge triggered D flipflop. The inputs are the same as those of
+    /// \p lcs::DFF_CELL.
+    DFF_NEG_CELL = 6153
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_CELL_TYPE_H__
@@ -80,6 +80,7 @@ ChangeMonitor<width>::ChangeMonitor(const InputBus<width> &b, const std::string
 {
     SystemTimer::notifyTick(this);
     old_value = bus.toStr();
+    bus.setName(name);
 
     if (dump == DUMP_ON)
         VCDManager::registerChangeReporter(name, bus);
@@ -0,0 +1,262 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_CIRCUIT_H__
+#define __LCS_CIRCUIT_H__
+
+#include "celltype.h"
+#include "linestate.h"
+#include "netlist_exception.h"
+#include "portdir.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects are definitions of circuits built as netlists of primitive
+/// cells (see \p lcs::CellType) and instances of other circuits. Unlike the circuits
+/// built by wiring \p lcs::Bus objects to modules, a circuit defined using this class is
+/// only a description: it can be instantiated any number of times in other circuits, and
+/// is simulated only after it is flattened into an \p lcs::FlatNetlist.
+///
+/// The nets of a circuit are single bit nets identified by integer ids local to the
+/// circuit. Functions which create multi-bit nets or ports return the id of the net of
+/// bit 0; the ids of the other bits follow consecutively. An example of a definition of a
+/// half adder, and of a circuit which uses two of them, is as follows:
+///
+/// <pre>
+/// lcs::Circuit ha("ha");
+/// int a = ha.addInput("a"), b = ha.addInput("b");
+/// int s = ha.addOutput("s"), c = ha.addOutput("c");
+/// ha.addCell(lcs::PARITY_CELL, a, b, s);
+/// ha.addCell(lcs::AND_CELL, a, b, c);
+///
+/// lcs::Circuit top("top");
+/// int in = top.addInput("in", 3), out = top.addOutput("out", 2), c1 = top.addNet("c1");
+/// int u0 = top.addInstance("u0", ha), u1 = top.addInstance("u1", ha);
+/// ...
+/// top.connect(u0, "a", in);
+/// </pre>
+///
+/// A definition should live at least as long as the definitions which instantiate it.
+class Circuit
+{
+
+/// \p lcs::FlatNetlist is a friend of this class so that it can read the definition
+/// while flattening it.
+friend class FlatNetlist;
+
+public:
+
+    /// Constructor.
+    ///
+    /// \param name The name of the circuit.
+    Circuit(const std::string &name);
+
+    /// Destructor.
+    ///
+    ~Circuit();
+
+    /// Returns the name of the circuit.
+    ///
+    const std::string& getName(void) const { return name_; }
+
+    /// Adds an input port, and the nets which connect to it inside the circuit. Returns the
+    /// id of the net of bit 0 of the port. A \p lcs::NetlistException is thrown if the name
+    /// is already in use in the circuit.
+    ///
+    /// \param name The name of the port.
+    /// \param width The number of bits of the port.
+    int addInput(const std::string &name, int width = 1) throw (NetlistException);
+
+    /// Adds an output port, and the nets which connect to it inside the circuit. Returns
+    /// the id of the net of bit 0 of the port. A \p lcs::NetlistException is thrown if the
+    /// name is already in use in the circuit.
+    ///
+    /// \param name The name of the port.
+    /// \param width The number of bits of the port.
+    int addOutput(const std::string &name, int width = 1) throw (NetlistException);
+
+    /// Adds named internal nets to the circuit. Returns the id of the net of bit 0. A
+    /// \p lcs::NetlistException is thrown if the name is already in use in the circuit.
+    ///
+    /// \param name The name of the nets.
+    /// \param width The number of nets.
+    int addNet(const std::string &name, int width = 1) throw (NetlistException);
+
+    /// Adds an unnamed internal net to the circuit and returns its id.
+    ///
+    int addNet(void);
+
+    /// Adds a net which holds the constant state \p state and returns its id. The net
+    /// should not be driven by a cell.
+    int addConstant(const LineState &state);
+
+    /// Sets the state of the net \p net at the start of the simulation; for example, the
+    /// state of the output of a flipflop at power on. The nets start at the
+    /// \p lcs::UNKNOWN state by default. A \p lcs::NetlistException is thrown if the net id
+    /// is not valid.
+    void setInitialState(int net, const LineState &state) throw (NetlistException);
+
+    /// Returns the id of the net of bit 0 of the named nets (or port) \p name, or -1 if
+    /// the circuit has no nets of that name.
+    int findNet(const std::string &name) const;
+
+    /// Adds a cell whose inputs are the nets \p inputs and whose output is the net
+    /// \p output, and returns the index of the cell in the circuit. A
+    /// \p lcs::NetlistException is thrown if the type is not a cell type, if a net id is
+    /// not valid, or if the number of inputs does not suit the cell type.
+    ///
+    /// \param type The type of the cell.
+    /// \param inputs The ids of the input nets, in the order of the inputs of the cell.
+    /// \param output The id of the output net.
+    /// \param delay The propogation delay of the cell in system time units.
+    int addCell(const CellType &type, const std::vector<int> &inputs, int output,
+                unsigned int delay = 0) throw (NetlistException);
+
+    /// Adds a single input cell. See the other overload for more information.
+    ///
+    int addCell(const CellType &type, int input, int output, unsigned int delay = 0)
+                throw (NetlistException);
+
+    /// Adds a two input cell. See the other overloads for more information.
+    ///
+    int addCell(const CellType &type, int input1, int input2, int output,
+                unsigned int delay = 0) throw (NetlistException);
+
+    /// Adds an instance of the circuit \p def to this circuit, and returns the index of the
+    /// instance. The ports of the instance should be connected using the
+    /// \p lcs::Circuit::connect functions; the input ports left unconnected are at the
+    /// \p lcs::UNKNOWN state. A \p lcs::NetlistException is thrown if the name is already
+    /// in use in the circuit.
+    ///
+    /// \param name The name of the instance.
+    /// \param def The definition of the instantiated circuit.
+    int addInstance(const std::string &name, const Circuit &def) throw (NetlistException);
+
+    /// Connects the bits of the port \p port of the instance \p instance to the nets with
+    /// ids \p net, \p net+1, and so on. A \p lcs::NetlistException is thrown if the port
+    /// does not exist or is already connected, or if the net ids are not valid.
+    void connect(int instance, const std::string &port, int net) throw (NetlistException);
+
+    /// Connects bit \p i of the port \p port of the instance \p instance to the net with
+    /// id \p nets[i]. The number of nets should be the width of the port.
+    void connect(int instance, const std::string &port, const std::vector<int> &nets)
+                 throw (NetlistException);
+
+    /// Returns the number of nets in the circuit.
+    ///
+    int getNetCount(void) const { return netCount_; }
+
+    /// Returns the number of cells in the circuit, not counting the cells of the
+    /// instantiated circuits.
+    int getCellCount(void) const { return static_cast<int>(cellType_.size()); }
+
+    /// Returns the number of circuit instances in the circuit.
+    ///
+    int getInstanceCount(void) const { return static_cast<int>(instances_.size()); }
+
+    /// Returns the number of ports of the circuit.
+    ///
+    int getPortCount(void) const { return static_cast<int>(ports_.size()); }
+
+    /// Returns the index of the port \p name, or -1 if the circuit has no such port.
+    ///
+    int findPort(const std::string &name) const;
+
+    /// Returns the name of the port at index \p port.
+    ///
+    const std::string& getPortName(int port) const { return ports_[port].name; }
+
+    /// Returns the direction of the port at index \p port.
+    ///
+    PortDirection getPortDirection(int port) const { return ports_[port].dir; }
+
+    /// Returns the id of the net of bit 0 of the port at index \p port.
+    ///
+    int getPortNet(int port) const { return ports_[port].net; }
+
+    /// Returns the width of the port at index \p port.
+    ///
+    int getPortWidth(int port) const { return ports_[port].width; }
+
+private:
+
+    struct Port
+    {
+        std::string name;
+        PortDirection dir;
+        int net, width;
+    };
+
+    struct Instance
+    {
+        std::string name;
+        const Circuit *def;
+
+        // Pairs of a port index and the ids of the nets connected to the bits of the port.
+        std::vector< std::pair<int, std::vector<int> > > connections;
+    };
+
+    /// Copying a definition is not allowed.
+    ///
+    Circuit(const Circuit &circuit);
+
+    /// Assigning a definition is not allowed.
+    ///
+    Circuit& operator=(const Circuit &circuit);
+
+    int addPort(const std::string &name, PortDirection dir, int width) throw (NetlistException);
+
+    void checkNet(int net) const throw (NetlistException);
+
+    /// Returns \p true if \p type is one of the types enumerated by \p lcs::CellType.
+    ///
+    static bool isCellType(int type) { return type >= BUFFER_CELL && type <= DFF_NEG_CELL; }
+
+    /// Returns \p true if \p type is a cell type, and a cell of that type can have
+    /// \p inputs inputs.
+    static bool suitsCell(int type, int inputs);
+
+    void checkName(const std::string &name) const throw (NetlistException);
+
+    std::string name_;
+    int netCount_;
+    std::vector<Port> ports_;
+    std::map< std::string, std::pair<int, int> > netNames_;
+    std::vector< std::pair<int, LineState> > constants_;
+    std::vector<int> cellType_;
+    std::vector<unsigned int> cellDelay_;
+    std::vector<int> cellInputOffset_;
+    std::vector<int> cellInputs_;
+    std::vector<int> cellOutput_;
+    std::vector<Instance> instances_;
+    std::map< std::string, int > instanceNames_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_CIRCUIT_H__
@@ -0,0 +1,85 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_CIRCUIT_LIBRARY_H__
+#define __LCS_CIRCUIT_LIBRARY_H__
+
+#include "circuit.h"
+#include "netlist_exception.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects own a set of \p lcs::Circuit definitions identified by their
+/// names. The netlist readers (see \p lcs::NetlistReader) add the circuits they read to a
+/// library. The definitions live as long as the library.
+class CircuitLibrary
+{
+public:
+
+    /// Default constructor.
+    ///
+    CircuitLibrary(void) {}
+
+    /// Destructor. Destroys all the definitions in the library.
+    ///
+    ~CircuitLibrary();
+
+    /// Adds an empty definition named \p name to the library and returns it. A
+    /// \p lcs::NetlistException is thrown if the library already has a definition of that
+    /// name.
+    Circuit& define(const std::string &name) throw (NetlistException);
+
+    /// Returns the definition named \p name, or \p NULL if the library does not have one.
+    ///
+    Circuit* find(const std::string &name) const;
+
+    /// Returns the number of definitions in the library.
+    ///
+    int getCircuitCount(void) const { return static_cast<int>(circuits_.size()); }
+
+    /// Returns the definition at index \p i. The definitions are indexed in the order in
+    /// which they were added.
+    Circuit& getCircuit(int i) const { return *circuits_[i]; }
+
+private:
+
+    /// Copying a library is not allowed.
+    ///
+    CircuitLibrary(const CircuitLibrary &lib);
+
+    /// Assigning a library is not allowed.
+    ///
+    CircuitLibrary& operator=(const CircuitLibrary &lib);
+
+    std::vector<Circuit*> circuits_;
+    std::map<std::string, int> index_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_CIRCUIT_LIBRARY_H__
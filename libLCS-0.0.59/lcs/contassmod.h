@@ -26,6 +26,11 @@
 #define __CONTINUOUS_ASSIGNMENT_MODULE_H__
 
 #include "module.h"
+#include "bitdepmap.h"
+#include "exprtype.h"
+#include "wordstate.h"
+#include "writegroup.h"
+#include <vector>
 
 namespace lcs
 { // Start of namespace lcs
@@ -45,9 +50,11 @@ class ContinuousAssignmentModule : public Module
 {
 public:
 
-    /// The only explicit and usefull constructor.
-    ///
-    ContinuousAssignmentModule(const Bus<outbits> &out, const InExprType &e);
+    /// The only explicit and usefull constructor. With the sensitivity
+    /// \p lcs::DYNAMIC_SENSITIVITY, the module is registered only with the nets of the
+    /// selected branches of the conditional and mux expressions.
+    ContinuousAssignmentModule(const Bus<outbits> &out, const InExprType &e,
+                               Sensitivity sensitivity = STATIC_SENSITIVITY);
 
     /// Destructor.
     ///
@@ -55,42 +62,120 @@ public:
 
     /// The function which is the work horse of the module. When a line state of a line
     /// which is a part of an input bus to the module changes, that line calls this function
-    /// to notify the module about the lcs::LINE_STATE_CHANGE event.
+    /// to notify the module about the lcs::LINE_STATE_CHANGE event. Every distinct net in
+    /// the expression notifies the module with its own port id, and only the output bits
+    /// which depend on that net are recomputed. A port id of 0 causes all the output bits
+    /// to be recomputed. With dynamic sensitivity, a change on a condition or a select
+    /// (or a port id of 0) first updates the set of nets the module is registered with.
     virtual void onStateChange(int portId);
 
+    /// The batch evaluator of the modules of this type (see
+    /// \p lcs::Module::setBatchEvaluator).
+    static void evaluateBatch(Module *const *mods, const int *portIds, int count);
+
 private:
     InExprType expr;
     Bus<outbits> output;
+    BitDependencyMap deps;
+
+    /// Recomputes the output bit at the index \p i.
+    ///
+    void assign(int i) { output.template set<delay>(i, expr[i]); }
+
+    /// Adds the dependencies of all the output bits to the dependency map.
+    ///
+    void buildCone(void);
+
+    /// Does the work of \p lcs::ContinuousAssignmentModule::onStateChange.
+    ///
+    void evaluate(int portId);
+
+    /// Recomputes the output bits at the indices \p bits[0] to \p bits[count-1] (or all
+    /// the output bits if \p bits is NULL) from a single evaluation of the whole
+    /// expression word.
+    template <int w>
+    void assign(const WordState<w> &value, const std::vector<int> *bits, int count);
 };
 
 template <int outbits, typename InExprType, unsigned int delay>
 ContinuousAssignmentModule<outbits, InExprType, delay>::
-ContinuousAssignmentModule(const Bus<outbits> &out, const InExprType &e)
-    : expr(e), output(out)
+ContinuousAssignmentModule(const Bus<outbits> &out, const InExprType &e,
+                           Sensitivity sensitivity)
+    : expr(e), output(out), deps(this, sensitivity == DYNAMIC_SENSITIVITY)
+{
+    buildCone();
+    setBatchEvaluator(&ContinuousAssignmentModule<outbits, InExprType, delay>::evaluateBatch);
+    evaluate(0);
+}
+
+template <int outbits, typename InExprType, unsigned int delay>
+void ContinuousAssignmentModule<outbits, InExprType, delay>::buildCone(void)
 {
-    expr.notify(this);
-    onStateChange(0);
+    int inbits = expr.width();
+    int n = (inbits < outbits) ? inbits : outbits;
+
+    for (int i = 0; i < n; i++)
+        expr.cone(i, i, deps);
 }
 
 template <int outbits, typename InExprType, unsigned int delay>
 void ContinuousAssignmentModule<outbits, InExprType, delay>::
 onStateChange(int portId)
 {
-    int inbits = expr.width();
+    evaluate(portId);
+}
 
-    if (inbits < outbits)
+template <int outbits, typename InExprType, unsigned int delay>
+void ContinuousAssignmentModule<outbits, InExprType, delay>::
+evaluateBatch(Module *const *mods, const int *portIds, int count)
+{
+    for (int i = 0; i < count; i++)
+        static_cast<ContinuousAssignmentModule<outbits, InExprType, delay>*>(mods[i])
+            ->evaluate(portIds[i]);
+}
+
+template <int outbits, typename InExprType, unsigned int delay>
+void ContinuousAssignmentModule<outbits, InExprType, delay>::
+evaluate(int portId)
+{
+    if (deps.isDynamic() && (portId <= 0 || deps.isControl(portId)))
     {
-        for (int i = 0; i < inbits; i++)
-        {
-            output[i] = (delay, expr[i]);
-        }
+        deps.beginUpdate();
+        buildCone();
+        deps.endUpdate();
+
+        portId = 0;
     }
-    else
+
+    if (portId > 0)
+    {
+        int count = deps.bitCount(portId);
+
+        // A single dependent bit is cheaper to evaluate on its own. For more bits, the
+        // expression is evaluated once as a whole word.
+        if (count == 1)
+            assign(deps.bit(portId, 0));
+        else if (count > 1)
+            assign(expr.word(), &deps.bits(portId), count);
+
+        return;
+    }
+
+    int inbits = expr.width();
+    assign(expr.word(), NULL, (inbits < outbits) ? inbits : outbits);
+}
+
+template <int outbits, typename InExprType, unsigned int delay>
+template <int w>
+void ContinuousAssignmentModule<outbits, InExprType, delay>::
+assign(const WordState<w> &value, const std::vector<int> *bits, int count)
+{
+    WriteGroup group;
+
+    for (int k = 0; k < count; k++)
     {
-        for (int i = 0; i < outbits; i++)
-        {
-            output[i] = (delay, expr[i]);
-        }
+        int i = (bits == NULL) ? k : (*bits)[k];
+        output.template set<delay>(i, value.get(i));
     }
 }
 
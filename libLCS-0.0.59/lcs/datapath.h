@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_DATAPATH_H__
+#define __LCS_DATAPATH_H__
+
+#include "bus.h"
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A parameterized datapath macro which encapsulates a \p width bit adder with a carry
+/// input and a carry output. Like the rest of the datapath macros, an adder expands into
+/// continuous assignments of word level expressions when it is constructed. Hence, the
+/// adder is evaluated a whole word at a time, and not bit by bit as an adder built from
+/// \p lcs::FullAdder modules would be. The template parameter \p delay indicates the
+/// propogation delay from the inputs to the outputs.
+template <int width, unsigned int delay = 0>
+class Adder
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    /// \param sum The \p width bit sum output.
+    /// \param cout The carry output.
+    /// \param a The first operand.
+    /// \param b The second operand.
+    /// \param cin The carry input.
+    ///
+    Adder(const Bus<width> &sum, const Bus<1> &cout, const InputBus<width> &a,
+          const InputBus<width> &b, const InputBus<1> &cin)
+    {
+        Bus<width> s(sum);
+        Bus<width+1> out = (s, cout);
+
+        out.template cass<delay>(a + b + cin);
+    }
+};
+
+/// A parameterized datapath macro which encapsulates a \p width bit two's complement
+/// subtractor. The difference output is \p a - \p b.
+template <int width, unsigned int delay = 0>
+class Subtractor
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    Subtractor(const Bus<width> &diff, const InputBus<width> &a, const InputBus<width> &b)
+    {
+        Bus<width> out(diff);
+        out.template cass<delay>(a - b);
+    }
+};
+
+/// A parameterized datapath macro which encapsulates a multiplier of two \p width bit
+/// unsigned numbers. The product output is \p 2*width bits wide.
+template <int width, unsigned int delay = 0>
+class Multiplier
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    Multiplier(const Bus<2*width> &product, const InputBus<width> &a, const InputBus<width> &b)
+    {
+        Bus<2*width> out(product);
+        out.template cass<delay>(a * b);
+    }
+};
+
+/// A parameterized datapath macro which encapsulates a magnitude comparator of two
+/// \p width bit unsigned numbers. Exactly one of the three outputs is \p lcs::HIGH when
+/// both the inputs are known. All the outputs are \p lcs::UNKNOWN otherwise.
+template <int width, unsigned int delay = 0>
+class Comparator
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    /// \param lt The output which is \p lcs::HIGH if \p a is less than \p b.
+    /// \param eq The output which is \p lcs::HIGH if \p a is equal to \p b.
+    /// \param gt The output which is \p lcs::HIGH if \p a is greater than \p b.
+    /// \param a The first operand.
+    /// \param b The second operand.
+    ///
+    Comparator(const Bus<1> &lt, const Bus<1> &eq, const Bus<1> &gt,
+               const InputBus<width> &a, const InputBus<width> &b)
+    {
+        Bus<1> l(lt), e(eq), g(gt);
+
+        l.template cass<delay>(a < b);
+        e.template cass<delay>(equalTo(a, b));
+        g.template cass<delay>(a > b);
+    }
+};
+
+/// A parameterized datapath macro which encapsulates a \p width bit logical left shifter.
+/// The input is shifted by the number of bits given by the \p abits bit amount input.
+template <int width, int abits, unsigned int delay = 0>
+class LeftShifter
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    LeftShifter(const Bus<width> &out, const InputBus<width> &in, const InputBus<abits> &amount)
+    {
+        Bus<width> o(out);
+        o.template cass<delay>(in << amount);
+    }
+};
+
+/// A parameterized datapath macro which encapsulates a \p width bit logical right shifter.
+/// The input is shifted by the number of bits given by the \p abits bit amount input.
+template <int width, int abits, unsigned int delay = 0>
+class RightShifter
+{
+public:
+
+    /// The only meaningfull constructor.
+    ///
+    RightShifter(const Bus<width> &out, const InputBus<width> &in, const InputBus<abits> &amount)
+    {
+        Bus<width> o(out);
+        o.template cass<delay>(in >> amount);
+    }
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_DATAPATH_H__
@@ -134,7 +134,7 @@ template <PulseEdge type, unsigned int delay>
 void DFlipFlop<type, delay>::trigger(void)
 {
     if (rst[0] != HIGH)
-        q[0] = (delay, d[0]);
+        q.set<delay>(0, d.get(0));
 
     return;
 }
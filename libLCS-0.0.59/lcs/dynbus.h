@@ -0,0 +1,220 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_DYN_BUS_H__
+#define __LCS_DYN_BUS_H__
+
+#include "bus.h"
+#include "inbus.h"
+#include "line.h"
+#include "linestate.h"
+#include "linevent.h"
+#include "module.h"
+#include "outofrange_exception.h"
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class encapsulating a set of data lines whose number is chosen at run time. A
+/// \p DynBus is the counterpart of \p lcs::Bus for circuits whose structure is known only
+/// at run time, like the ones generated by a program: a single compiled implementation
+/// serves buses of all widths. As with \p lcs::Bus, the lines are organised in the little
+/// endian format, copies of a \p DynBus share the same set of lines, and all the lines
+/// written by a single assignment take their new states before any module driven by the
+/// bus is notified (see \p lcs::WriteGroup).
+///
+/// A \p DynBus can be made from the lines of an \p lcs::InputBus or an \p lcs::Bus, and
+/// converted to an \p lcs::Bus of the same width using \p lcs::DynBus::toBus; the busses
+/// so made share their lines. Hence, modules with fixed and run time widths can be freely
+/// connected to each other.
+class DynBus
+{
+public:
+
+    /// Constructor. The data lines are all initialised to the \p lcs::UNKNOWN state.
+    ///
+    /// \param width The number of data lines in the bus.
+    explicit DynBus(int width = 1);
+
+    /// Line initialising constructor. The bus lines are initialised with the binary
+    /// equivalent of the integer \p val. If the integer has more bits than the bus width,
+    /// the excess bits are ignored.
+    ///
+    /// \param width The number of data lines in the bus.
+    /// \param val The integer with which the bus lines are to be initialised.
+    DynBus(int width, unsigned long val);
+
+    /// Creates a bus which shares the lines of the bus \p bus.
+    ///
+    template <int w>
+    DynBus(const InputBus<w> &bus);
+
+    /// Copy constructor. Performs only a shallow copy. The new \p DynBus object and \p bus
+    /// share the same set of lines.
+    DynBus(const DynBus &bus);
+
+    /// Destructor.
+    ///
+    ~DynBus();
+
+    /// Returns the bus width.
+    ///
+    int width(void) const { return width_; }
+
+    /// Returns the line state of the line at index \p index. An
+    /// \p lcs::OutOfRangeException is thrown if the index is not within the bus width.
+    const LineState get(int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the line at index \p index. An \p lcs::OutOfRangeException is thrown if
+    /// the index is not within the bus width.
+    const Line& getLine(int index) const throw (OutOfRangeException<int>);
+
+    /// Returns a single line bus which shares the line at index \p index. An
+    /// \p lcs::OutOfRangeException is thrown if the index is not within the bus width.
+    DynBus operator[](int index) const throw (OutOfRangeException<int>);
+
+    /// Returns a bus of \p w lines which shares the lines of this bus starting from the
+    /// line at index \p s. The lines beyond the width of this bus are new lines.
+    DynBus partSelect(int s, int w) const;
+
+    /// Joins the lines of this bus and the bus \p bus to form a new bus. The lines of
+    /// \p bus take the MSB locations of the new bus.
+    DynBus operator,(const DynBus &bus) const;
+
+    /// Returns an \p lcs::Bus which shares the lines of this bus. An
+    /// \p lcs::OutOfRangeException is thrown if \p w is not the width of this bus.
+    template <int w>
+    Bus<w> toBus(void) const throw (OutOfRangeException<int>);
+
+    /// Assigns the state \p state to the line at index \p index after \p delay system
+    /// time units. An \p lcs::OutOfRangeException is thrown if the index is not within the
+    /// bus width.
+    void set(int index, const LineState &state, unsigned int delay = 0)
+             throw (OutOfRangeException<int>);
+
+    /// Assigns the state \p state to the line at index \p index with the delay \p delay.
+    /// As with \p lcs::Bus::set, the choice between a zero delay assignment and a scheduled
+    /// one is made at compile time. An \p lcs::OutOfRangeException is thrown if the index
+    /// is not within the bus width.
+    template <unsigned int delay>
+    void set(int index, const LineState &state) throw (OutOfRangeException<int>);
+
+    /// Assigns the state \p state to all the lines of the bus after \p delay system time
+    /// units.
+    void assign(const LineState &state, unsigned int delay = 0);
+
+    /// Assigns the binary equivalent of \p val to the bus lines after \p delay system time
+    /// units.
+    void assign(unsigned long val, unsigned int delay = 0);
+
+    /// Assigns the line states of the bus \p bus to the lines of this bus after \p delay
+    /// system time units. If the widths differ, the excess lines of the wider bus are
+    /// ignored.
+    void assign(const DynBus &bus, unsigned int delay = 0);
+
+    /// Assigns the state \p state to all the lines of the bus.
+    ///
+    void operator=(const LineState &state) { assign(state); }
+
+    /// Assigns the binary equivalent of \p val to the bus lines.
+    ///
+    void operator=(unsigned long val) { assign(val); }
+
+    /// Assigns the line states of the bus \p bus to the lines of this bus. Note that, as
+    /// with \p lcs::Bus, this assigns the line states; it does not make this bus share the
+    /// lines of \p bus.
+    void operator=(const DynBus &bus) { assign(bus); }
+
+    /// Registers the module \p mod to be notified of the line event \p event on the line
+    /// at index \p line, or on all the lines if \p line is negative. See
+    /// \p lcs::InputBus::notify for more information.
+    void notify(Module *mod, const LineEvent &event, int portId, int line = -1)
+                throw (OutOfRangeException<int>);
+
+    /// Registers the module \p mod to be notified of the state changes of the lines with
+    /// the indices of the lines which changed. See \p lcs::InputBus::notifyBits for more
+    /// information.
+    void notifyBits(Module *mod, int portId);
+
+    /// De-registers the module \p mod registered using \p lcs::DynBus::notify or
+    /// \p lcs::DynBus::notifyBits.
+    void stopNotification(Module *mod, const LineEvent &event, int portId, int line = -1)
+                          throw (OutOfRangeException<int>);
+
+    /// Converts the binary bit value in the bus lines to an integer. Returns 0 if any of the
+    /// lines is in the \p lcs::UNKNOWN or \p lcs::HIGH_IMPEDENCE states.
+    unsigned long toInt(void) const;
+
+    /// Converts the binary bit value in the bus lines to a string representation, the line
+    /// at index 0 first.
+    std::string toStr(void) const;
+
+private:
+
+    void release(void);
+
+    int width_;
+    int *refCount_;
+    Line *lines_;
+};
+
+template <int w>
+DynBus::DynBus(const InputBus<w> &bus)
+    : width_(w), refCount_(new int(1)), lines_(new Line[w])
+{
+    Line *data = bus.dataPtr->data;
+    for (int i = 0; i < w; i++)
+        lines_[i] = data[i];
+}
+
+template <int w>
+Bus<w> DynBus::toBus(void) const throw (OutOfRangeException<int>)
+{
+    if (w != width_)
+        throw OutOfRangeException<int>(width_, width_, w);
+
+    Bus<w> b;
+    InputBus<w> &ib = b;
+
+    Line *data = ib.dataPtr->data;
+    for (int i = 0; i < w; i++)
+        data[i] = lines_[i];
+
+    return b;
+}
+
+template <unsigned int delay>
+void DynBus::set(int index, const LineState &state) throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= width_)
+        throw OutOfRangeException<int>(0, width_-1, index);
+
+    WriteGroup group;
+    lines_[index].assign(state, delay);
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_DYN_BUS_H__
@@ -0,0 +1,207 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_DYN_GATE_H__
+#define __LCS_DYN_GATE_H__
+
+#include "bitdepmap.h"
+#include "dynbus.h"
+#include "gateeval.h"
+#include "gatetype.h"
+#include "module.h"
+#include "outofrange_exception.h"
+#include "writegroup.h"
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class (an \p lcs::Module derivative) which encapsulates a logic gate whose function,
+/// number of inputs and propogation delay are chosen at run time. The gate modules whose
+/// widths and delays are template parameters (\p lcs::And, \p lcs::Or, \p lcs::Nand,
+/// \p lcs::Nor, \p lcs::Xor, \p lcs::Not and \p lcs::Buffer) are thin wrappers over this
+/// class, so that all of them share a single compiled implementation.
+///
+/// The gates of the types \p lcs::AND_GATE, \p lcs::OR_GATE, \p lcs::NAND_GATE,
+/// \p lcs::NOR_GATE and \p lcs::XOR_GATE have a single line output; those of the types
+/// \p lcs::NOT_GATE and \p lcs::BUFFER_GATE have an output line for every input line.
+///
+/// A gate holds the states of its inputs in two packed bit planes, in the same manner as
+/// \p lcs::WordState: a value plane and an unknown plane. The outputs of the gates which
+/// reduce their inputs to a single line depend only on the number of \p lcs::HIGH inputs,
+/// which is the number of bits set in the value plane with the unknown bits masked off.
+/// An AND gate, for example, drives \p lcs::HIGH if that number is the number of inputs.
+/// See \p lcs::GateEvaluation for the manners in which the planes and the count are kept
+/// up to date.
+///
+/// The gate modules whose delays are template parameters evaluate their outputs through
+/// \p lcs::DynGate::evaluate instantiated with their delays, so that, as with
+/// \p lcs::Bus::set, the choice between a zero delay assignment of the outputs and a
+/// scheduled one is made at compile time.
+class DynGate : public Module
+{
+public:
+
+    /// A constant integer which denotes the port id for the input bus.
+    ///
+    static const int INPUT;
+
+    /// A constant integer which denotes the port id for the output bus.
+    ///
+    static const int OUTPUT;
+
+public:
+
+    /// Constructor. An \p lcs::OutOfRangeException is thrown if the width of the output
+    /// bus does not suit the gate type.
+    ///
+    /// \param type The logic function of the gate.
+    /// \param output The output bus of the gate.
+    /// \param input The input bus of the gate.
+    /// \param delay The propogation delay from the input to the output of the gate.
+    /// \param evaluation The manner in which the gate evaluates its output.
+    DynGate(GateType type, const DynBus &output, const DynBus &input, unsigned int delay = 0,
+            GateEvaluation evaluation = AUTOMATIC_GATE_EVALUATION) throw (OutOfRangeException<int>);
+
+    /// Destructor.
+    ///
+    virtual ~DynGate();
+
+    /// Returns the number of inputs of the gate which are in the \p lcs::HIGH state.
+    ///
+    int getHighInputCount(void) const { return highCount_; }
+
+    /// Returns the number of inputs of the gate which are in the \p lcs::UNKNOWN or
+    /// \p lcs::HIGH_IMPEDENCE states.
+    int getUnknownInputCount(void) const { return unknownCount_; }
+
+    /// Computes the output of the gate when the line states of the input bus change. In
+    /// the \p lcs::INCREMENTAL_GATE_EVALUATION manner, the port id identifies the input
+    /// net which changed; a port id which is not positive causes all the inputs to be read
+    /// again.
+    virtual void onStateChange(int portId);
+
+    /// The batch evaluator of the gates (see \p lcs::Module::setBatchEvaluator). Evaluates
+    /// the gates \p mods, all of which should be \p lcs::DynGate objects, in a single loop
+    /// through \p lcs::DynGate::evaluate with the delay \p delay.
+    template <unsigned int delay>
+    static void evaluateBatch(Module *const *mods, const int *portIds, int count);
+
+protected:
+
+    /// The delay argument of \p lcs::DynGate::evaluate which stands for the delay passed
+    /// to the constructor, as for the gates made directly at run time.
+    static const unsigned int RUNTIME_DELAY = 0xffffffffu;
+
+    /// Does the work of \p lcs::DynGate::onStateChange, driving the outputs with the delay
+    /// \p delay. A gate module passes its delay template parameter.
+    template <unsigned int delay>
+    void evaluate(int portId);
+
+private:
+
+    /// Copying a gate is not allowed.
+    ///
+    DynGate(const DynGate &gate);
+
+    /// Records the state \p state of the input at the index \p i in the bit planes and
+    /// the counts. Returns \p true if the state of the input has changed.
+    bool setInput(int i, const LineState &state);
+
+    /// Reads all the input lines into the bit planes, one line at a time, and then counts
+    /// the \p lcs::HIGH and the unknown inputs a whole limb of the planes at a time.
+    void load(void);
+
+    /// Returns \p true for the gate types which have an output line for every input line.
+    ///
+    bool isPerLine(void) const { return type_ == NOT_GATE || type_ == BUFFER_GATE; }
+
+    /// Returns the state of the output line at the index \p index, computed from the bit
+    /// planes and the counts.
+    LineState getOutput(int index) const;
+
+    /// Drives the output lines from the bit planes with the delay \p delay. Only the
+    /// output line at the index \p changed is driven if \p changed is not negative.
+    template <unsigned int delay>
+    void drive(int changed);
+
+    GateType type_;
+    unsigned int delay_;
+    DynBus outBus;
+    DynBus inBus;
+    BitDependencyMap *deps_;
+    std::vector<unsigned int> value_, unknown_;
+    int highCount_, unknownCount_;
+};
+
+template <unsigned int delay>
+void DynGate::evaluateBatch(Module *const *mods, const int *portIds, int count)
+{
+    for (int i = 0; i < count; i++)
+        static_cast<DynGate*>(mods[i])->evaluate<delay>(portIds[i]);
+}
+
+template <unsigned int delay>
+void DynGate::evaluate(int portId)
+{
+    if (deps_ == NULL || portId <= 0)
+    {
+        load();
+        drive<delay>(-1);
+        return;
+    }
+
+    const std::vector<int> &inputs = deps_->bits(portId);
+    LineState state = inBus.get(inputs[0]);
+
+    for (unsigned int k = 0; k < inputs.size(); k++)
+    {
+        // A net can be connected to more than one input of the gate.
+        if (setInput(inputs[k], state) && isPerLine())
+            drive<delay>(inputs[k]);
+    }
+
+    if (!isPerLine())
+        drive<delay>(-1);
+}
+
+template <unsigned int delay>
+void DynGate::drive(int changed)
+{
+    WriteGroup group;
+    int first = (changed < 0) ? 0 : changed;
+    int last = !isPerLine() ? 1 : (changed < 0) ? inBus.width() : changed + 1;
+
+    for (int i = first; i < last; i++)
+    {
+        if (delay == RUNTIME_DELAY)
+            outBus.set(i, getOutput(i), delay_);
+        else
+            outBus.set<delay>(i, getOutput(i));
+    }
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_DYN_GATE_H__
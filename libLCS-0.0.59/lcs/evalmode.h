@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_EVAL_MODE_H__
+#define __LCS_EVAL_MODE_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration which specifies the manner in which the modules are evaluated when
+/// the states of their input lines change. See \p lcs::Simulation::setEvaluationMode.
+enum EvaluationMode
+{
+
+    /// A module is notified as soon as an input line changes state. A module with several
+    /// inputs which change together is hence evaluated once for each of them.
+    IMMEDIATE_EVALUATION = 5120,
+
+    /// An input line state change only marks the module dirty. All the line state changes
+    /// of a delta cycle are made first, after which every dirty module is notified once.
+    DELTA_EVALUATION     = 5121,
+
+    /// As in the \p lcs::DELTA_EVALUATION mode, every dirty module is notified once after
+    /// all the line state changes of a delta cycle have been made. In addition, the dirty
+    /// modules of the types which provide a batch evaluator (see
+    /// \p lcs::Module::setBatchEvaluator), such as the gates, are grouped by their types,
+    /// and each group is evaluated in a single loop without virtual calls.
+    BATCHED_EVALUATION   = 5122
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_EVAL_MODE_H__
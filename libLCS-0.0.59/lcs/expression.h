@@ -33,6 +33,9 @@
 #include "delexprpair.h"
 #include "contassmod.h"
 #include "hiddenmodman.h"
+#include "bitdepmap.h"
+#include "exprgraph.h"
+#include "wordstate.h"
 #include <iostream>
 
 namespace lcs
@@ -87,6 +90,184 @@ inline const LineState binaryLineStateOperation<BITWISE_XOR_EXPR>(
     return l^r;
 }
 
+// ################################################################################
+// Expression operations
+// ################################################################################
+
+/// A class which implements the evaluation of a binary expression of the type \p Type on
+/// its operand expressions. The generic version implements the bitwise operations, which
+/// are evaluated a bit at a time. The version for the word level operations (the
+/// operations with \p isWord set to \p true) is specialized below. A user of libLCS will
+/// never need to use this class directly.
+template <ExprType Type, bool isWord = (Type >= ADD_EXPR)>
+class ExprOperation
+{
+public:
+
+    /// Returns the state of the bit at the index \p i of the result.
+    ///
+    template <int bits, typename LExprType, typename RExprType>
+    static const LineState bit(const LExprType &l, const RExprType &r, int i)
+    {
+        int lwidth = l.width(), rwidth = r.width();
+
+        if (i < lwidth && i < rwidth)
+            return binaryLineStateOperation<Type>(l[i], r[i]);
+        else if (lwidth < rwidth)
+            return r[i];
+        else if (rwidth < lwidth)
+            return l[i];
+        else
+            return UNKNOWN;
+    }
+
+    /// Returns the states of all the bits of the result.
+    ///
+    template <int bits, typename LExprType, typename RExprType>
+    static const WordState<bits> word(const LExprType &l, const RExprType &r)
+    {
+        WordState<bits> result;
+        for (int i = 0; i < bits; i++)
+            result.set(i, bit<bits>(l, r, i));
+
+        return result;
+    }
+
+    /// Adds the nets on which the bit at the index \p i depends to the dependency map
+    /// \p deps. The bit at an index depends only on the bits at the same index of the
+    /// operands.
+    template <typename LExprType, typename RExprType>
+    static void cone(LExprType &l, RExprType &r, int i, int outBit, BitDependencyMap &deps)
+    {
+        int lwidth = l.width(), rwidth = r.width();
+
+        if (i < lwidth && i < rwidth)
+        {
+            l.cone(i, outBit, deps);
+            r.cone(i, outBit, deps);
+        }
+        else if (lwidth < rwidth)
+            r.cone(i, outBit, deps);
+        else if (rwidth < lwidth)
+            l.cone(i, outBit, deps);
+    }
+
+    /// Returns the id of the \p lcs::ExpressionGraph node which computes the bit at the
+    /// index \p i.
+    template <typename LExprType, typename RExprType>
+    static int graphNode(LExprType &l, RExprType &r, int i)
+    {
+        int lwidth = l.width(), rwidth = r.width();
+
+        if (i < lwidth && i < rwidth)
+        {
+            int ln = l.graphNode(i), rn = r.graphNode(i);
+            if (ln < 0 || rn < 0)
+                return -1;
+
+            return ExpressionGraph::binary(Type, ln, rn);
+        }
+        else if (lwidth < rwidth)
+            return r.graphNode(i);
+        else if (rwidth < lwidth)
+            return l.graphNode(i);
+        else
+            return ExpressionGraph::unknown();
+    }
+};
+
+/// The version of \p lcs::ExprOperation for the word level operations (arithmetic,
+/// comparison and shift operations). The operands are evaluated as whole words, and the
+/// operation is performed on the words.
+template <ExprType Type>
+class ExprOperation<Type, true>
+{
+public:
+
+    /// Returns the state of the bit at the index \p i of the result. The whole word is
+    /// evaluated to obtain the bit.
+    template <int bits, typename LExprType, typename RExprType>
+    static const LineState bit(const LExprType &l, const RExprType &r, int i)
+    {
+        return word<bits>(l, r).get(i);
+    }
+
+    /// Returns the states of all the bits of the result.
+    ///
+    template <int bits, typename LExprType, typename RExprType>
+    static const WordState<bits> word(const LExprType &l, const RExprType &r)
+    {
+        return apply<bits>(l.word(), r.word());
+    }
+
+    /// Adds the nets on which the bit at the index \p i depends to the dependency map
+    /// \p deps. A bit of a sum, difference or product depends on the operand bits at and
+    /// below its index. The bits of the other results depend on all the operand bits.
+    template <typename LExprType, typename RExprType>
+    static void cone(LExprType &l, RExprType &r, int i, int outBit, BitDependencyMap &deps)
+    {
+        bool prefix = (Type == ADD_EXPR || Type == SUBTRACT_EXPR || Type == MULTIPLY_EXPR);
+
+        for (int j = 0; j < l.width() && (!prefix || j <= i); j++)
+            l.cone(j, outBit, deps);
+
+        for (int j = 0; j < r.width() && (!prefix || j <= i); j++)
+            r.cone(j, outBit, deps);
+    }
+
+    /// Word level operations cannot be a part of an \p lcs::ExpressionGraph. Always
+    /// returns -1.
+    template <typename LExprType, typename RExprType>
+    static int graphNode(LExprType &l, RExprType &r, int i) { return -1; }
+
+private:
+
+    /// Performs the operation on the operand words \p a and \p b. The operands are
+    /// extended to the wider of the result and operand widths before the operation.
+    template <int bits, int lbits, int rbits>
+    static const WordState<bits> apply(const WordState<lbits> &a, const WordState<rbits> &b)
+    {
+        enum { WIDTH = ((lbits > rbits ? lbits : rbits) > bits ? (lbits > rbits ? lbits : rbits)
+                                                               : bits) };
+
+        WordState<WIDTH> x(a), y(b);
+
+        switch (Type)
+        {
+            case ADD_EXPR         : return WordState<bits>(x.add(y));
+            case SUBTRACT_EXPR    : return WordState<bits>(x.subtract(y));
+            case MULTIPLY_EXPR    : return WordState<bits>(x.multiply(y));
+            case SHIFT_LEFT_EXPR  : return WordState<bits>(a).shiftLeft(b);
+            case SHIFT_RIGHT_EXPR : return WordState<bits>(a).shiftRight(b);
+            default               : break;
+        }
+
+        WordState<bits> result;
+
+        if (!x.isKnown() || !y.isKnown())
+        {
+            result.set(0, UNKNOWN);
+            return result;
+        }
+
+        int c = x.compare(y);
+        bool holds;
+
+        switch (Type)
+        {
+            case EQUAL_EXPR         : { holds = (c == 0); break; }
+            case NOT_EQUAL_EXPR     : { holds = (c != 0); break; }
+            case LESS_EXPR          : { holds = (c < 0); break; }
+            case LESS_EQUAL_EXPR    : { holds = (c <= 0); break; }
+            case GREATER_EXPR       : { holds = (c > 0); break; }
+            default                 : { holds = (c >= 0); break; }
+        }
+
+        result.set(0, holds ? HIGH : LOW);
+        return result;
+    }
+};
+
 // ################################################################################
 // GENERIC Expression class
 // ################################################################################
@@ -120,6 +301,19 @@ public:
     /// state changes in the busses used in the expression.
     void notify(Module *mod) { lExpr.notify(mod); rExpr.notify(mod); }
 
+    /// Adds the nets on which the bit at the index \p index depends to the dependency
+    /// map \p deps, as dependencies of the output bit \p outBit. For the bitwise operations,
+    /// the bit at an index depends only on the bits at the same index of the operands.
+    void cone(int index, int outBit, BitDependencyMap &deps);
+
+    /// Returns the id of the \p lcs::ExpressionGraph node which computes the bit at the
+    /// index \p index. Returns -1 if the expression cannot be represented in the graph.
+    int graphNode(int index);
+
+    /// Returns the states of all the bits of the expression, evaluated as a whole word.
+    ///
+    const WordState<bits> word(void) const { return ExprOperation<Type>::template word<bits>(lExpr, rExpr); }
+
 private:
     LExprType lExpr;
     RExprType rExpr;
@@ -146,17 +340,20 @@ const LineState Expression<bits, Type, LExprType, RExprType>::operator[](int i)
     if (i >= bits || i < 0)
         throw OutOfRangeException<int>(0, bits-1, i);
 
-    int lwidth = lExpr.width(), rwidth = rExpr.width();
+    return ExprOperation<Type>::template bit<bits>(lExpr, rExpr, i);
+}
 
-    if (i < lwidth && i < rwidth)
-        return binaryLineStateOperation<Type>(lExpr[i], rExpr[i]);
-    else if (lwidth < rwidth)
-        return rExpr[i];
-    else if (rwidth < lwidth)
-        return lExpr[i];
-    else
-        return UNKNOWN;
+template <int bits, ExprType Type, typename LExprType, typename RExprType>
+void Expression<bits, Type, LExprType, RExprType>::cone(int i, int outBit,
+                                                        BitDependencyMap &deps)
+{
+    ExprOperation<Type>::cone(lExpr, rExpr, i, outBit, deps);
+}
 
+template <int bits, ExprType Type, typename LExprType, typename RExprType>
+int Expression<bits, Type, LExprType, RExprType>::graphNode(int i)
+{
+    return ExprOperation<Type>::graphNode(lExpr, rExpr, i);
 }
 
 // #####################################################################################
@@ -184,6 +381,21 @@ public:
     /// state changes in the busses used in the expression.
     void notify(Module *mod) { bus.notify(mod, LINE_STATE_CHANGE, 0); }
 
+    /// Adds the net of the bus line at the index \p index to the dependency map \p deps,
+    /// as a dependency of the output bit \p outBit.
+    void cone(int index, int outBit, BitDependencyMap &deps)
+    {
+        deps.add(bus.dataPtr->data[index], outBit);
+    }
+
+    /// Returns the id of the \p lcs::ExpressionGraph leaf node of the bus line at the
+    /// index \p index.
+    int graphNode(int index) { return ExpressionGraph::leaf(bus.dataPtr->data[index]); }
+
+    /// Returns the states of all the lines of the bus.
+    ///
+    const WordState<bits> word(void) const;
+
     /// Returns the bit state (which is a result of the operation performed by the
     /// expression) at the index specified.
     const LineState operator[](int index) const throw (OutOfRangeException<int>);
@@ -213,6 +425,18 @@ const LineState Expression<bits,BUS_EXPR,void,void>::operator[](int index)
     return line();
 }
 
+template <int bits>
+const WordState<bits> Expression<bits,BUS_EXPR,void,void>::word(void) const
+{
+    Line *data = bus.dataPtr->data;
+    WordState<bits> result;
+
+    for (int i = 0; i < bits; i++)
+        result.set(i, data[i]());
+
+    return result;
+}
+
 // #####################################################################################
 // BITBUFF_EXPR
 // #####################################################################################
@@ -256,6 +480,19 @@ public:
     /// state changes in the busses used in the expression.
     void notify(Module *mod) { buf.notify(mod); }
 
+    /// Registers the module of the dependency map \p deps to be notified of the state
+    /// changes of the bit at the index \p index. As bits notify modules without a port id,
+    /// a change of the bit will cause all the output bits of the module to be recomputed.
+    void cone(int index, int outBit, BitDependencyMap &deps) { buf.notify(deps.getModule(), index); }
+
+    /// Bits are not nets, and hence, cannot be a part of an \p lcs::ExpressionGraph.
+    /// Always returns -1.
+    int graphNode(int index) { return -1; }
+
+    /// Returns the states of all the bits of the bit buffer.
+    ///
+    const WordState<bits> word(void) const;
+
 private:
     BitBuff<bits> buf;
 };
@@ -275,27 +512,20 @@ const LineState Expression<bits,BITBUFF_EXPR,void,void>::operator[](int index)
     if (index < 0 || index >= bits)
         throw OutOfRangeException<int>(0, bits, index);
 
-    Bit *data = buf.dataPtr->data;
-    Bit b = data[index];
-    return b.state();
+    return buf.get(index);
+}
+
+template <int bits>
+const WordState<bits> Expression<bits,BITBUFF_EXPR,void,void>::word(void) const
+{
+    return buf.word();
 }
 
 template <int bits>
 template <int w, ExprType Type, typename LExprType, typename RExprType>
 void Expression<bits,BITBUFF_EXPR,void,void>::operator=(const Expression<w,Type,LExprType,RExprType> &expr)
 {
-    Bit *data = buf.dataPtr->data;
-
-    if (bits < w)
-    {
-        for (int i = 0; i < bits; i++)
-            data[i] = expr[i];
-    }
-    else
-    {
-        for (int i = 0; i < w; i++)
-            data[i] = expr[i];
-    }
+    buf.assign(expr.word());
 }
 
 template <int bits>
@@ -303,19 +533,18 @@ void Expression<bits,BITBUFF_EXPR,void,void>::operator=(
                                 const Expression<bits, BITBUFF_EXPR, void, void> &expr
                                                         )
 {
-    Bit *data = buf.dataPtr->data;
-
-    for (int i = 0; i < bits; i++)
-        data[i] = expr[i];
+    buf.assign(expr.word());
 }
 
 template <int bits>
 void Expression<bits,BITBUFF_EXPR,void,void>::operator=(const LineState &l)
 {
-    Bit *data = buf.dataPtr->data;
+    WordState<bits> value;
 
     for (int i = 0; i < bits; i++)
-        data[i] = l;
+        value.set(i, l);
+
+    buf.assign(value);
 }
 
 // #####################################################################################
@@ -351,6 +580,22 @@ public:
     /// state changes in the busses used in the expression.
     void notify(Module *mod) { inExpr.notify(mod); }
 
+    /// Adds the nets on which the bit at the index \p index depends to the dependency
+    /// map \p deps, as dependencies of the output bit \p outBit.
+    void cone(int index, int outBit, BitDependencyMap &deps) { inExpr.cone(index, outBit, deps); }
+
+    /// Returns the id of the \p lcs::ExpressionGraph node which computes the bit at the
+    /// index \p index. Returns -1 if the expression cannot be represented in the graph.
+    int graphNode(int index)
+    {
+        int in = inExpr.graphNode(index);
+        return in < 0 ? -1 : ExpressionGraph::complement(in);
+    }
+
+    /// Returns the states of all the bits of the expression, evaluated as a whole word.
+    ///
+    const WordState<bits> word(void) const;
+
 public:
     InExprType inExpr;
 };
@@ -377,11 +622,770 @@ const LineState Expression<bits, ONES_COMPLEMENT_EXPR, void, InExprType>::
     return ~inExpr[i];
 }
 
+template <int bits, typename InExprType>
+const WordState<bits> Expression<bits, ONES_COMPLEMENT_EXPR, void, InExprType>::word(void) const
+{
+    WordState<bits> result(inExpr.word());
+
+    for (int i = 0; i < bits; i++)
+        result.set(i, ~result.get(i));
+
+    return result;
+}
+
+// #####################################################################################
+// AND_REDUCE_EXPR, OR_REDUCE_EXPR and XOR_REDUCE_EXPR
+// #####################################################################################
+
+/// A class whose objects are created as temporary objects corresponding to an expression
+/// which reduces all the bits of an expression to a single bit. Use the functions
+/// \p lcs::andReduce, \p lcs::orReduce and \p lcs::xorReduce to create such expressions.
+/// A user of libLCS will never need to use this class explicitly.
+template <int bits, ExprType Type, typename InExprType>
+class Expression<bits, Type, void, InExprType>
+{
+public:
+
+    /// The only usefull constructor. The default constructor is practically useless.
+    ///
+    Expression(const InExprType &e) : inExpr(e) {}
+
+    /// Copy constructor.
+    ///
+    Expression(const Expression<bits, Type, void, InExprType> &e) : inExpr(e.inExpr) {}
+
+    /// Returns the bit state (which is a result of the reduction performed by the
+    /// expression) at the index specified.
+    const LineState operator[](int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the width for which an \p lcs::Expression object is valid.
+    ///
+    int width(void) const { return bits; }
+
+    /// This function can be used by a \p lcs::Module derivative to be notified of line
+    /// state changes in the busses used in the expression.
+    void notify(Module *mod) { inExpr.notify(mod); }
+
+    /// Adds the nets on which the bit at the index \p index depends to the dependency
+    /// map \p deps, as dependencies of the output bit \p outBit. The reduced bit depends
+    /// on all the bits of the operand.
+    void cone(int index, int outBit, BitDependencyMap &deps)
+    {
+        for (int i = 0; i < inExpr.width(); i++)
+            inExpr.cone(i, outBit, deps);
+    }
+
+    /// Reductions cannot be a part of an \p lcs::ExpressionGraph. Always returns -1.
+    ///
+    int graphNode(int index) { return -1; }
+
+    /// Returns the states of all the bits of the expression, evaluated as a whole word.
+    ///
+    const WordState<bits> word(void) const;
+
+private:
+    InExprType inExpr;
+};
+
+template <int bits, ExprType Type, typename InExprType>
+const LineState Expression<bits, Type, void, InExprType>::operator[](int i)
+                                                    const throw (OutOfRangeException<int>)
+{
+    if (i >= bits || i < 0)
+        throw OutOfRangeException<int>(0, bits-1, i);
+
+    return word().get(i);
+}
+
+template <int bits, ExprType Type, typename InExprType>
+const WordState<bits> Expression<bits, Type, void, InExprType>::word(void) const
+{
+    WordState<bits> result;
+
+    switch (Type)
+    {
+        case AND_REDUCE_EXPR : { result.set(0, inExpr.word().andReduce()); break; }
+        case OR_REDUCE_EXPR  : { result.set(0, inExpr.word().orReduce()); break; }
+        default              : { result.set(0, inExpr.word().xorReduce()); break; }
+    }
+
+    return result;
+}
+
+// #####################################################################################
+// CONST_EXPR
+// #####################################################################################
+
+/// A class whose objects are created as temporary objects corresponding to a constant in
+/// an expression. Use the function \p lcs::constant to create such expressions. Integer
+/// operands of the arithmetic, comparison and shift operators are converted to 32 bit
+/// constants implicitly. A user of libLCS will never need to use this class explicitly.
+template <int bits>
+class Expression<bits, CONST_EXPR, void, void>
+{
+public:
+
+    /// The only usefull constructor. The constant is the binary equivalent of \p value.
+    ///
+    Expression(unsigned int value) : value_(value) {}
+
+    /// Copy constructor.
+    ///
+    Expression(const Expression<bits, CONST_EXPR, void, void> &e) : value_(e.value_) {}
+
+    /// Returns the state of the bit at the index specified.
+    ///
+    const LineState operator[](int index) const throw (OutOfRangeException<int>)
+    {
+        if (index >= bits || index < 0)
+            throw OutOfRangeException<int>(0, bits-1, index);
+
+        return value_.get(index);
+    }
+
+    /// Returns the width for which an \p lcs::Expression object is valid.
+    ///
+    int width(void) const { return bits; }
+
+    /// Constants do not change. Hence, this function does nothing.
+    ///
+    void notify(Module *mod) {}
+
+    /// Constants do not depend on any net. Hence, this function does nothing.
+    ///
+    void cone(int index, int outBit, BitDependencyMap &deps) {}
+
+    /// Constants are not a part of an \p lcs::ExpressionGraph. Always returns -1.
+    ///
+    int graphNode(int index) { return -1; }
+
+    /// Returns the states of all the bits of the constant.
+    ///
+    const WordState<bits> word(void) const { return value_; }
+
+private:
+    WordState<bits> value_;
+};
+
+// #####################################################################################
+// CONDITIONAL_EXPR
+// #####################################################################################
+
+/// A class which holds the two branches of a conditional expression. A user of libLCS will
+/// never need to use this class explicitly.
+template <typename AExprType, typename BExprType>
+class ExprChoice
+{
+public:
+
+    /// The only usefull constructor.
+    ///
+    ExprChoice(const AExprType &a, const BExprType &b) : aExpr(a), bExpr(b) {}
+
+    /// The branch which is selected when the condition is \p lcs::HIGH.
+    ///
+    AExprType aExpr;
+
+    /// The branch which is selected when the condition is \p lcs::LOW.
+    ///
+    BExprType bExpr;
+};
+
+/// A class whose objects are created as temporary objects corresponding to a conditional
+/// expression. Use the function \p lcs::select to create such expressions. The condition
+/// is \p lcs::HIGH if any of its bits is \p lcs::HIGH. Only the selected branch is
+/// evaluated. If the condition is not known, both the branches are evaluated, and the bits
+/// on which the branches do not agree are \p lcs::UNKNOWN. A branch narrower than the
+/// expression is zero extended. A user of libLCS will never need to use this class
+/// explicitly.
+template <int bits, typename CondExprType, typename AExprType, typename BExprType>
+class Expression<bits, CONDITIONAL_EXPR, CondExprType, ExprChoice<AExprType, BExprType> >
+{
+public:
+
+    /// The only usefull constructor. The default constructor is practically useless.
+    ///
+    Expression(const CondExprType &c, const ExprChoice<AExprType, BExprType> &choice)
+        : condExpr(c), aExpr(choice.aExpr), bExpr(choice.bExpr) {}
+
+    /// Copy constructor.
+    ///
+    Expression(const Expression<bits, CONDITIONAL_EXPR, CondExprType,
+                                ExprChoice<AExprType, BExprType> > &e)
+        : condExpr(e.condExpr), aExpr(e.aExpr), bExpr(e.bExpr) {}
+
+    /// Returns the bit state (which is a result of the selection performed by the
+    /// expression) at the index specified.
+    const LineState operator[](int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the width for which an \p lcs::Expression object is valid.
+    ///
+    int width(void) const { return bits; }
+
+    /// This function can be used by a \p lcs::Module derivative to be notified of line
+    /// state changes in the busses used in the expression.
+    void notify(Module *mod) { condExpr.notify(mod); aExpr.notify(mod); bExpr.notify(mod); }
+
+    /// Adds the nets on which the bit at the index \p index depends to the dependency
+    /// map \p deps, as dependencies of the output bit \p outBit. The nets of the condition
+    /// are added as control nets. If the map is dynamic and the condition is known, only
+    /// the nets of the selected branch are added.
+    void cone(int index, int outBit, BitDependencyMap &deps);
+
+    /// Conditional expressions cannot be a part of an \p lcs::ExpressionGraph. Always
+    /// returns -1.
+    int graphNode(int index) { return -1; }
+
+    /// Returns the states of all the bits of the expression, evaluated as a whole word.
+    ///
+    const WordState<bits> word(void) const;
+
+private:
+
+    /// Returns the state of the condition.
+    ///
+    const LineState condition(void) const { return condExpr.word().orReduce(); }
+
+    /// Returns the bit at the index \p i of the branch \p e, or \p lcs::LOW if the
+    /// branch is narrower.
+    template <typename ExprT>
+    static const LineState branchBit(const ExprT &e, int i) { return (i < e.width()) ? e[i] : LOW; }
+
+    /// Returns the state of a bit when the condition is not known.
+    ///
+    static const LineState merge(const LineState &a, const LineState &b)
+    {
+        return (a == b && (a == LOW || a == HIGH)) ? a : UNKNOWN;
+    }
+
+    CondExprType condExpr;
+    AExprType aExpr;
+    BExprType bExpr;
+};
+
+template <int bits, typename CondExprType, typename AExprType, typename BExprType>
+const LineState Expression<bits, CONDITIONAL_EXPR, CondExprType, ExprChoice<AExprType, BExprType> >::
+                            operator[](int i) const throw (OutOfRangeException<int>)
+{
+    if (i >= bits || i < 0)
+        throw OutOfRangeException<int>(0, bits-1, i);
+
+    LineState c = condition();
+
+    if (c == HIGH)
+        return branchBit(aExpr, i);
+    else if (c == LOW)
+        return branchBit(bExpr, i);
+    else
+        return merge(branchBit(aExpr, i), branchBit(bExpr, i));
+}
+
+template <int bits, typename CondExprType, typename AExprType, typename BExprType>
+void Expression<bits, CONDITIONAL_EXPR, CondExprType, ExprChoice<AExprType, BExprType> >::
+                            cone(int i, int outBit, BitDependencyMap &deps)
+{
+    bool control = deps.setControl(true);
+    for (int j = 0; j < condExpr.width(); j++)
+        condExpr.cone(j, outBit, deps);
+    deps.setControl(control);
+
+    LineState c = deps.isDynamic() ? condition() : UNKNOWN;
+
+    if (c != LOW && i < aExpr.width())
+        aExpr.cone(i, outBit, deps);
+
+    if (c != HIGH && i < bExpr.width())
+        bExpr.cone(i, outBit, deps);
+}
+
+template <int bits, typename CondExprType, typename AExprType, typename BExprType>
+const WordState<bits> Expression<bits, CONDITIONAL_EXPR, CondExprType,
+                                 ExprChoice<AExprType, BExprType> >::word(void) const
+{
+    LineState c = condition();
+
+    if (c == HIGH)
+        return WordState<bits>(aExpr.word());
+    else if (c == LOW)
+        return WordState<bits>(bExpr.word());
+
+    WordState<bits> a(aExpr.word()), b(bExpr.word()), result;
+    for (int i = 0; i < bits; i++)
+        result.set(i, merge(a.get(i), b.get(i)));
+
+    return result;
+}
+
+// #####################################################################################
+// MUX_EXPR
+// #####################################################################################
+
+/// A class whose objects are created as temporary objects corresponding to an N-way mux
+/// expression. Use the function \p lcs::mux to create such expressions. The data
+/// expression is treated as consecutive \p bits wide slices, and the slice whose index
+/// is the value of the select expression is selected. Only the bits of the selected slice
+/// are evaluated. If the select is not known, the bits on which all the slices do not
+/// agree are \p lcs::UNKNOWN. If the select is out of range, all the bits are
+/// \p lcs::UNKNOWN. A user of libLCS will never need to use this class explicitly.
+template <int bits, typename SelExprType, typename DataExprType>
+class Expression<bits, MUX_EXPR, SelExprType, DataExprType>
+{
+public:
+
+    /// The only usefull constructor. The default constructor is practically useless.
+    ///
+    Expression(const SelExprType &s, const DataExprType &d) : selExpr(s), dataExpr(d) {}
+
+    /// Copy constructor.
+    ///
+    Expression(const Expression<bits, MUX_EXPR, SelExprType, DataExprType> &e)
+        : selExpr(e.selExpr), dataExpr(e.dataExpr) {}
+
+    /// Returns the bit state (which is a result of the selection performed by the
+    /// expression) at the index specified.
+    const LineState operator[](int index) const throw (OutOfRangeException<int>);
+
+    /// Returns the width for which an \p lcs::Expression object is valid.
+    ///
+    int width(void) const { return bits; }
+
+    /// This function can be used by a \p lcs::Module derivative to be notified of line
+    /// state changes in the busses used in the expression.
+    void notify(Module *mod) { selExpr.notify(mod); dataExpr.notify(mod); }
+
+    /// Adds the nets on which the bit at the index \p index depends to the dependency
+    /// map \p deps, as dependencies of the output bit \p outBit. The nets of the select
+    /// are added as control nets. If the map is dynamic and the select is known, only the
+    /// nets of the selected slice are added.
+    void cone(int index, int outBit, BitDependencyMap &deps);
+
+    /// Mux expressions cannot be a part of an \p lcs::ExpressionGraph. Always returns -1.
+    ///
+    int graphNode(int index) { return -1; }
+
+    /// Returns the states of all the bits of the expression, evaluated as a whole word.
+    ///
+    const WordState<bits> word(void) const;
+
+private:
+
+    /// Returns the number of slices in the data expression.
+    ///
+    int slices(void) const { return dataExpr.width() / bits; }
+
+    /// Returns the index of the selected slice, or -1 if the select is not known.
+    ///
+    int selection(void) const { return index(selExpr.word()); }
+
+    /// Returns the value of the select word \p sel, or -1 if it is not known. A value
+    /// which is out of range is returned as the number of slices.
+    template <int w>
+    int index(const WordState<w> &sel) const
+    {
+        if (!sel.isKnown())
+            return -1;
+
+        int v = sel.toInt();
+        return (v < 0 || v >= slices()) ? slices() : v;
+    }
+
+    /// Returns the state of the bit at the index \p i for the selected slice \p sel.
+    ///
+    const LineState bit(int sel, int i) const;
+
+    SelExprType selExpr;
+    DataExprType dataExpr;
+};
+
+template <int bits, typename SelExprType, typename DataExprType>
+const LineState Expression<bits, MUX_EXPR, SelExprType, DataExprType>::bit(int sel, int i) const
+{
+    int n = slices();
+
+    if (sel >= n)
+        return UNKNOWN;
+    else if (sel >= 0)
+        return dataExpr[sel*bits + i];
+
+    LineState v = dataExpr[i];
+    if (v != LOW && v != HIGH)
+        return UNKNOWN;
+
+    for (int k = 1; k < n; k++)
+    {
+        if (dataExpr[k*bits + i] != v)
+            return UNKNOWN;
+    }
+
+    return v;
+}
+
+template <int bits, typename SelExprType, typename DataExprType>
+const LineState Expression<bits, MUX_EXPR, SelExprType, DataExprType>::operator[](int i)
+                                                    const throw (OutOfRangeException<int>)
+{
+    if (i >= bits || i < 0)
+        throw OutOfRangeException<int>(0, bits-1, i);
+
+    return bit(selection(), i);
+}
+
+template <int bits, typename SelExprType, typename DataExprType>
+void Expression<bits, MUX_EXPR, SelExprType, DataExprType>::cone(int i, int outBit,
+                                                                 BitDependencyMap &deps)
+{
+    bool control = deps.setControl(true);
+    for (int j = 0; j < selExpr.width(); j++)
+        selExpr.cone(j, outBit, deps);
+    deps.setControl(control);
+
+    int sel = deps.isDynamic() ? selection() : -1, n = slices();
+
+    if (sel >= 0 && sel < n)
+        dataExpr.cone(sel*bits + i, outBit, deps);
+    else if (sel < 0)
+    {
+        for (int k = 0; k < n; k++)
+            dataExpr.cone(k*bits + i, outBit, deps);
+    }
+}
+
+template <int bits, typename SelExprType, typename DataExprType>
+const WordState<bits> Expression<bits, MUX_EXPR, SelExprType, DataExprType>::word(void) const
+{
+    int sel = selection();
+    WordState<bits> result;
+
+    for (int i = 0; i < bits; i++)
+        result.set(i, bit(sel, i));
+
+    return result;
+}
+
+// #####################################################################################
+// Operand traits for the word level operators
+// #####################################################################################
+
+/// A traits class which converts the operands of the arithmetic, comparison and shift
+/// operators to expressions. The traits are defined only for the types which can be
+/// operands: \p lcs::InputBus, \p lcs::Bus, \p lcs::BitBuff, \p lcs::Expression and
+/// \p int. The operators are not considered for any other types.
+template <typename T>
+class ExprTraits
+{};
+
+template <int bits>
+class ExprTraits< InputBus<bits> >
+{
+public:
+    enum { BITS = bits };
+    typedef Expression<bits, BUS_EXPR, void, void> Expr;
+    static const Expr make(const InputBus<bits> &bus) { return Expr(bus); }
+};
+
+template <int bits>
+class ExprTraits< Bus<bits> >
+{
+public:
+    enum { BITS = bits };
+    typedef Expression<bits, BUS_EXPR, void, void> Expr;
+    static const Expr make(const Bus<bits> &bus) { return Expr(bus); }
+};
+
+template <int bits>
+class ExprTraits< BitBuff<bits> >
+{
+public:
+    enum { BITS = bits };
+    typedef Expression<bits, BITBUFF_EXPR, void, void> Expr;
+    static const Expr make(const BitBuff<bits> &buf) { return Expr(buf); }
+};
+
+template <int bits, ExprType Type, typename LExprType, typename RExprType>
+class ExprTraits< Expression<bits, Type, LExprType, RExprType> >
+{
+public:
+    enum { BITS = bits };
+    typedef Expression<bits, Type, LExprType, RExprType> Expr;
+    static const Expr make(const Expr &e) { return e; }
+};
+
+template <>
+class ExprTraits<int>
+{
+public:
+    enum { BITS = 32 };
+    typedef Expression<32, CONST_EXPR, void, void> Expr;
+    static const Expr make(int value) { return Expr(static_cast<unsigned int>(value)); }
+};
+
+/// A class which gives the type of the expression resulting from the word level operation
+/// \p Type on the expressions of the types \p LExprType and \p RExprType. The result of
+/// an addition is one bit wider than the wider operand, that of a multiplication is as wide
+/// as both the operands put together, that of a shift is as wide as the shifted operand,
+/// and that of a comparison is a single bit.
+template <ExprType Type, typename LExprType, typename RExprType>
+class WordExpr
+{
+public:
+    enum
+    {
+        LBITS = static_cast<int>(ExprTraits<LExprType>::BITS),
+        RBITS = static_cast<int>(ExprTraits<RExprType>::BITS),
+        MAXBITS = (LBITS > RBITS ? LBITS : RBITS),
+        BITS = (Type == ADD_EXPR ? MAXBITS + 1 :
+                Type == SUBTRACT_EXPR ? MAXBITS :
+                Type == MULTIPLY_EXPR ? LBITS + RBITS :
+                (Type == SHIFT_LEFT_EXPR || Type == SHIFT_RIGHT_EXPR) ? LBITS : 1)
+    };
+
+    typedef Expression<BITS, Type, LExprType, RExprType> Expr;
+};
+
+/// Returns the expression which performs the word level operation \p Type on \p l and
+/// \p r. This function is used to implement the word level operators.
+template <ExprType Type, typename L, typename R>
+inline const typename WordExpr<Type, typename ExprTraits<L>::Expr, typename ExprTraits<R>::Expr>::Expr
+wordExpr(const L &l, const R &r)
+{
+    typedef typename WordExpr<
+                                Type,
+                                typename ExprTraits<L>::Expr,
+                                typename ExprTraits<R>::Expr
+                             >::Expr Expr;
+
+    return Expr(ExprTraits<L>::make(l), ExprTraits<R>::make(r));
+}
+
+/// Returns a \p bits wide constant expression whose value is the binary equivalent of
+/// \p value.
+template <int bits>
+inline const Expression<bits, CONST_EXPR, void, void> constant(unsigned int value)
+{
+    return Expression<bits, CONST_EXPR, void, void>(value);
+}
+
+/// Returns a single bit expression which is \p lcs::HIGH if the operands are equal as
+/// unsigned numbers. The operators \p == and \p != compare expressions immediately, and
+/// hence, this function should be used in continuous assignments.
+template <typename L, typename R>
+inline const typename WordExpr<EQUAL_EXPR, typename ExprTraits<L>::Expr, typename ExprTraits<R>::Expr>::Expr
+equalTo(const L &l, const R &r)
+{
+    return wordExpr<EQUAL_EXPR>(l, r);
+}
+
+/// Returns a single bit expression which is \p lcs::HIGH if the operands are not equal as
+/// unsigned numbers.
+template <typename L, typename R>
+inline const typename WordExpr<NOT_EQUAL_EXPR, typename ExprTraits<L>::Expr, typename ExprTraits<R>::Expr>::Expr
+notEqualTo(const L &l, const R &r)
+{
+    return wordExpr<NOT_EQUAL_EXPR>(l, r);
+}
+
+/// A class which gives the type of the conditional expression which selects between the
+/// expressions of the types \p AExprType and \p BExprType depending on an expression of
+/// the type \p CondExprType. The result is as wide as the wider branch.
+template <typename CondExprType, typename AExprType, typename BExprType>
+class ConditionalExpr
+{
+public:
+    enum
+    {
+        ABITS = static_cast<int>(ExprTraits<AExprType>::BITS),
+        BBITS = static_cast<int>(ExprTraits<BExprType>::BITS),
+        BITS = (ABITS > BBITS ? ABITS : BBITS)
+    };
+
+    typedef Expression<BITS, CONDITIONAL_EXPR, CondExprType,
+                       ExprChoice<AExprType, BExprType> > Expr;
+};
+
+/// Returns an expression which is \p a when the condition \p cond is \p lcs::HIGH, and
+/// \p b when it is \p lcs::LOW. Only the selected branch is evaluated. The operands can be
+/// busses, bit buffers, expressions or integers.
+template <typename C, typename A, typename B>
+inline const typename ConditionalExpr<
+                                        typename ExprTraits<C>::Expr,
+                                        typename ExprTraits<A>::Expr,
+                                        typename ExprTraits<B>::Expr
+                                     >::Expr
+select(const C &cond, const A &a, const B &b)
+{
+    typedef typename ConditionalExpr<
+                                       typename ExprTraits<C>::Expr,
+                                       typename ExprTraits<A>::Expr,
+                                       typename ExprTraits<B>::Expr
+                                    >::Expr Expr;
+
+    ExprChoice<typename ExprTraits<A>::Expr, typename ExprTraits<B>::Expr>
+        choice(ExprTraits<A>::make(a), ExprTraits<B>::make(b));
+
+    return Expr(ExprTraits<C>::make(cond), choice);
+}
+
+/// Returns a \p bits wide expression which selects one of the \p bits wide slices of
+/// \p data, depending on the value of \p sel. Slice k consists of the bits k*bits to
+/// k*bits+bits-1 of \p data. As the right operand of a concatenation takes the MSB
+/// locations, \p mux<8>(sel, (d0,d1,d2,d3)) selects \p d0 when \p sel is 0. Only the
+/// selected slice is evaluated.
+template <int bits, typename S, typename D>
+inline const Expression<bits, MUX_EXPR, typename ExprTraits<S>::Expr, typename ExprTraits<D>::Expr>
+mux(const S &sel, const D &data)
+{
+    return Expression<bits, MUX_EXPR, typename ExprTraits<S>::Expr, typename ExprTraits<D>::Expr>(
+                                                ExprTraits<S>::make(sel), ExprTraits<D>::make(data));
+}
+
+/// Returns a single bit expression which is the AND of all the bits of \p x. As the unary
+/// \p & operator cannot be used for this purpose, this function should be used instead.
+/// A concatenation of busses, for example \p andReduce((a,b)), reduces all the bits of the
+/// concatenated busses.
+template <typename T>
+inline const Expression<1, AND_REDUCE_EXPR, void, typename ExprTraits<T>::Expr> andReduce(const T &x)
+{
+    return Expression<1, AND_REDUCE_EXPR, void, typename ExprTraits<T>::Expr>(ExprTraits<T>::make(x));
+}
+
+/// Returns a single bit expression which is the OR of all the bits of \p x.
+///
+template <typename T>
+inline const Expression<1, OR_REDUCE_EXPR, void, typename ExprTraits<T>::Expr> orReduce(const T &x)
+{
+    return Expression<1, OR_REDUCE_EXPR, void, typename ExprTraits<T>::Expr>(ExprTraits<T>::make(x));
+}
+
+/// Returns a single bit expression which is the XOR of all the bits of \p x.
+///
+template <typename T>
+inline const Expression<1, XOR_REDUCE_EXPR, void, typename ExprTraits<T>::Expr> xorReduce(const T &x)
+{
+    return Expression<1, XOR_REDUCE_EXPR, void, typename ExprTraits<T>::Expr>(ExprTraits<T>::make(x));
+}
+
 // #####################################################################################
 // #####################################################################################
 
 } // End of namespace lcs
 
+/// An overloaded operator which returns an expression adding two busses, bit buffers,
+/// expressions or integers. The result is one bit wider than the wider operand.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::ADD_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator+(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::ADD_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns an expression subtracting \p r from \p l in two's
+/// complement. The result is as wide as the wider operand.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::SUBTRACT_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator-(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::SUBTRACT_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns an expression multiplying two operands. The result
+/// is as wide as the two operands put together.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::MULTIPLY_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator*(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::MULTIPLY_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns a single bit expression which is \p lcs::HIGH if
+/// \p l is less than \p r as unsigned numbers.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::LESS_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator<(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::LESS_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns a single bit expression which is \p lcs::HIGH if
+/// \p l is less than or equal to \p r as unsigned numbers.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::LESS_EQUAL_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator<=(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::LESS_EQUAL_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns a single bit expression which is \p lcs::HIGH if
+/// \p l is greater than \p r as unsigned numbers.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::GREATER_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator>(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::GREATER_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns a single bit expression which is \p lcs::HIGH if
+/// \p l is greater than or equal to \p r as unsigned numbers.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::GREATER_EQUAL_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator>=(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::GREATER_EQUAL_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns an expression shifting \p l left by the number of
+/// bits given by \p r. The result is as wide as \p l.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::SHIFT_LEFT_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator<<(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::SHIFT_LEFT_EXPR>(l, r);
+}
+
+/// An overloaded operator which returns an expression shifting \p l right (logically) by
+/// the number of bits given by \p r. The result is as wide as \p l.
+template <typename L, typename R>
+inline const typename lcs::WordExpr<
+                                      lcs::SHIFT_RIGHT_EXPR,
+                                      typename lcs::ExprTraits<L>::Expr,
+                                      typename lcs::ExprTraits<R>::Expr
+                                   >::Expr
+operator>>(const L &l, const R &r)
+{
+    return lcs::wordExpr<lcs::SHIFT_RIGHT_EXPR>(l, r);
+}
+
 ///
 ///
 template <int bits, lcs::ExprType InType, typename InLExprType, typename InRExprType>
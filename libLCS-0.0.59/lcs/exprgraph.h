@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_EXPR_GRAPH_H__
+#define __LCS_EXPR_GRAPH_H__
+
+#include "module.h"
+#include "exprtype.h"
+#include "linestate.h"
+#include <map>
+#include <vector>
+#include <utility>
+
+namespace lcs
+{ // Start of namespace lcs
+
+class Line;
+
+/// A class which maintains a single graph of bit level expression nodes shared by all the
+/// continuous assignments made while the expression graph mode is enabled. Identical
+/// subexpressions (the same operation on the same operands) are hash-consed into a single
+/// node, so that a subexpression which is used in many continuous assignments is evaluated
+/// only once per change of its operands. The graph registers itself on every leaf line
+/// exactly once. Nodes are created in a topological order (operands before the operations
+/// on them), and hence, evaluating the dirty nodes in the ascending order of their ids
+/// evaluates every node at most once per change.
+///
+/// Use \p lcs::Simulation::setExpressionGraphMode to enable the mode. A user of libLCS will,
+/// under normal circumstances, never need to use this class directly.
+class ExpressionGraph : public Module
+{
+public:
+
+    /// Enables or disables the expression graph mode. Continuous assignments made while
+    /// the mode is enabled are added to the graph.
+    static void setEnabled(bool enable) { enabled_ = enable; }
+
+    /// Returns \p true if the expression graph mode is enabled.
+    ///
+    static bool isEnabled(void) { return enabled_; }
+
+    /// Returns the id of the leaf node which corresponds to the net of the line \p line.
+    ///
+    static int leaf(const Line &line);
+
+    /// Returns the id of a node whose state is always \p lcs::UNKNOWN.
+    ///
+    static int unknown(void);
+
+    /// Returns the id of the node which is the one's complement of the node \p in.
+    ///
+    static int complement(int in);
+
+    /// Returns the id of the node which performs the bitwise operation \p type on the nodes
+    /// \p l and \p r. Returns -1 if the operation type is not supported by the graph.
+    static int binary(ExprType type, int l, int r);
+
+    /// Makes the node \p node drive the line \p line with the assignment delay \p delay.
+    /// The line is assigned the present state of the node immediately.
+    static void drive(int node, const Line &line, unsigned int delay);
+
+    /// Returns the number of nodes in the graph.
+    ///
+    static int size(void);
+
+    /// Removes the nodes added after the graph had \p size nodes (see
+    /// \p lcs::ExpressionGraph::size). None of these nodes should drive a line.
+    static void truncate(int size);
+
+    /// Destroys the graph and de-registers it from all the leaf lines.
+    ///
+    static void destroy(void);
+
+    /// The function through which the leaf lines notify the graph of their state changes.
+    /// The port id is one more than the index of the leaf in the list of registered leaves,
+    /// or \p lcs::ANY_PORT if several leaves changed together.
+    virtual void onStateChange(int portId);
+
+private:
+
+    ExpressionGraph(void);
+
+    virtual ~ExpressionGraph();
+
+    static ExpressionGraph* instance(void);
+
+    int addNode(int type, int l, int r, LineState value);
+
+    void makeLive(int node);
+
+    void evaluate(int node);
+
+    void updateLeaf(int index);
+
+    void propagate(void);
+
+    static ExpressionGraph *graph_;
+
+    static bool enabled_;
+
+    std::map< std::pair<int, std::pair<int, int> >, int > nodeIndex_;
+    std::map<const void*, int> leafIndex_;
+
+    std::vector<int> type_, left_, right_;
+    std::vector<LineState> value_;
+    std::vector<bool> live_, dirty_;
+    std::vector< std::vector<int> > fanout_;
+    std::vector< std::vector<Line*> > sinks_;
+    std::vector< std::vector<unsigned int> > sinkDelays_;
+
+    std::vector<Line*> leafLines_;
+    std::vector<int> leafNodes_;
+    std::vector<int> heap_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_EXPR_GRAPH_H__
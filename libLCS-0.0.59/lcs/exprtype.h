@@ -56,6 +56,88 @@ enum ExprType
     /// Indicates an expression which consists of a single bit buffer.
     ///
     BITBUFF_EXPR           = 3077,
+
+    /// Indicates an expression which is an addition. The result is one bit wider than
+    /// the wider of the operands.
+    ADD_EXPR               = 3078,
+
+    /// Indicates an expression which is a two's complement subtraction. The result is as
+    /// wide as the wider of the operands.
+    SUBTRACT_EXPR          = 3079,
+
+    /// Indicates an expression which is a multiplication. The result is as wide as the
+    /// sum of the widths of the operands.
+    MULTIPLY_EXPR          = 3080,
+
+    /// Indicates an expression which is an equality comparison.
+    ///
+    EQUAL_EXPR             = 3081,
+
+    /// Indicates an expression which is an inequality comparison.
+    ///
+    NOT_EQUAL_EXPR         = 3082,
+
+    /// Indicates an expression which is a less-than comparison.
+    ///
+    LESS_EXPR              = 3083,
+
+    /// Indicates an expression which is a less-than-or-equal-to comparison.
+    ///
+    LESS_EQUAL_EXPR        = 3084,
+
+    /// Indicates an expression which is a greater-than comparison.
+    ///
+    GREATER_EXPR           = 3085,
+
+    /// Indicates an expression which is a greater-than-or-equal-to comparison.
+    ///
+    GREATER_EQUAL_EXPR     = 3086,
+
+    /// Indicates an expression which is a logical left shift.
+    ///
+    SHIFT_LEFT_EXPR        = 3087,
+
+    /// Indicates an expression which is a logical right shift.
+    ///
+    SHIFT_RIGHT_EXPR       = 3088,
+
+    /// Indicates an expression which is an AND reduction of all the bits of its operand.
+    ///
+    AND_REDUCE_EXPR        = 3089,
+
+    /// Indicates an expression which is an OR reduction of all the bits of its operand.
+    ///
+    OR_REDUCE_EXPR         = 3090,
+
+    /// Indicates an expression which is an XOR reduction of all the bits of its operand.
+    ///
+    XOR_REDUCE_EXPR        = 3091,
+
+    /// Indicates an expression which is a constant.
+    ///
+    CONST_EXPR             = 3092,
+
+    /// Indicates an expression which selects one of two expressions depending on the
+    /// state of a condition expression.
+    CONDITIONAL_EXPR       = 3093,
+
+    /// Indicates an expression which selects one of the equally wide slices of a data
+    /// expression depending on the value of a select expression.
+    MUX_EXPR               = 3094
+};
+
+/// An enumeration of the kinds of sensitivity which a continuous assignment can have to the
+/// nets used in its expression. See \p lcs::Bus::cass.
+enum Sensitivity
+{
+    /// The continuous assignment is re-evaluated when any of the nets used in its expression
+    /// changes.
+    STATIC_SENSITIVITY     = 0,
+
+    /// The continuous assignment ignores the changes on the nets which are used only in the
+    /// branches which are not selected by the conditional and mux expressions. The
+    /// sensitivity is updated every time a condition or a select changes.
+    DYNAMIC_SENSITIVITY    = 1
 };
 
 } // End of namespace lcs.
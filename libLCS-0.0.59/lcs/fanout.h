@@ -78,7 +78,7 @@ void FanOut<n, delay>::onStateChange(int portId)
 {
     for (unsigned int i = 0; i < n; i++)
     {
-        output[i] = (delay, input[0]);
+        output.template set<delay>(i, input.get(0));
     }
 }
 
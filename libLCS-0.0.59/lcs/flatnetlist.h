@@ -0,0 +1,278 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_FLAT_NETLIST_H__
+#define __LCS_FLAT_NETLIST_H__
+
+#include "celltype.h"
+#include "circuit.h"
+#include "linestate.h"
+#include "mappedfile.h"
+#include "netlist_exception.h"
+#include "portdir.h"
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects are the flattened, compact representations of circuits defined
+/// using \p lcs::Circuit. Flattening (or elaboration) replaces every circuit instance by
+/// the cells of its definition, so that a flat netlist is made up of only nets and
+/// primitive cells, each identified by an integer index. The connectivity is stored in
+/// flat arrays in the compressed sparse row form: the inputs of all the cells in one
+/// array indexed by per cell offsets, and the cells driven by all the nets (the fanout)
+/// in another array indexed by per net offsets.
+///
+/// The cells are numbered in the topological order of the zero delay combinational logic:
+/// a combinational cell with zero delay is numbered before every cell it drives. Hence,
+/// evaluating the pending cells in the increasing order of their indices evaluates every
+/// cell at most once per change of the primary inputs (see \p lcs::NetlistSimulator).
+/// Cells on zero delay combinational loops are numbered after all the others.
+///
+/// The named nets of the flattened circuit carry their hierarchical names, made of the
+/// names of the instances enclosing them and the net name separated by '.'. The bits of
+/// a multi-bit net are named with the bit index in square brackets. For example, bit 1
+/// of the net \p s of the instance \p u0 in the top circuit is named "u0.s[1]". A net
+/// which connects to a port of an instance carries the name it has in the outermost
+/// circuit.
+///
+/// The flat netlist is immutable once built, and can be shared by any number of
+/// \p lcs::NetlistSimulator objects. As all of its data is held in flat arrays, a flat
+/// netlist can be saved to a binary file (see \p lcs::FlatNetlist::save) and mapped back
+/// into memory without any parsing (see \p lcs::FlatNetlist::map). The arrays of a mapped
+/// netlist are used in place. \p lcs::NetlistReader::load uses this to cache the
+/// netlists read from text files.
+class FlatNetlist
+{
+public:
+
+    /// Constructor. Flattens the circuit \p top. A \p lcs::NetlistException is thrown if a
+    /// net is driven by more than one cell, or if a circuit instantiates itself directly
+    /// or indirectly.
+    ///
+    /// \param top The definition of the circuit to be flattened.
+    FlatNetlist(const Circuit &top) throw (NetlistException);
+
+    /// Destructor. Unmaps the file of a mapped netlist.
+    ///
+    ~FlatNetlist();
+
+    /// Maps the flat netlist saved in the file \p fileName. Returns \p NULL if the file
+    /// does not exist, was not saved with the key \p key, was saved by an incompatible
+    /// version of libLCS or on a platform with a different byte order, or is corrupt. The
+    /// returned netlist should be deleted by the caller.
+    ///
+    /// \param fileName The name of the file to which the netlist was saved.
+    /// \param key The key with which the netlist was saved.
+    static FlatNetlist* map(const std::string &fileName, unsigned long long key = 0);
+
+    /// Saves the netlist to the file \p fileName in a binary format which can be mapped
+    /// back using \p lcs::FlatNetlist::map. The netlist is written to a temporary file in
+    /// the same directory, which then replaces the file; the netlists mapped from the file
+    /// before are hence not affected. A \p lcs::NetlistException is thrown if the file
+    /// cannot be written.
+    ///
+    /// \param fileName The name of the file to which the netlist is to be saved.
+    /// \param key A key (for example, a hash of the source of the netlist) which should
+    /// be passed to \p lcs::FlatNetlist::map to map the netlist back.
+    void save(const std::string &fileName, unsigned long long key = 0) const
+              throw (NetlistException);
+
+    /// Returns the number of nets.
+    ///
+    int getNetCount(void) const { return arrays_.nets; }
+
+    /// Returns the number of cells.
+    ///
+    int getCellCount(void) const { return arrays_.cells; }
+
+    /// Returns the type of the cell at index \p cell.
+    ///
+    CellType getCellType(int cell) const { return static_cast<CellType>(arrays_.cellType[cell]); }
+
+    /// Returns the propogation delay of the cell at index \p cell.
+    ///
+    unsigned int getCellDelay(int cell) const { return arrays_.cellDelay[cell]; }
+
+    /// Returns the number of inputs of the cell at index \p cell.
+    ///
+    int getCellInputCount(int cell) const
+    {
+        return arrays_.cellInputOffset[cell+1] - arrays_.cellInputOffset[cell];
+    }
+
+    /// Returns the id of the net connected to input \p i of the cell at index \p cell.
+    ///
+    int getCellInput(int cell, int i) const
+    {
+        return arrays_.cellInputs[arrays_.cellInputOffset[cell] + i];
+    }
+
+    /// Returns the id of the net driven by the cell at index \p cell.
+    ///
+    int getCellOutput(int cell) const { return arrays_.cellOutput[cell]; }
+
+    /// Returns the number of cells to which the net \p net is an input. A cell which has
+    /// the net at more than one of its inputs is counted once.
+    int getFanoutCount(int net) const
+    {
+        return arrays_.fanoutOffset[net+1] - arrays_.fanoutOffset[net];
+    }
+
+    /// Returns the index of the cell \p i of the fanout of the net \p net.
+    ///
+    int getFanout(int net, int i) const { return arrays_.fanout[arrays_.fanoutOffset[net] + i]; }
+
+    /// Returns the index of the cell which drives the net \p net, or -1 if the net is not
+    /// driven by a cell.
+    int getDriver(int net) const { return arrays_.driver[net]; }
+
+    /// Returns the state of the net \p net at the start of the simulation. The constant
+    /// nets start with their constant states, and the others with \p lcs::UNKNOWN.
+    LineState getInitialState(int net) const
+    {
+        return static_cast<LineState>(arrays_.initial[net]);
+    }
+
+    /// Returns the hierarchical name of the net \p net, or an empty string if the net is
+    /// not named.
+    std::string getNetName(int net) const;
+
+    /// Returns the id of the net with the hierarchical name \p name, or -1 if there is no
+    /// such net.
+    int findNet(const std::string &name) const;
+
+    /// Returns the number of ports of the flattened circuit.
+    ///
+    int getPortCount(void) const { return static_cast<int>(portName_.size()); }
+
+    /// Returns the index of the port \p name, or -1 if there is no such port.
+    ///
+    int findPort(const std::string &name) const;
+
+    /// Returns the name of the port at index \p port.
+    ///
+    const std::string& getPortName(int port) const { return portName_[port]; }
+
+    /// Returns the direction of the port at index \p port.
+    ///
+    PortDirection getPortDirection(int port) const { return static_cast<PortDirection>(portDir_[port]); }
+
+    /// Returns the id of the net of bit 0 of the port at index \p port. The nets of the
+    /// other bits follow consecutively.
+    int getPortNet(int port) const { return portNet_[port]; }
+
+    /// Returns the width of the port at index \p port.
+    ///
+    int getPortWidth(int port) const { return portWidth_[port]; }
+
+    /// Finds the zero delay combinational loops of the netlist. The loops are the strongly
+    /// connected components of the graph of the combinational cells with zero delay, in
+    /// which a cell is joined to every such cell it drives; a single cell is a loop only if
+    /// it drives one of its own inputs. The loops are returned in \p loops, each as the
+    /// sorted ids of the nets driven by its cells, and their number is returned. A loop
+    /// which oscillates keeps an \p lcs::NetlistSimulator from settling (see
+    /// \p lcs::Simulation::setDeltaLimit).
+    ///
+    /// \param loops The vector to which the loops are written. Its previous contents are
+    /// discarded.
+    int findCombinationalLoops(std::vector< std::vector<int> > &loops) const;
+
+private:
+
+    /// The flat arrays which hold the netlist. They point either into the vectors below,
+    /// or into a mapped file.
+    struct Arrays
+    {
+        int nets, cells, namedNets;
+        const int *initial;
+        const int *cellType;
+        const unsigned int *cellDelay;
+        const int *cellInputOffset;
+        const int *cellInputs;
+        const int *cellOutput;
+        const int *fanoutOffset;
+        const int *fanout;
+        const int *driver;
+        const int *nameOffset;
+        const char *names;
+        const int *sortedNames;
+    };
+
+    friend class NetlistOptimizer;
+
+    /// Constructs an empty netlist which is filled by \p lcs::FlatNetlist::map, or by
+    /// \p lcs::NetlistOptimizer (in which case \p file is \p NULL).
+    FlatNetlist(MappedFile *file);
+
+    /// Copying a flat netlist is not allowed.
+    ///
+    FlatNetlist(const FlatNetlist &netlist);
+
+    /// Assigning a flat netlist is not allowed.
+    ///
+    FlatNetlist& operator=(const FlatNetlist &netlist);
+
+    void flatten(const Circuit &def, std::vector<int> &netMap, const std::string &prefix,
+                 std::vector<const Circuit*> &stack) throw (NetlistException);
+
+    void setNetName(int net, const std::string &name);
+
+    void order(void);
+
+    void index(void) throw (NetlistException);
+
+    void bind(void);
+
+    /// Returns \p true if the offsets of the arrays of the netlist are in order, and the
+    /// net, cell and name ids held in them are within their ranges, so that a netlist
+    /// mapped from a corrupt file is not used. \p inputs, \p fanout and \p names are the
+    /// sizes of the arrays of the cell inputs and the fanout, and of the pool of the names.
+    bool isConsistent(int inputs, int fanout, int names) const;
+
+    Arrays arrays_;
+    MappedFile *file_;
+
+    std::vector<int> initial_;
+    std::vector<int> cellType_;
+    std::vector<unsigned int> cellDelay_;
+    std::vector<int> cellInputOffset_;
+    std::vector<int> cellInputs_;
+    std::vector<int> cellOutput_;
+    std::vector<int> fanoutOffset_;
+    std::vector<int> fanout_;
+    std::vector<int> driver_;
+    std::vector<int> nameOffset_;
+    std::vector<char> names_;
+    std::vector<int> sortedNames_;
+    std::vector<std::string> portName_;
+    std::vector<int> portDir_;
+    std::vector<int> portNet_;
+    std::vector<int> portWidth_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_FLAT_NETLIST_H__
@@ -80,7 +80,7 @@ void FrequencyDivider<factor, delay>::onPosEdge(int portId)
     else
     {
         edgeCount_ = 1;
-        output_[0] = (delay, ~output_[0]);
+        output_.set<delay>(0, (~output_)[0]);
     }
 }
 
@@ -92,7 +92,7 @@ void FrequencyDivider<factor, delay>::onNegEdge(int portId)
     else
     {
         edgeCount_ = 1;
-        output_[0] = (delay, ~output_[0]);
+        output_.set<delay>(0, (~output_)[0]);
     }
 }
 
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_GATE_EVAL_H__
+#define __LCS_GATE_EVAL_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the manners in which an \p lcs::DynGate (and hence, a gate module
+/// like \p lcs::And) can evaluate its output.
+enum GateEvaluation
+{
+
+    /// On every change of its inputs, the gate reads all of its input lines, one at a
+    /// time, into its bit planes and counts its \p lcs::HIGH and unknown inputs again. The
+    /// work per change grows with the number of inputs, but no memory is needed beyond the
+    /// bit planes. This suits the gates with a few inputs.
+    FULL_GATE_EVALUATION        = 9216,
+
+    /// The gate is notified of the changes on every input separately, and keeps count of
+    /// its inputs which are in the \p lcs::HIGH state and in the unknown states. A change
+    /// on one input updates the counts and the output in constant time, irrespective of
+    /// the number of inputs. This suits the gates with many inputs, and the arrays of
+    /// inverters and buffers, at the cost of a record of the input nets per gate.
+    INCREMENTAL_GATE_EVALUATION = 9217,
+
+    /// The gate chooses \p lcs::INCREMENTAL_GATE_EVALUATION if it has more than eight
+    /// inputs, and \p lcs::FULL_GATE_EVALUATION otherwise. This is the default.
+    AUTOMATIC_GATE_EVALUATION   = 9218
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_GATE_EVAL_H__
@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_GATE_TYPE_H__
+#define __LCS_GATE_TYPE_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the logic functions of the gates which can be built at run time
+/// using \p lcs::DynGate. The functions are the same as those of the corresponding gate
+/// modules, like \p lcs::And; in particular, \p lcs::UNKNOWN and \p lcs::HIGH_IMPEDENCE
+/// inputs are treated as \p lcs::LOW.
+enum GateType
+{
+
+    /// An AND gate, as \p lcs::And.
+    ///
+    AND_GATE    = 8192,
+
+    /// An OR gate, as \p lcs::Or.
+    ///
+    OR_GATE     = 8193,
+
+    /// A NAND gate, as \p lcs::Nand.
+    ///
+    NAND_GATE   = 8194,
+
+    /// A NOR gate, as \p lcs::Nor.
+    ///
+    NOR_GATE    = 8195,
+
+    /// An XOR gate, as \p lcs::Xor. The output is \p lcs::HIGH if exactly one input is
+    /// \p lcs::HIGH.
+    XOR_GATE    = 8196,
+
+    /// A set of inverters, one for every line of the input bus, as \p lcs::Not.
+    ///
+    NOT_GATE    = 8197,
+
+    /// A set of buffers, one for every line of the input bus, as \p lcs::Buffer.
+    ///
+    BUFFER_GATE = 8198
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_GATE_TYPE_H__
@@ -25,30 +25,64 @@
 #ifndef __HIDDEN_MODULE_MANAGER_H__
 #define __HIDDEN_MODULE_MANAGER_H__
 
-#include "list.h"
+#include <cstddef>
+#include <vector>
 
 namespace lcs
 { // Start of namespace lcs
 
+class Line;
 class Module;
 
 /// A class which provides static member functions to help manage modules which are
-/// hidden from libLCS users.
+/// hidden from libLCS users. The hidden modules are allocated from an arena which is
+/// released in one shot when the modules are destroyed at the end of a simulation, so that
+/// building and tearing down many designs in a process does not churn the heap. When the
+/// modules are destroyed, they are also de-registered from the lines driving them in bulk:
+/// every line is swept once for all the hidden modules, instead of once for every module
+/// registered with it.
 class HiddenModuleManager
 {
 public:
 
-    /// Registers a hidden module. It does not do anything more than storing a pointer to
-    /// the module object in a list.
-    static void registerModule(Module *mod) { modList.append(mod); }
+    /// Returns memory for a hidden module of \p size bytes from the arena. A module
+    /// constructed in the memory (using placement new) should be registered through
+    /// \p lcs::HiddenModuleManager::registerModule with \p inArena set to \p true.
+    static void* allocate(std::size_t size);
 
-    /// Destroys all the hidden modules registered.
+    /// Registers a hidden module, which is destroyed by
+    /// \p lcs::HiddenModuleManager::destroyModules.
+    ///
+    /// \param mod The module to be registered.
+    /// \param inArena \p true if the module was constructed in memory returned by
+    /// \p lcs::HiddenModuleManager::allocate; \p false if it was allocated with \p new.
+    static void registerModule(Module *mod, bool inArena = false);
+
+    /// Destroys all the hidden modules registered, and releases the arena.
     ///
     static void destroyModules(void);
 
+    /// Returns \p true while the hidden modules are being destroyed.
+    ///
+    static bool isDestroying(void) { return destroying; }
+
+    /// A hidden module being destroyed hands over, through this function, the copies of
+    /// the lines it is registered with, instead of de-registering from them. The lines are
+    /// swept and deleted after all the hidden modules have been destroyed.
+    static void detachLine(Line *line);
+
 private:
 
-    static List<Module*> modList;
+    static std::vector<Module*> arenaMods, heapMods;
+
+    static std::vector<Line*> detached;
+
+    static std::vector<char*> chunks;
+
+    // The number of bytes used in the last chunk.
+    static std::size_t used;
+
+    static bool destroying;
 };
 
 } // End of namespace lcs
@@ -26,6 +26,7 @@
 #define __LCS_INPUT_BUS_H__
 
 #include "expression.h"
+#include "busview.h"
 #include "array1d.h"
 #include "dataptr.h"
 #include "module.h"
@@ -33,6 +34,8 @@
 #include "list.h"
 #include "outofrange_exception.h"
 #include <fstream>
+#include <sstream>
+#include <string>
 
 namespace lcs
 { // Start of namespace lcs
@@ -60,6 +63,15 @@ friend class InputBus;
 template <int w>
 friend class Bus;
 
+/// \p lcs::DynBus is a friend of this class.
+///
+friend class DynBus;
+
+/// \p lcs::BusView classes of all sizes are friends of this class.
+///
+template <int w>
+friend class BusView;
+
 public:
 
     /// The default constructor.
@@ -81,6 +93,12 @@ public:
     /// \param line The line object which is encapsulated in the resultant bus object.
     InputBus(const Line &line) throw(OutOfRangeException<int>);
 
+    /// Creates a bus which shares the lines of the view \p view. A view can hence be
+    /// passed wherever an \p InputBus is expected.
+    ///
+    /// \param view The view whose lines are used to create the new \p InputBus object.
+    InputBus(const BusView<bits> &view);
+
     /// Destructor.
     ///
     virtual ~InputBus();
@@ -108,7 +126,10 @@ public:
     /// occurance of a positive edge on the line.
     ///
     /// \param portId The id of the module port to which the bus is connected. The bus will
-    /// use this id while notifying the module.
+    /// use this id while notifying the module. If the event occurs on the lines
+    /// registered with more than one port id of the module in the same write group (see
+    /// \p lcs::WriteGroup) or delta cycle, the module is notified once, with the port id
+    /// \p lcs::ANY_PORT instead.
     ///
     /// \param line The index of the bus line whose line events the module seeks to be
     /// notified of. The default value is -1. In general, a negetive value indicates that
@@ -137,6 +158,28 @@ public:
     void stopNotification(Module *mod, const LineEvent &event, const int &portId,
                           const int &line = -1) throw(OutOfRangeException<int>);
 
+    /// Sets the name with which the lines of the bus are referred to in the diagnostics of
+    /// the simulation, for example in an \p lcs::OscillationException. The line at index
+    /// \p i is named \p name[i]; the line of a single-line bus is named \p name. The names
+    /// are shared by all the busses which share the lines. An \p lcs::ChangeMonitor names
+    /// the bus it monitors with its own name.
+    ///
+    /// \param name The name of the bus.
+    void setName(const std::string &name) const;
+
+    /// Registers the module \p mod to be notified of the state changes of the lines of the
+    /// bus with the changes themselves: the module is notified through
+    /// \p lcs::Module::onBitsChange, and is passed the index of every line which changed
+    /// and its state before the change. A module can use them to update only the part of
+    /// its state which depends on the lines which changed, instead of reading all its
+    /// inputs again. A line which is at more than one index of the bus is reported at each
+    /// of them. The registration is removed through \p lcs::InputBus::stopNotification
+    /// with the event \p lcs::LINE_STATE_CHANGE.
+    ///
+    /// \param mod Pointer to the module which has to be notified.
+    /// \param portId The id of the module port to which the bus is connected.
+    void notifyBits(Module *mod, const int &portId);
+
     /// Converts the binary bit value in the bus lines to a decimal integer.
     ///
     unsigned long toInt() const;
@@ -187,6 +230,16 @@ public:
     template <int w>
     const InputBus<w> partSelect(int s) const;
 
+    /// Returns a view of all the lines of the bus. See \p lcs::BusView.
+    ///
+    const BusView<bits> view(void) const;
+
+    /// Returns a view of the \p w lines of the bus starting at index \p s. Unlike
+    /// \p lcs::InputBus::partSelect, the lines are not copied. An
+    /// \p lcs::OutOfRangeException is thrown if the lines are not all within the bus width.
+    template <int w>
+    const BusView<w> slice(int s) const throw (OutOfRangeException<int>);
+
 };
 
 template <int bits>
@@ -211,6 +264,14 @@ InputBus<bits>::InputBus(const Line &l) throw(OutOfRangeException<int>)
     data[0] = l;
 }
 
+template <int bits>
+InputBus<bits>::InputBus(const BusView<bits> &view) : Array1D<Line, bits>()
+{
+    Line *data = Array1D<Line, bits>::dataPtr->data;
+    for (int i = 0; i < bits; i++)
+        data[i] = *view.lines_[i];
+}
+
 template <int bits>
 InputBus<bits>::~InputBus() { }
 
@@ -241,6 +302,37 @@ void InputBus<bits>::notify(Module *mod, const LineEvent &event, const int &port
     }
 }
 
+template <int bits>
+void InputBus<bits>::setName(const std::string &name) const
+{
+    Line *data = Array1D<Line, bits>::dataPtr->data;
+
+    if (bits == 1)
+    {
+        data[0].setName(name);
+        return;
+    }
+
+    for (int i = 0; i < bits; i++)
+    {
+        std::ostringstream ss;
+        ss << name << '[' << i << ']';
+        data[i].setName(ss.str());
+    }
+}
+
+template <int bits>
+void InputBus<bits>::notifyBits(Module *mod, const int &portId)
+{
+    Line *data = Array1D<Line, bits>::dataPtr->data;
+
+    for (int i = 0; i < bits; i++)
+    {
+        Line dataline = data[i];
+        dataline.notify(LINE_STATE_CHANGE, mod, portId, i);
+    }
+}
+
 template <int bits>
 void InputBus<bits>::stopNotification(Module *mod, const LineEvent &event, const int &portId,
                                       const int &line) throw(OutOfRangeException<int>)
@@ -286,6 +378,34 @@ const InputBus<w> InputBus<bits>::partSelect(int s) const
     return b;
 }
 
+template <int bits>
+const BusView<bits> InputBus<bits>::view(void) const
+{
+    BusView<bits> v;
+
+    Line *data = Array1D<Line, bits>::dataPtr->data;
+    for (int i = 0; i < bits; i++)
+        v.lines_[i] = data + i;
+
+    return v;
+}
+
+template <int bits>
+template <int w>
+const BusView<w> InputBus<bits>::slice(int s) const throw (OutOfRangeException<int>)
+{
+    if (s < 0 || s + w > bits)
+        throw OutOfRangeException<int>(0, bits-w, s);
+
+    BusView<w> v;
+
+    Line *data = Array1D<Line, bits>::dataPtr->data;
+    for (int i = 0; i < w; i++)
+        v.lines_[i] = data + s + i;
+
+    return v;
+}
+
 template <int bits>
 unsigned long InputBus<bits>::toInt(void) const
 {
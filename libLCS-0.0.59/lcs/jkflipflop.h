@@ -139,11 +139,11 @@ void JKFlipFlop<type, delay>::trigger(void)
         if (j[0] == LOW && k[0] == LOW)
             ; // Leave the output state the same as before.
         else if (j[0] == HIGH && k[0] == HIGH)
-            q[0] = (delay, ~q[0]);
+            q.set<delay>(0, (~q)[0]);
         else if (j[0] == LOW && k[0] == HIGH)
-            q[0] = (delay, LOW);
+            q.set<delay>(0, LOW);
         else if (j[0] == HIGH && k[0] == LOW)
-            q[0] = (delay, HIGH);
+            q.set<delay>(0, HIGH);
     }
 
     return;
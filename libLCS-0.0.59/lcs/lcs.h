@@ -33,19 +33,33 @@
 #include "buffer.h"
 #include "bus.h"
 #include "changeMonitor.h"
+#include "circuit.h"
+#include "circuitlib.h"
 #include "clock.h"
 #include "counter.h"
+#include "datapath.h"
 #include "dflipflop.h"
+#include "dynbus.h"
+#include "dyngate.h"
 #include "fa.h"
 #include "fanout.h"
+#include "flatnetlist.h"
 #include "freqdiv.h"
 #include "inoutbus.h"
 #include "jkflipflop.h"
+#include "lut.h"
+#include "memory.h"
+#include "netopt.h"
+#include "netreader.h"
+#include "netsim.h"
 #include "nand.h"
 #include "nor.h"
 #include "not.h"
 #include "or.h"
 #include "register.h"
+#include "regbank.h"
+#include "writegroup.h"
+#include "nonblocking.h"
 #include "xor.h"
 #include "shiftreg.h"
 #include "simul.h"
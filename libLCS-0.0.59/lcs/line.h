@@ -34,10 +34,14 @@
 #include "queue.h"
 #include "tickListener.h"
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace lcs
 { // Start of namespace lcs
 
+class NotificationBatch;
+
 template <int bits, ExprType Type, typename LExprType, typename RExprType>
 class Expression;
 
@@ -67,6 +71,14 @@ friend class InputBus;
 ///
 friend class Clock;
 
+friend class BitDependencyMap;
+
+friend class ExpressionGraph;
+
+friend class DynBus;
+
+friend class HiddenModuleManager;
+
 public:
 
     /// Default constructor.
@@ -135,14 +147,17 @@ public:
 
     /// This function is used by the system time keeper to notify the line to let it
     /// update it's state after a certain delay. Under normal circumstances, a user of
-    /// libLCS will never require to call this function.
-    void update(void);
+    /// libLCS will never require to call this function. If \p batch is not \p NULL, the
+    /// modules driven by the line are not notified right away; the notifications are added
+    /// to \p batch instead.
+    void update(NotificationBatch *batch = NULL);
 
     // This function is called by the class SysmtemTimer. When a call is made, this function
     // updates the line state with the new value. This function is relevant only if the line
     // is a zero delay line. The documentation is not done in the doxygen format as I
-    // would not like to let it show up the API reference.
-    void hiddenUpdate(void);
+    // would not like to let it show up the API reference. As with update, the notifications
+    // are collected in batch if it is not NULL.
+    void hiddenUpdate(NotificationBatch *batch = NULL);
 
 private:
 
@@ -160,7 +175,11 @@ private:
     /// \param event The event of whose occurance the module should be notified of.
     /// \param mod Pointer to the \p lcs::Module object which has to be driven by the line.
     /// \param portId The id of the module port to which the line is connected.
-    void notify(const LineEvent &event, Module *mod, const int &portId);
+    /// \param bit The index of the line in the bus connected to the port, if the module is
+    /// to be told which lines changed (see \p lcs::InputBus::notifyBits), or -1. Only the
+    /// \p lcs::LINE_STATE_CHANGE event can be registered with an index. A module can be
+    /// registered with the same line for more than one index.
+    void notify(const LineEvent &event, Module *mod, const int &portId, int bit = -1);
 
     /// A lcs::Module (or its derivative) can de-register itself from being driven by the
     /// line using this function. See \p lcs::Line::notify for more information. As with
@@ -175,19 +194,60 @@ private:
     void stopNotification(const LineEvent& event, Module *mod, const int &portId);
 
     /// This is an internal function used by other functions of this class. As it is declared
-    /// as private, a user of libLCS will never require to use this function.
-    void setLineValue(const LineState &value);
+    /// as private, a user of libLCS will never require to use this function. If \p batch is
+    /// not \p NULL, the notifications due to the change are added to \p batch instead of
+    /// being delivered right away.
+    void setLineValue(const LineState &value, NotificationBatch *batch = NULL);
+
+    /// Removes the entry of the module \p mod, registered with the port id \p portId, from
+    /// a pair of parallel module and port id lists. Returns the position of the entry which
+    /// was removed, or -1 if there was none.
+    static int removeModule(List<Module*> &modList, List<int> &idList, Module *mod, int portId);
+
+    /// Removes all the entries of the modules \p mods, which should be sorted, from the
+    /// line, in a single pass over each of its lists.
+    void removeModules(const std::vector<Module*> &mods);
+
+    /// Removes the entries of the modules \p mods, which should be sorted, from a pair of
+    /// parallel module and port id lists, and from \p bitList if it is not \p NULL.
+    static void removeModules(List<Module*> &modList, List<int> &idList, List<int> *bitList,
+                              const std::vector<Module*> &mods);
 
     /// Sets the assignement delay for the line.
     ///
     void setAssDelay(unsigned int delay);
 
+    /// Assigns \p value to the line with the delay \p delay. This is the same as a call
+    /// to \p lcs::Line::setAssDelay followed by an assignment, but the delay is tested only
+    /// once; when \p delay is a constant, as with the delay template parameters of the
+    /// modules, the test is resolved at compile time.
+    void assign(const LineState &value, unsigned int delay)
+    {
+        if (delay == 0)
+            assignNow(value);
+        else
+            assignLater(value, delay);
+    }
+
+    /// Makes a zero delay assignment of \p value to the line.
+    ///
+    void assignNow(const LineState &value);
+
+    /// Schedules the change of the line to \p value after the nonzero delay \p delay.
+    ///
+    void assignLater(const LineState &value, unsigned int delay);
+
+    /// Sets the name with which the line is referred to in diagnostics. The name is shared
+    /// by all the copies of the line. See \p lcs::InputBus::setName.
+    void setName(const std::string &name);
+
     LineState *val;
     int *refCount;
     unsigned int *delay_;
     List< Line* > *refList;
     List< Module* > changeModList, posEdgeList, negEdgeList;
     List< int > changeModIdList, posEdgeIdList, negEdgeIdList;
+    List< int > changeModBitList;
     PriorityQueue<unsigned int, ASCENDING> nextChangeTimeQueue;
     Queue<unsigned int> zeroDelayChangeTimeQueue;
     PriorityQueue<LineState, ASCENDING> valueQueue;
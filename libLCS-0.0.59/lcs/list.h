@@ -186,6 +186,16 @@ public:
     ///
     void removeFirstMatch(T e);
 
+    /// Removes a list element equal to the function argument \p e. The list is searched
+    /// from both of its ends at once, which is faster than \p removeFirstMatch when the
+    /// element is close to either end. If more than one element is equal to \p e, which
+    /// one is removed is not specified.
+    void removeMatch(T e);
+
+    /// Removes the list element at the position \p index. The first element of the list
+    /// is at position 0. Does nothing if the index is out of range.
+    void removeAt(int index);
+
     /// Destroys the list.
     ///
     void destroy(void);
@@ -421,6 +431,65 @@ void List<T>::removeFirstMatch(T e)
     }
 }
 
+template <class T>
+void List<T>::removeMatch(T e)
+{
+    ListNode<T> *front = dataPtr->node, *back = lastNodeDataPtr->node, *node = NULL;
+    while (front != NULL)
+    {
+        if (front->data == e)
+            node = front;
+        else if (back->data == e)
+            node = back;
+
+        if (node != NULL || front == back || front->nextNodePtr == back)
+            break;
+
+        front = front->nextNodePtr;
+        back = back->previousNodePtr;
+    }
+
+    if (node == NULL)
+        return;
+
+    if (node->previousNodePtr == NULL)
+        dataPtr->node = node->nextNodePtr;
+    else
+        node->previousNodePtr->nextNodePtr = node->nextNodePtr;
+
+    if (node->nextNodePtr == NULL)
+        lastNodeDataPtr->node = node->previousNodePtr;
+    else
+        node->nextNodePtr->previousNodePtr = node->previousNodePtr;
+
+    delete node;
+    (*size)--;
+}
+
+template <class T>
+void List<T>::removeAt(int index)
+{
+    ListNode<T> *node = dataPtr->node;
+    for (int i = 0; i < index && node != NULL; i++)
+        node = node->nextNodePtr;
+
+    if (index < 0 || node == NULL)
+        return;
+
+    if (node->previousNodePtr == NULL)
+        dataPtr->node = node->nextNodePtr;
+    else
+        node->previousNodePtr->nextNodePtr = node->nextNodePtr;
+
+    if (node->nextNodePtr == NULL)
+        lastNodeDataPtr->node = node->previousNodePtr;
+    else
+        node->nextNodePtr->previousNodePtr = node->previousNodePtr;
+
+    delete node;
+    (*size)--;
+}
+
 template <class T>
 void List<T>::operator=(const List<T> &l)
 {
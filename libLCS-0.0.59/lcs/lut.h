@@ -0,0 +1,283 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_LUT_H__
+#define __LCS_LUT_H__
+
+#include "module.h"
+#include "bus.h"
+#include "dynbus.h"
+#include "writegroup.h"
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A parameterized module which encapsulates a look-up table (LUT) with \p inputs inputs
+/// and \p outputs outputs. The function of a LUT is given by a truth table with
+/// \p 2^inputs words, one word for every combination of the inputs. The bit \p k of the
+/// word at the index \p i of the table is the state of the output line \p k when the
+/// input lines are the binary equivalent of \p i (input line 0 is the least significant
+/// bit of the index). The template parameter \p delay indicates the propogation delay from
+/// the inputs to the outputs.
+///
+/// A LUT is evaluated by packing the states of its input lines into an index and looking
+/// up the table once. Hence, a small combinational block (like a full adder) is better
+/// modelled by a LUT than by a module which evaluates the sum of products equations of the
+/// block line by line. If some of the inputs are \p lcs::UNKNOWN or
+/// \p lcs::HIGH_IMPEDENCE, the table is looked up for every combination of those inputs:
+/// an output line which has the same state for all the combinations gets that state, and
+/// the rest of the output lines become \p lcs::UNKNOWN.
+///
+/// The table is held in \p unsigned \p long words. Hence, \p outputs should not be more
+/// than the number of bits in an \p unsigned \p long (which is atleast 32), and \p inputs
+/// should be small enough for the table to fit in memory.
+///
+/// An example of a 1-bit full adder modelled as a LUT is as follows.
+///
+/// \code
+///
+/// unsigned long add(unsigned long i)
+/// {
+///     // Input lines: 0 - a, 1 - b, 2 - carry in.
+///     // Output lines: 0 - sum, 1 - carry out.
+///     return (i & 1) + ((i >> 1) & 1) + (i >> 2);
+/// }
+///
+/// int main(void)
+/// {
+///     Bus<1> a, b, cin, s, cout;
+///     Bus<2> out = (s, cout);
+///
+///     LUT<3, 2> fa(out, (a, b, cin), add);
+///
+///     ....
+/// }
+///
+/// \endcode
+template <int inputs, int outputs = 1, unsigned int delay = 0>
+class LUT : public Module
+{
+public:
+
+    /// Constructs a LUT from a truth table.
+    ///
+    /// \param out The output bus.
+    /// \param in The input bus.
+    /// \param table The truth table, which should have \p 2^inputs words.
+    ///
+    LUT(const Bus<outputs> &out, const InputBus<inputs> &in,
+        const std::vector<unsigned long> &table) throw (OutOfRangeException<int>);
+
+    /// Constructs a LUT from a function. The function \p function is called once for every
+    /// index of the truth table when the LUT is constructed, and the word it returns is
+    /// stored at that index. It is never called during the simulation.
+    ///
+    /// \param out The output bus.
+    /// \param in The input bus.
+    /// \param function A function, or an object of a class with an \p operator(), which
+    /// takes the index as an \p unsigned \p long argument and returns the word as an
+    /// \p unsigned \p long.
+    ///
+    template <typename Function>
+    LUT(const Bus<outputs> &out, const InputBus<inputs> &in, Function function);
+
+    /// Destructor.
+    ///
+    virtual ~LUT();
+
+    /// Returns the word at the index \p index of the truth table.
+    ///
+    unsigned long getWord(unsigned long index) const { return table_[index]; }
+
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output lines are driven with the states looked up from the truth table.
+    virtual void onStateChange(int portId);
+
+    /// The batch evaluator of the LUTs of this type (see
+    /// \p lcs::Module::setBatchEvaluator).
+    static void evaluateBatch(Module *const *mods, const int *portIds, int count);
+
+private:
+
+    /// Looks up the states of the outputs for the states of the inputs and drives them.
+    ///
+    void evaluate(void);
+
+    /// Copying a LUT is not allowed.
+    ///
+    LUT(const LUT<inputs, outputs, delay> &lut);
+
+    /// Subscribes to the input bus and drives the outputs for the first time.
+    ///
+    void init(void);
+
+    /// Drives the output lines which are to change to a state other than the one last
+    /// driven. \p value holds the states of the known output lines, and the output lines
+    /// whose bits are set in \p unknown are driven \p lcs::UNKNOWN.
+    void drive(unsigned long value, unsigned long unknown);
+
+    /// The number of words in the truth table.
+    ///
+    static const unsigned long SIZE = 1UL << inputs;
+
+    /// The mask of the output bits of a word.
+    ///
+    static const unsigned long MASK = (outputs < static_cast<int>(8*sizeof(unsigned long)))
+                                      ? ((1UL << outputs) - 1) : ~0UL;
+
+    DynBus out_;
+    InputBus<inputs> in_;
+    std::vector<unsigned long> table_;
+    unsigned long value_, unknown_;
+};
+
+template <int inputs, int outputs, unsigned int delay>
+LUT<inputs, outputs, delay>::LUT(const Bus<outputs> &out, const InputBus<inputs> &in,
+                                 const std::vector<unsigned long> &table)
+                                 throw (OutOfRangeException<int>)
+    : Module(), out_(out), in_(in), table_(table), value_(0), unknown_(0)
+{
+    if (table_.size() != SIZE)
+        throw OutOfRangeException<int>(static_cast<int>(SIZE), static_cast<int>(SIZE),
+                                       static_cast<int>(table_.size()));
+
+    for (unsigned long i = 0; i < SIZE; i++)
+        table_[i] &= MASK;
+
+    init();
+}
+
+template <int inputs, int outputs, unsigned int delay>
+template <typename Function>
+LUT<inputs, outputs, delay>::LUT(const Bus<outputs> &out, const InputBus<inputs> &in,
+                                 Function function)
+    : Module(), out_(out), in_(in), table_(SIZE), value_(0), unknown_(0)
+{
+    for (unsigned long i = 0; i < SIZE; i++)
+        table_[i] = static_cast<unsigned long>(function(i)) & MASK;
+
+    init();
+}
+
+template <int inputs, int outputs, unsigned int delay>
+LUT<inputs, outputs, delay>::~LUT()
+{
+    in_.stopNotification(this, LINE_STATE_CHANGE, 0);
+}
+
+template <int inputs, int outputs, unsigned int delay>
+void LUT<inputs, outputs, delay>::init(void)
+{
+    in_.notify(this, LINE_STATE_CHANGE, 0);
+    setBatchEvaluator(&LUT<inputs, outputs, delay>::evaluateBatch);
+
+    // No state can match this one; every output line is driven the first time.
+    value_ = ~0UL;
+    unknown_ = ~0UL;
+    evaluate();
+}
+
+template <int inputs, int outputs, unsigned int delay>
+void LUT<inputs, outputs, delay>::onStateChange(int portId)
+{
+    evaluate();
+}
+
+template <int inputs, int outputs, unsigned int delay>
+void LUT<inputs, outputs, delay>::evaluateBatch(Module *const *mods, const int *portIds,
+                                                int count)
+{
+    for (int i = 0; i < count; i++)
+        static_cast<LUT<inputs, outputs, delay>*>(mods[i])->evaluate();
+}
+
+template <int inputs, int outputs, unsigned int delay>
+void LUT<inputs, outputs, delay>::evaluate(void)
+{
+    unsigned long index = 0, unknown = 0;
+
+    for (int i = 0; i < inputs; i++)
+    {
+        LineState state = in_.get(i);
+
+        if (state == HIGH)
+            index |= 1UL << i;
+        else if (state != LOW)
+            unknown |= 1UL << i;
+    }
+
+    if (unknown == 0)
+    {
+        drive(table_[index], 0);
+        return;
+    }
+
+    // Look up every combination of the unknown inputs. The output bits which are set in
+    // all the words looked up and those which are clear in all of them are known.
+    unsigned long all = MASK, any = 0, sub = 0;
+    do
+    {
+        unsigned long word = table_[index | sub];
+        all &= word;
+        any |= word;
+
+        if ((all ^ any) == MASK)
+            break;
+
+        sub = (sub - unknown) & unknown;
+    } while (sub != 0);
+
+    drive(all, all ^ any);
+}
+
+template <int inputs, int outputs, unsigned int delay>
+void LUT<inputs, outputs, delay>::drive(unsigned long value, unsigned long unknown)
+{
+    value &= ~unknown;
+
+    unsigned long changed = (value ^ value_) | (unknown ^ unknown_);
+    if (changed == 0)
+        return;
+
+    value_ = value;
+    unknown_ = unknown;
+
+    WriteGroup group;
+    for (int k = 0; k < outputs; k++)
+    {
+        unsigned long bit = 1UL << k;
+        if ((changed & bit) == 0)
+            continue;
+
+        if (unknown & bit)
+            out_.set<delay>(k, UNKNOWN);
+        else
+            out_.set<delay>(k, (value & bit) ? HIGH : LOW);
+    }
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_LUT_H__
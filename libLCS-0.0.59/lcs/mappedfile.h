@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_MAPPED_FILE_H__
+#define __LCS_MAPPED_FILE_H__
+
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects map the contents of a file into memory for reading. The pages of
+/// the file are read in by the operating system as and when they are accessed, so that
+/// mapping even a large file takes very little time. On platforms which do not support
+/// memory mapping, the contents of the file are read into memory instead.
+class MappedFile
+{
+public:
+
+    /// Constructor. Maps the file \p fileName. Use \p lcs::MappedFile::isOpen to check
+    /// if the file could be mapped.
+    MappedFile(const std::string &fileName);
+
+    /// Destructor. Unmaps the file.
+    ///
+    ~MappedFile();
+
+    /// Returns \p true if the file has been mapped. An empty file is open, but has no
+    /// contents to map.
+    bool isOpen(void) const { return open_; }
+
+    /// Returns the address at which the contents of the file start, or \p NULL if the
+    /// file could not be mapped or is empty.
+    const char* getData(void) const { return data_; }
+
+    /// Returns the size of the file in bytes.
+    ///
+    unsigned long getSize(void) const { return size_; }
+
+private:
+
+    /// Copying a mapped file is not allowed.
+    ///
+    MappedFile(const MappedFile &file);
+
+    /// Assigning a mapped file is not allowed.
+    ///
+    MappedFile& operator=(const MappedFile &file);
+
+    const char *data_;
+    unsigned long size_;
+    bool mapped_, open_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_MAPPED_FILE_H__
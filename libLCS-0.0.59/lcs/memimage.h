@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_MEM_IMAGE_H__
+#define __LCS_MEM_IMAGE_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the formats of the image files from which the contents of the memory
+/// modules like \p lcs::RAM and \p lcs::ROM can be loaded.
+enum MemoryImageFormat
+{
+
+    /// A text file, as read by the \p $readmemh task of Verilog: words written as
+    /// hexadecimal numbers separated by white space, loaded at consecutive addresses. A
+    /// word of the form \p @address moves the loading to the hexadecimal address
+    /// \p address. The digits \p x and \p z make the four bits of the digit unknown, '_'
+    /// characters are ignored, and comments start with "//" and run to the end of the line.
+    HEX_IMAGE    = 12288,
+
+    /// A binary file of words loaded at consecutive addresses. Every word is stored in
+    /// the least number of bytes which can hold it, with the least significant byte first.
+    BINARY_IMAGE = 12289
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_MEM_IMAGE_H__
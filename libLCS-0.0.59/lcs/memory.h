@@ -0,0 +1,561 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_MEMORY_H__
+#define __LCS_MEMORY_H__
+
+#include "bus.h"
+#include "dynbus.h"
+#include "memimage.h"
+#include "memory_exception.h"
+#include "memstore.h"
+#include "module.h"
+#include "pulsedge.h"
+#include "readport.h"
+#include "writegroup.h"
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// The base class of the memory modules \p lcs::RAM and \p lcs::ROM, which holds the
+/// contents of the memory and drives its read ports. A memory has \p 2^addrBits words of
+/// \p dataBits bits each, held in an \p lcs::MemoryStore: only the pages of the memory
+/// which are written cost any memory, and the words which have never been written are
+/// \p lcs::UNKNOWN. Unlike a memory built from \p lcs::Register modules, a memory does not
+/// have a \p lcs::Line for every bit it holds; it has lines only for its ports.
+///
+/// A memory can have any number of read ports (see \p lcs::ReadPortType). The synchronous
+/// read ports, and the write ports of an \p lcs::RAM, are triggered by the \p edgeType
+/// edges of the clock of the memory. At every triggering edge, the synchronous read ports
+/// read their words first, and the write ports write theirs next, in the order in which
+/// they were added. The outputs change with the propogation delay \p delay. A read port
+/// whose address input is not known drives all of its data lines \p lcs::UNKNOWN.
+///
+/// The addresses are held in \p unsigned \p long integers, so \p addrBits should not be
+/// more than the number of bits in an \p unsigned \p long. A user of libLCS will, under
+/// normal circumstances, use \p lcs::RAM and \p lcs::ROM and not this class directly.
+template <int addrBits, int dataBits, PulseEdge edgeType = POS_EDGE, unsigned int delay = 0>
+class Memory : public Module
+{
+public:
+
+    /// Destructor.
+    ///
+    virtual ~Memory();
+
+    /// Adds a read port to the memory and returns its index.
+    ///
+    /// \param data The bus which carries the data output of the port.
+    /// \param address The bus which carries the address input of the port.
+    /// \param type The type of the port. A \p lcs::MemoryException is thrown if the port
+    /// is a \p lcs::SYNCHRONOUS_READ port and the memory has no clock.
+    int addReadPort(const Bus<dataBits> &data, const InputBus<addrBits> &address,
+                    ReadPortType type = ASYNCHRONOUS_READ) throw (MemoryException);
+
+    /// Loads the contents of the memory from the image file \p fileName in the format
+    /// \p format, starting at the address \p base. See \p lcs::MemoryStore::load for more
+    /// information.
+    void load(const std::string &fileName, MemoryImageFormat format = HEX_IMAGE,
+              unsigned long base = 0) throw (MemoryException);
+
+    /// Writes the binary equivalent of \p value at the address \p address. This can be
+    /// used to initialise a few words of the memory from a test bench. A
+    /// \p lcs::MemoryException is thrown if the address is not within the memory.
+    void setWord(unsigned long address, unsigned long value) throw (MemoryException);
+
+    /// Returns the word at the address \p address as a string of the bit states, the
+    /// state of the bit 0 first (as \p lcs::InputBus::toStr does).
+    std::string getWord(unsigned long address) const { return store_.toStr(address); }
+
+    /// Returns the number of pages of the memory which have been allocated.
+    ///
+    int getPageCount(void) const { return store_.getPageCount(); }
+
+    /// Internal function which will never be used by a user of libLCS. It is triggered
+    /// when the address input of an asynchronous read port changes.
+    virtual void onStateChange(int portId);
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onPosEdge(int portId) { onEdge(); }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onNegEdge(int portId) { onEdge(); }
+
+protected:
+
+    /// Constructs a memory without a clock. Such a memory can only have asynchronous read
+    /// ports.
+    Memory(void);
+
+    /// Constructs a memory whose synchronous ports are triggered by the clock \p clk.
+    ///
+    Memory(const InputBus<1> &clk);
+
+    /// Adds a write port to the memory. At every triggering edge of the clock at which the
+    /// \p enable input is \p lcs::HIGH, the word on the \p data input is written at the
+    /// address on the \p address input. As with the gates, an \p lcs::UNKNOWN or
+    /// \p lcs::HIGH_IMPEDENCE enable input is taken as \p lcs::LOW. A write to an address
+    /// which is not known is ignored. A \p lcs::MemoryException is thrown if the memory
+    /// has no clock.
+    void addWritePort(const InputBus<addrBits> &address, const InputBus<dataBits> &data,
+                      const InputBus<1> &enable) throw (MemoryException);
+
+    /// Writes the binary equivalent of \p value at every address of the memory. This is
+    /// meant for the small memories, like register files.
+    void fill(unsigned long value);
+
+private:
+
+    enum { LIMBS = (dataBits + 31) / 32 };
+
+    struct ReadPort
+    {
+        ReadPort(const Bus<dataBits> &d, const InputBus<addrBits> &a, ReadPortType t)
+            : data(d), address(a), type(t), driven(false) {}
+
+        DynBus data;
+        InputBus<addrBits> address;
+        ReadPortType type;
+
+        // The states last driven on the data lines.
+        bool driven;
+        unsigned int value[LIMBS], unknown[LIMBS];
+    };
+
+    struct WritePort
+    {
+        WritePort(const InputBus<addrBits> &a, const InputBus<dataBits> &d, const InputBus<1> &e)
+            : address(a), data(d), enable(e) {}
+
+        InputBus<addrBits> address;
+        InputBus<dataBits> data;
+        InputBus<1> enable;
+    };
+
+    /// Copying a memory is not allowed.
+    ///
+    Memory(const Memory<addrBits, dataBits, edgeType, delay> &memory);
+
+    /// Assigning a memory is not allowed.
+    ///
+    Memory& operator=(const Memory<addrBits, dataBits, edgeType, delay> &memory);
+
+    /// Reads the address on the bus \p bus into \p address. Returns \p false if the address
+    /// is not known.
+    static bool getAddress(const InputBus<addrBits> &bus, unsigned long &address);
+
+    /// Drives the data lines of the read port \p port with the word at its address.
+    ///
+    void read(ReadPort &port);
+
+    /// Drives the data lines of all the asynchronous read ports.
+    ///
+    void refresh(void);
+
+    void onEdge(void);
+
+    MemoryStore store_;
+    bool clocked_;
+    InputBus<1> clk_;
+    std::vector<ReadPort*> reads_;
+    std::vector<WritePort*> writes_;
+};
+
+/// A parameterized module which encapsulates a random access memory with
+/// \p 2^addrBits words of \p dataBits bits each, any number of read ports and any number
+/// of synchronous write ports. See \p lcs::Memory for the details of the ports. An example
+/// of a RAM with one write port and two read ports is as follows.
+///
+/// \code
+///
+/// Bus<1> clk, we;
+/// Bus<16> waddr, raddr1, raddr2;
+/// Bus<8> wdata, rdata1, rdata2;
+///
+/// RAM<16, 8> ram(clk);
+///
+/// ram.addWritePort(waddr, wdata, we);
+/// ram.addReadPort(rdata1, raddr1);
+/// ram.addReadPort(rdata2, raddr2, SYNCHRONOUS_READ);
+/// ram.load("boot.hex");
+///
+/// \endcode
+template <int addrBits, int dataBits, PulseEdge edgeType = POS_EDGE, unsigned int delay = 0>
+class RAM : public Memory<addrBits, dataBits, edgeType, delay>
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param clk The clock which triggers the write ports and the synchronous read ports.
+    RAM(const InputBus<1> &clk) : Memory<addrBits, dataBits, edgeType, delay>(clk) {}
+
+    /// Destructor.
+    ///
+    virtual ~RAM() {}
+
+    /// Adds a write port to the RAM. See \p lcs::Memory::addWritePort for more
+    /// information.
+    void addWritePort(const InputBus<addrBits> &address, const InputBus<dataBits> &data,
+                      const InputBus<1> &enable)
+    {
+        Memory<addrBits, dataBits, edgeType, delay>::addWritePort(address, data, enable);
+    }
+};
+
+/// A parameterized module which encapsulates a read only memory with \p 2^addrBits words
+/// of \p dataBits bits each, and any number of read ports. The contents of a ROM are
+/// loaded with \p lcs::Memory::load or \p lcs::Memory::setWord. See \p lcs::Memory for
+/// the details of the ports.
+template <int addrBits, int dataBits, PulseEdge edgeType = POS_EDGE, unsigned int delay = 0>
+class ROM : public Memory<addrBits, dataBits, edgeType, delay>
+{
+public:
+
+    /// Constructs a ROM which can have only asynchronous read ports.
+    ///
+    ROM(void) : Memory<addrBits, dataBits, edgeType, delay>() {}
+
+    /// Constructs a ROM whose synchronous read ports are triggered by the clock \p clk.
+    ///
+    ROM(const InputBus<1> &clk) : Memory<addrBits, dataBits, edgeType, delay>(clk) {}
+
+    /// Destructor.
+    ///
+    virtual ~ROM() {}
+};
+
+/// A parameterized module which encapsulates a register file of \p 2^addrBits registers of
+/// \p dataBits bits each. A register file is an \p lcs::RAM with an optional reset input:
+/// all the registers are cleared as soon as the reset input becomes \p lcs::HIGH, and the
+/// clock edges are ignored as long as it stays \p lcs::HIGH. As the contents of all the
+/// registers are held in an \p lcs::MemoryStore, and all the ports share one subscription
+/// to the clock, a register file costs far less than a set of \p lcs::Register modules.
+template <int addrBits, int dataBits, PulseEdge edgeType = POS_EDGE, unsigned int delay = 0>
+class RegisterFile : public Memory<addrBits, dataBits, edgeType, delay>
+{
+public:
+
+    /// Constructs a register file without a reset input.
+    ///
+    RegisterFile(const InputBus<1> &clk)
+        : Memory<addrBits, dataBits, edgeType, delay>(clk), hasReset_(false) {}
+
+    /// Constructs a register file with the active \p lcs::HIGH reset input \p reset.
+    ///
+    RegisterFile(const InputBus<1> &clk, const InputBus<1> &reset)
+        : Memory<addrBits, dataBits, edgeType, delay>(clk), reset_(reset), hasReset_(true)
+    {
+        reset_.notify(this, LINE_STATE_CHANGE, RESET);
+        onStateChange(RESET);
+    }
+
+    /// Destructor.
+    ///
+    virtual ~RegisterFile()
+    {
+        if (hasReset_)
+            reset_.stopNotification(this, LINE_STATE_CHANGE, RESET);
+    }
+
+    /// Adds a write port to the register file. See \p lcs::Memory::addWritePort for more
+    /// information.
+    void addWritePort(const InputBus<addrBits> &address, const InputBus<dataBits> &data,
+                      const InputBus<1> &enable)
+    {
+        Memory<addrBits, dataBits, edgeType, delay>::addWritePort(address, data, enable);
+    }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onStateChange(int portId)
+    {
+        if (portId != RESET)
+            Memory<addrBits, dataBits, edgeType, delay>::onStateChange(portId);
+
+        if ((portId == RESET || portId == ANY_PORT) && resetting())
+            Memory<addrBits, dataBits, edgeType, delay>::fill(0);
+    }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onPosEdge(int portId)
+    {
+        if (!resetting())
+            Memory<addrBits, dataBits, edgeType, delay>::onPosEdge(portId);
+    }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onNegEdge(int portId)
+    {
+        if (!resetting())
+            Memory<addrBits, dataBits, edgeType, delay>::onNegEdge(portId);
+    }
+
+private:
+
+    /// The port id with which the reset input notifies the register file.
+    ///
+    enum { RESET = -2 };
+
+    bool resetting(void) const { return hasReset_ && reset_.get(0) == HIGH; }
+
+    InputBus<1> reset_;
+    bool hasReset_;
+};
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+Memory<addrBits, dataBits, edgeType, delay>::Memory(void)
+    : Module(), store_(addrBits, dataBits), clocked_(false)
+{}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+Memory<addrBits, dataBits, edgeType, delay>::Memory(const InputBus<1> &clk)
+    : Module(), store_(addrBits, dataBits), clocked_(true), clk_(clk)
+{
+    if (edgeType == POS_EDGE)
+        clk_.notify(this, LINE_POS_EDGE, 0);
+    if (edgeType == NEG_EDGE)
+        clk_.notify(this, LINE_NEG_EDGE, 0);
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+Memory<addrBits, dataBits, edgeType, delay>::~Memory()
+{
+    if (clocked_ && edgeType == POS_EDGE)
+        clk_.stopNotification(this, LINE_POS_EDGE, 0);
+    if (clocked_ && edgeType == NEG_EDGE)
+        clk_.stopNotification(this, LINE_NEG_EDGE, 0);
+
+    for (unsigned int i = 0; i < reads_.size(); i++)
+    {
+        if (reads_[i]->type == ASYNCHRONOUS_READ)
+            reads_[i]->address.stopNotification(this, LINE_STATE_CHANGE, static_cast<int>(i));
+
+        delete reads_[i];
+    }
+
+    for (unsigned int i = 0; i < writes_.size(); i++)
+        delete writes_[i];
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+int Memory<addrBits, dataBits, edgeType, delay>::addReadPort(const Bus<dataBits> &data,
+                                                             const InputBus<addrBits> &address,
+                                                             ReadPortType type)
+                                                             throw (MemoryException)
+{
+    if (type == SYNCHRONOUS_READ && !clocked_)
+        throw MemoryException("A synchronous read port cannot be added to a memory without a clock.");
+
+    int index = static_cast<int>(reads_.size());
+    reads_.push_back(new ReadPort(data, address, type));
+
+    if (type == ASYNCHRONOUS_READ)
+    {
+        reads_[index]->address.notify(this, LINE_STATE_CHANGE, index);
+        read(*reads_[index]);
+    }
+
+    return index;
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::addWritePort(const InputBus<addrBits> &address,
+                                                               const InputBus<dataBits> &data,
+                                                               const InputBus<1> &enable)
+                                                               throw (MemoryException)
+{
+    if (!clocked_)
+        throw MemoryException("A write port cannot be added to a memory without a clock.");
+
+    writes_.push_back(new WritePort(address, data, enable));
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::load(const std::string &fileName,
+                                                       MemoryImageFormat format,
+                                                       unsigned long base)
+                                                       throw (MemoryException)
+{
+    store_.load(fileName, format, base);
+    refresh();
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::setWord(unsigned long address,
+                                                          unsigned long value)
+                                                          throw (MemoryException)
+{
+    store_.write(address, value);
+    refresh();
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::fill(unsigned long value)
+{
+    for (unsigned long address = 0; address < (1UL << addrBits); address++)
+        store_.write(address, value);
+
+    refresh();
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+bool Memory<addrBits, dataBits, edgeType, delay>::getAddress(const InputBus<addrBits> &bus,
+                                                             unsigned long &address)
+{
+    address = 0;
+    for (int i = 0; i < addrBits; i++)
+    {
+        LineState state = bus.get(i);
+
+        if (state == HIGH)
+            address |= 1UL << i;
+        else if (state != LOW)
+            return false;
+    }
+
+    return true;
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::read(ReadPort &port)
+{
+    unsigned int value[LIMBS], unknown[LIMBS];
+    unsigned long address;
+
+    if (getAddress(port.address, address))
+        store_.read(address, value, unknown);
+    else
+    {
+        for (int k = 0; k < LIMBS; k++)
+        {
+            value[k] = 0;
+            unknown[k] = ~0u;
+        }
+    }
+
+    WriteGroup group;
+    for (int i = 0; i < dataBits; i++)
+    {
+        int k = i / 32;
+        unsigned int bit = 1u << (i % 32);
+
+        if (port.driven && ((value[k] ^ port.value[k]) & bit) == 0
+                        && ((unknown[k] ^ port.unknown[k]) & bit) == 0)
+            continue;
+
+        LineState state = LOW;
+        if (unknown[k] & bit)
+            state = (value[k] & bit) ? HIGH_IMPEDENCE : UNKNOWN;
+        else if (value[k] & bit)
+            state = HIGH;
+
+        port.data.template set<delay>(i, state);
+    }
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        port.value[k] = value[k];
+        port.unknown[k] = unknown[k];
+    }
+
+    port.driven = true;
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::onStateChange(int portId)
+{
+    // In the delta evaluation mode, or after the contents are loaded, all the asynchronous
+    // read ports are read again.
+    if (portId >= 0 && portId < static_cast<int>(reads_.size()))
+    {
+        read(*reads_[portId]);
+        return;
+    }
+
+    refresh();
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::refresh(void)
+{
+    for (unsigned int i = 0; i < reads_.size(); i++)
+    {
+        if (reads_[i]->type == ASYNCHRONOUS_READ)
+            read(*reads_[i]);
+    }
+}
+
+template <int addrBits, int dataBits, PulseEdge edgeType, unsigned int delay>
+void Memory<addrBits, dataBits, edgeType, delay>::onEdge(void)
+{
+    WriteGroup group;
+
+    for (unsigned int i = 0; i < reads_.size(); i++)
+    {
+        if (reads_[i]->type == SYNCHRONOUS_READ)
+            read(*reads_[i]);
+    }
+
+    bool written = false;
+    for (unsigned int i = 0; i < writes_.size(); i++)
+    {
+        WritePort &port = *writes_[i];
+        unsigned long address;
+
+        if (port.enable.get(0) != HIGH || !getAddress(port.address, address))
+            continue;
+
+        unsigned int value[LIMBS], unknown[LIMBS];
+        for (int k = 0; k < LIMBS; k++)
+            value[k] = unknown[k] = 0;
+
+        for (int b = 0; b < dataBits; b++)
+        {
+            LineState state = port.data.get(b);
+            unsigned int bit = 1u << (b % 32);
+
+            if (state == HIGH || state == HIGH_IMPEDENCE)
+                value[b / 32] |= bit;
+            if (state == UNKNOWN || state == HIGH_IMPEDENCE)
+                unknown[b / 32] |= bit;
+        }
+
+        store_.write(address, value, unknown);
+        written = true;
+    }
+
+    if (written)
+        refresh();
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_MEMORY_H__
@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_MEMORY_STORE_H__
+#define __LCS_MEMORY_STORE_H__
+
+#include "memimage.h"
+#include "memory_exception.h"
+#include <map>
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects hold the contents of the memory modules like \p lcs::RAM and
+/// \p lcs::ROM. The words are stored in pages of \p lcs::MemoryStore::PAGE_WORDS words,
+/// which are allocated when a word in them is first written. Hence, a memory costs only as
+/// much as the pages which are written, however large its address space is. The words
+/// which have never been written are \p lcs::UNKNOWN.
+///
+/// A word is held as two packed bit planes of 32 bit limbs, as in \p lcs::WordState: a
+/// value plane, and an unknown plane whose set bits mark the unknown bits. A user of
+/// libLCS will, under normal circumstances, never need to use this class directly.
+class MemoryStore
+{
+public:
+
+    /// The number of address bits which select a word within a page.
+    ///
+    static const int PAGE_BITS = 8;
+
+    /// The number of words in a page.
+    ///
+    static const unsigned long PAGE_WORDS = 1UL << PAGE_BITS;
+
+    /// Constructor.
+    ///
+    /// \param addrBits The number of address bits. The memory has \p 2^addrBits words.
+    /// \param dataBits The number of bits in a word.
+    MemoryStore(int addrBits, int dataBits);
+
+    /// Destructor.
+    ///
+    ~MemoryStore();
+
+    /// Returns the number of 32 bit limbs in each of the planes of a word.
+    ///
+    int getLimbCount(void) const { return limbs_; }
+
+    /// Returns the number of pages allocated.
+    ///
+    int getPageCount(void) const { return static_cast<int>(pages_.size()); }
+
+    /// Reads the word at the address \p address into the arrays \p value and \p unknown,
+    /// each of which should have \p lcs::MemoryStore::getLimbCount elements.
+    void read(unsigned long address, unsigned int *value, unsigned int *unknown) const;
+
+    /// Writes the word held by the arrays \p value and \p unknown at the address
+    /// \p address.
+    void write(unsigned long address, const unsigned int *value, const unsigned int *unknown);
+
+    /// Writes the binary equivalent of \p value at the address \p address. An
+    /// \p lcs::MemoryException is thrown if the address is not within the memory.
+    void write(unsigned long address, unsigned long value) throw (MemoryException);
+
+    /// Returns the word at the address \p address as a string of the bit states, the most
+    /// significant bit first.
+    std::string toStr(unsigned long address) const;
+
+    /// Loads the image file \p fileName in the format \p format, starting at the address
+    /// \p base. The file is mapped into memory (see \p lcs::MappedFile) rather than read.
+    /// A \p lcs::MemoryException is thrown if the file cannot be read, if it is not valid,
+    /// or if it does not fit in the memory. An empty image loads nothing.
+    void load(const std::string &fileName, MemoryImageFormat format, unsigned long base = 0)
+              throw (MemoryException);
+
+private:
+
+    /// Copying a store is not allowed.
+    ///
+    MemoryStore(const MemoryStore &store);
+
+    /// Assigning a store is not allowed.
+    ///
+    MemoryStore& operator=(const MemoryStore &store);
+
+    /// Returns the planes of the word at the address \p address: the value plane limbs
+    /// followed by the unknown plane limbs. Returns \p NULL if the page of the word has
+    /// not been allocated.
+    const unsigned int* find(unsigned long address) const;
+
+    /// Returns the planes of the word at the address \p address, allocating its page if
+    /// required.
+    unsigned int* word(unsigned long address);
+
+    /// Returns \p true if the address \p address is within the memory.
+    ///
+    bool contains(unsigned long address) const;
+
+    void loadHex(const std::string &fileName, const char *data, unsigned long size,
+                 unsigned long base) throw (MemoryException);
+
+    void loadBinary(const std::string &fileName, const char *data, unsigned long size,
+                    unsigned long base) throw (MemoryException);
+
+    int addrBits_, dataBits_, limbs_;
+    unsigned int topMask_;
+
+    std::map<unsigned long, unsigned int*> pages_;
+    mutable unsigned long lastPage_;
+    mutable unsigned int *last_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_MEMORY_STORE_H__
@@ -25,9 +25,26 @@
 #ifndef __LCS_MODULE_H__
 #define __LCS_MODULE_H__
 
+#include "bitchange.h"
+#include <cstddef>
+
 namespace lcs
 { // Start of namespace lcs.
 
+/// The port id with which a module is notified of an event which occured on more than one
+/// of its ports in the same delta cycle, in the \p lcs::DELTA_EVALUATION and
+/// \p lcs::BATCHED_EVALUATION modes, or in the same \p lcs::WriteGroup. A module notified
+/// with this port id should re-read all its inputs.
+const int ANY_PORT = -1;
+
+class Module;
+
+/// The type of the functions which evaluate a group of modules of the same type at once in
+/// the \p lcs::BATCHED_EVALUATION mode. The modules are passed in the array \p mods, and
+/// the port ids with which they are notified in the array \p portIds, both of \p count
+/// entries. See \p lcs::Module::setBatchEvaluator.
+typedef void (*BatchEvaluator)(Module *const *mods, const int *portIds, int count);
+
 /// Every circuit element (like an AND gate) which needs to be driven by lcs::InputBus
 /// objects has to be derived from this class Module. User of libLCS desirous of defining
 /// his/her own element should subclass this class and redefine the virtual function
@@ -38,7 +55,7 @@ public:
 
     /// Default constructor.
     ///
-    Module(void) {}
+    Module(void) : evaluator_(NULL) {}
 
     /// Destructor.
     ///
@@ -47,7 +64,10 @@ public:
     /// A subclass of the class Module should override this function so that it can be
     /// notified of a state change on its input busses. If a lcs::LINE_STATE_CHANGE event
     /// occurs on an input bus, the bus will call this function on the corresponding module
-    /// object as a notification of the occurance of the event.
+    /// object as a notification of the occurance of the event. \p portId is the port id
+    /// with which the bus was registered (see \p lcs::InputBus::notify), or
+    /// \p lcs::ANY_PORT if the state changed on more than one port of the module in the
+    /// same write group or delta cycle; the module should then re-read all its inputs.
     virtual void onStateChange(int portId) {}
 
     /// A subclass of the class Module should override this function so that it can be
@@ -62,6 +82,41 @@ public:
     /// object as a notification of the occurance of the event.
     virtual void onNegEdge(int portId) {}
 
+    /// A subclass which registers with its input busses through
+    /// \p lcs::InputBus::notifyBits should override this function, so that it is told
+    /// which lines changed and what their states were. The \p count changes are passed in
+    /// the array \p changes, sorted by their port ids and line indices. A line which
+    /// changed more than once is listed once, with its state before the first change; it
+    /// may hence be listed with its current state. \p portId is the port of the changes, or
+    /// \p lcs::ANY_PORT if they occured on more than one port. The default implementation
+    /// calls \p lcs::Module::onStateChange with \p portId, so that a module which does not
+    /// override this function is notified as if it had registered through
+    /// \p lcs::InputBus::notify.
+    virtual void onBitsChange(int portId, const BitChange *changes, int count)
+    {
+        onStateChange(portId);
+    }
+
+    /// Returns the function which evaluates the state changes of the modules of the type
+    /// of this module in a group, or \p NULL if the module is notified through
+    /// \p lcs::Module::onStateChange in every evaluation mode.
+    BatchEvaluator getBatchEvaluator(void) const { return evaluator_; }
+
+protected:
+
+    /// A subclass can set a function which evaluates the state changes of a group of its
+    /// objects. In the \p lcs::BATCHED_EVALUATION mode, the modules notified of state
+    /// changes in a delta cycle are grouped by their evaluators, and every group is
+    /// evaluated through a single call to its evaluator instead of a virtual call to
+    /// \p lcs::Module::onStateChange for each module. The evaluator should be a static
+    /// function of the subclass which does for every module in the group what its
+    /// \p onStateChange does, calling the subclass functions directly. A subclass which
+    /// overrides \p onStateChange of a class which sets an evaluator should set its own
+    /// evaluator, or \p NULL.
+    void setBatchEvaluator(BatchEvaluator evaluator) { evaluator_ = evaluator; }
+
+private:
+    BatchEvaluator evaluator_;
 };
 
 } // End of namespace lcs.
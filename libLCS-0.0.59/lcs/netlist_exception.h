@@ -0,0 +1,61 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NETLIST_EXCEPTION_H__
+#define __LCS_NETLIST_EXCEPTION_H__
+
+#include "exception.h"
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs.
+
+/// An exception class whose objects are thrown when a netlist is built, elaborated or
+/// bound to busses incorrectly. Examples of such errors are connections to ports which
+/// do not exist, nets with more than one driver, and circuits which instantiate
+/// themselves.
+class NetlistException : public Exception
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param message The message describing the error.
+    NetlistException(const std::string &message) : Exception(), message_(message) {}
+
+    /// Destructor.
+    ///
+    virtual ~NetlistException() {}
+
+    /// Returns a \p std::string message describing the error.
+    ///
+    virtual std::string getMessage(void) { return message_ + "\n"; }
+
+private:
+    std::string message_;
+};
+
+} // End of namespace lcs.
+
+#endif // __LCS_NETLIST_EXCEPTION_H__
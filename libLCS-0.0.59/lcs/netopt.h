@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NETLIST_OPTIMIZER_H__
+#define __LCS_NETLIST_OPTIMIZER_H__
+
+#include "flatnetlist.h"
+#include "netlist_exception.h"
+#include "optpass.h"
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects simplify flat netlists before they are simulated, so that the
+/// \p lcs::NetlistSimulator spends no events or evaluations on logic which cannot affect
+/// the outputs. The passes (see \p lcs::OptimizationPass) fold the constant logic, collapse
+/// the zero delay buffers into net aliases, merge the structurally identical cells, and
+/// remove the logic with no observable fanout. The passes are repeated until none of them
+/// simplifies the netlist any further.
+///
+/// The optimized netlist is a new \p lcs::FlatNetlist with the same ports and the same net
+/// ids as the original, and its outputs behave as those of the original. The nets which
+/// are aliased to other nets, or which are left without a driver by the dead logic
+/// removal, lose their names; all the other nets keep theirs. Nets which are to be probed
+/// (with \p lcs::NetlistSimulator::getState, for example) can be kept intact with
+/// \p lcs::NetlistOptimizer::keepNet or \p lcs::NetlistOptimizer::keepNamedNets. An
+/// example of usage is as follows:
+///
+/// <pre>
+/// lcs::FlatNetlist flat(top);
+/// lcs::NetlistOptimizer opt;
+///
+/// opt.keepNet("u0.carry");
+/// lcs::FlatNetlist *optimized = opt.optimize(flat);
+/// std::cout << opt.getReport();
+///
+/// lcs::NetlistSimulator sim(*optimized);
+/// </pre>
+class NetlistOptimizer
+{
+public:
+
+    /// Default constructor. All the passes are enabled, and no net is kept.
+    ///
+    NetlistOptimizer(void);
+
+    /// Enables or disables the pass \p pass.
+    ///
+    void setPass(OptimizationPass pass, bool enabled);
+
+    /// Returns \p true if the pass \p pass is enabled.
+    ///
+    bool isPassEnabled(OptimizationPass pass) const;
+
+    /// Keeps the net with the hierarchical name \p name intact: the net keeps its name and
+    /// its state, and is neither aliased to another net nor removed as dead logic.
+    void keepNet(const std::string &name) { keptNames_.push_back(name); }
+
+    /// If \p keep is \p true, every named net is kept intact as if it were passed to
+    /// \p lcs::NetlistOptimizer::keepNet. The unnamed nets are optimized as usual.
+    void keepNamedNets(bool keep) { keepNamed_ = keep; }
+
+    /// Optimizes the netlist \p netlist and returns the optimized netlist, which should be
+    /// deleted by the caller. The report of the optimization replaces that of the previous
+    /// call. A \p lcs::NetlistException is thrown if a net passed to
+    /// \p lcs::NetlistOptimizer::keepNet does not exist in the netlist.
+    FlatNetlist* optimize(const FlatNetlist &netlist) throw (NetlistException);
+
+    /// Returns the number of cells replaced by constant nets.
+    ///
+    int getFoldedCount(void) const { return folded_; }
+
+    /// Returns the number of buffers collapsed into net aliases.
+    ///
+    int getCollapsedCount(void) const { return collapsed_; }
+
+    /// Returns the number of cells merged into identical cells.
+    ///
+    int getMergedCount(void) const { return merged_; }
+
+    /// Returns the number of cells removed as dead logic.
+    ///
+    int getRemovedCount(void) const { return removed_; }
+
+    /// Returns the hierarchical names of the nets which lost their names.
+    ///
+    const std::vector<std::string>& getRemovedNets(void) const { return removedNets_; }
+
+    /// Returns a printable report of the last optimization, with the number of cells
+    /// removed by every pass and the names of the nets which were removed.
+    std::string getReport(void) const;
+
+private:
+
+    bool passes_[4];
+    bool keepNamed_;
+    std::vector<std::string> keptNames_;
+
+    int cells_, folded_, collapsed_, merged_, removed_;
+    std::vector<std::string> removedNets_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_NETLIST_OPTIMIZER_H__
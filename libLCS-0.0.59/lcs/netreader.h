@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NETLIST_READER_H__
+#define __LCS_NETLIST_READER_H__
+
+#include "circuit.h"
+#include "circuitlib.h"
+#include "flatnetlist.h"
+#include "netlist_exception.h"
+#include <istream>
+#include <string>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class which provides static functions to read structural netlists in text formats
+/// into \p lcs::Circuit definitions. The netlists are read in a single streaming pass;
+/// the instances of circuits which are defined later in the input are connected at the
+/// end of the input. Every circuit read is added to the library passed to the reader.
+///
+/// Two formats are supported:
+///
+/// - BLIF: the models (\p .model, \p .inputs, \p .outputs, \p .end), the logic functions
+///   (\p .names) in the sum of products form, the latches (\p .latch) of the types \p re
+///   and \p fe, and the subcircuits (\p .subckt). A logic function is built from the gate
+///   cells; functions which are single AND, OR, XOR gates (or their complements), buffers
+///   or inverters map to a single cell, an XOR gate to an \p lcs::PARITY_CELL. The latches
+///   without a clock are clocked by the net named by the first \p .clock directive of the
+///   model, or by an input port named \p clock which is added to the model if required. A
+///   latch clock net which is not declared before its first use is added to the model as an
+///   input port.
+///
+/// - Structural Verilog: modules with ports declared in either the ANSI or the 1995
+///   style, vectors, \p wire, \p supply0 and \p supply1 declarations, the gate primitives
+///   (\p and, \p nand, \p or, \p nor, \p xor, \p xnor, \p buf and \p not) with an optional
+///   delay, module instances with ordered or named port connections, and \p assign
+///   statements whose right hand sides are nets, bit-selects, part-selects,
+///   concatenations or constants, optionally complemented with '~'. As in the ISCAS89
+///   benchmark netlists, an instance of an undefined module named \p dff with the ports
+///   (CK, Q, D) is a positive edge triggered D flipflop cell.
+///
+/// A \p lcs::NetlistException, with the line number where the error was found, is thrown
+/// if the input is not valid or uses constructs which are not supported.
+class NetlistReader
+{
+public:
+
+    /// Reads the BLIF netlist from the stream \p in into the library \p lib, and returns
+    /// the first model of the netlist, which is the top level model.
+    static Circuit& readBlif(std::istream &in, CircuitLibrary &lib) throw (NetlistException);
+
+    /// Reads the BLIF netlist from the file \p fileName. See the other overload for more
+    /// information.
+    static Circuit& readBlif(const std::string &fileName, CircuitLibrary &lib)
+                             throw (NetlistException);
+
+    /// Reads the structural Verilog netlist from the stream \p in into the library \p lib,
+    /// and returns the top level module: the first module read which is not instantiated
+    /// by any other module.
+    static Circuit& readVerilog(std::istream &in, CircuitLibrary &lib) throw (NetlistException);
+
+    /// Reads the structural Verilog netlist from the file \p fileName. See the other
+    /// overload for more information.
+    static Circuit& readVerilog(const std::string &fileName, CircuitLibrary &lib)
+                                throw (NetlistException);
+
+    /// Reads the netlist in the file \p fileName, flattens it and returns the flat
+    /// netlist, which should be deleted by the caller. The format of the netlist is
+    /// determined by the extension of the file name: \p .blif for BLIF, and \p .v for
+    /// structural Verilog.
+    ///
+    /// The flat netlist is saved to the cache file \p cacheFileName, keyed by a hash of
+    /// the contents of the netlist file. If the cache file already holds the flat netlist
+    /// of the same contents, the netlist is not read again; the cache file is mapped into
+    /// memory instead (see \p lcs::FlatNetlist::map), which takes very little time even
+    /// for very large netlists. A cache file which cannot be written is not an error.
+    ///
+    /// \param fileName The name of the netlist file.
+    /// \param cacheFileName The name of the cache file. If empty, the name of the netlist
+    /// file with the extension \p .lcsnet appended is used.
+    static FlatNetlist* load(const std::string &fileName, const std::string &cacheFileName = "")
+                             throw (NetlistException);
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_NETLIST_READER_H__
@@ -0,0 +1,282 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NETLIST_SIMULATOR_H__
+#define __LCS_NETLIST_SIMULATOR_H__
+
+#include "bus.h"
+#include "dynbus.h"
+#include "flatnetlist.h"
+#include "module.h"
+#include "netlist_exception.h"
+#include "oscillation_exception.h"
+#include "statemode.h"
+#include "tickListener.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class (a \p lcs::Module derivative) whose objects simulate an \p lcs::FlatNetlist
+/// as a part of the libLCS simulation. The ports of the flat netlist are bound to
+/// \p lcs::Bus objects: the busses bound to input ports drive the netlist, and the ones
+/// bound to output ports are driven by it. Every other net of the netlist lives only in the
+/// simulator, as an entry of a state array, and not as an \p lcs::Line object.
+///
+/// When an input changes, the cells driven by it are marked pending, and the pending
+/// cells are evaluated in the topological order precomputed by the flat netlist; the
+/// combinational logic hence settles with every cell evaluated at most once. The changes
+/// due to cells with nonzero delays are scheduled with the \p lcs::SystemTimer. An example
+/// of usage of this class is as follows:
+///
+/// <pre>
+/// lcs::FlatNetlist flat(top);
+/// lcs::Bus<3> in;
+/// lcs::Bus<2> out;
+///
+/// lcs::NetlistSimulator sim(flat);
+/// sim.bindInput("in", in);
+/// sim.bindOutput("out", out);
+/// </pre>
+///
+/// The nets can also be simulated as single bits, which takes a bit of memory per net
+/// instead of a byte, for the designs in which the unknown states do not occur after
+/// reset (see \p lcs::StateMode). The cells are still evaluated one at a time in this
+/// mode.
+///
+/// The flat netlist should live at least as long as the simulator.
+class NetlistSimulator : public Module, public TickListener
+{
+public:
+
+    /// Constructor. The combinational cells are evaluated with the initial states of the
+    /// nets as inputs.
+    ///
+    /// The cells on the zero delay combinational loops of the netlist (see
+    /// \p lcs::FlatNetlist::findCombinationalLoops) are evaluated in rounds until they
+    /// settle. If they do not settle within the delta cycle limit (see
+    /// \p lcs::Simulation::setDeltaLimit), an \p lcs::OscillationException naming the nets
+    /// on the loops which kept changing is thrown, here or wherever the loops were set off.
+    ///
+    /// \param netlist The flat netlist which is to be simulated.
+    /// \param mode The set of line states with which the nets are simulated.
+    NetlistSimulator(const FlatNetlist &netlist, StateMode mode = FOUR_STATE_SIMULATION);
+
+    /// Constructs another instance of the netlist simulated by \p sim, in the same mode.
+    /// The nets of the new instance start in the states which they are in \p sim, and the
+    /// changes of the cells with nonzero delays pending in \p sim are pending in the new
+    /// instance too. As the states of \p sim are settled, no cell is evaluated: only the
+    /// state arrays of \p sim are copied. Hence, a design which has many instances of the
+    /// same block can simulate every instance with its own simulator of one shared flat
+    /// netlist, the simulators after the first being made from it. The busses bound to
+    /// \p sim are not bound to the new instance.
+    ///
+    /// \param sim The simulator whose netlist and states the new instance takes.
+    NetlistSimulator(const NetlistSimulator &sim);
+
+    /// Destructor.
+    ///
+    virtual ~NetlistSimulator();
+
+    /// Binds the input port \p port to the bus \p bus. A \p lcs::NetlistException is
+    /// thrown if the netlist does not have an input port of that name and width.
+    template <int w>
+    void bindInput(const std::string &port, const InputBus<w> &bus)
+                   throw (NetlistException, OscillationException);
+
+    /// Binds the output port \p port to the bus \p bus. A \p lcs::NetlistException is
+    /// thrown if the netlist does not have an output port of that name and width.
+    template <int w>
+    void bindOutput(const std::string &port, const Bus<w> &bus)
+                    throw (NetlistException, OscillationException);
+
+    /// Binds the input port \p port to the bus \p bus whose width is chosen at run time.
+    /// A \p lcs::NetlistException is thrown if the netlist does not have an input port of
+    /// that name and width.
+    void bindInput(const std::string &port, const DynBus &bus)
+                   throw (NetlistException, OscillationException);
+
+    /// Binds the output port \p port to the bus \p bus whose width is chosen at run time.
+    /// A \p lcs::NetlistException is thrown if the netlist does not have an output port of
+    /// that name and width.
+    void bindOutput(const std::string &port, const DynBus &bus)
+                    throw (NetlistException, OscillationException);
+
+    /// Returns the state of the net \p net.
+    ///
+    LineState getState(int net) const
+    {
+        if (mode_ == FOUR_STATE_SIMULATION)
+            return static_cast<LineState>(state_[net]);
+
+        return isSet(bits_, net) ? HIGH : LOW;
+    }
+
+    /// Returns the state of the net with the hierarchical name \p name. A
+    /// \p lcs::NetlistException is thrown if there is no net of that name.
+    LineState getState(const std::string &name) const throw (NetlistException);
+
+    /// Returns the number of cell evaluations made so far.
+    ///
+    unsigned long getEvaluationCount(void) const { return evaluations_; }
+
+    /// Returns the set of line states with which the nets are simulated.
+    ///
+    StateMode getStateMode(void) const { return mode_; }
+
+    /// Returns the id of the first net which would have been put in an unknown state, or
+    /// -1 if there has been none. Such nets are recorded only in the
+    /// \p lcs::CHECKED_TWO_STATE_SIMULATION mode. The initial states of the nets, and the
+    /// states of the inputs when they are bound, are not counted.
+    int getFirstUnknownNet(void) const { return unknownNet_; }
+
+    /// Returns the system time at which the net returned by
+    /// \p lcs::NetlistSimulator::getFirstUnknownNet would have been put in an unknown state.
+    unsigned int getFirstUnknownTime(void) const { return unknownTime_; }
+
+    /// The function through which the input busses notify the simulator of their state
+    /// changes. The port id is the index of the bound input line.
+    virtual void onStateChange(int portId);
+
+    /// The function through which the \p lcs::SystemTimer notifies the simulator of a
+    /// time tick, so that it can make the changes scheduled for the tick.
+    virtual void onTick(void);
+
+private:
+
+    struct Event
+    {
+        unsigned int time;
+        unsigned long sequence;
+        int net;
+        LineState state;
+
+        bool operator>(const Event &e) const
+        {
+            return time > e.time || (time == e.time && sequence > e.sequence);
+        }
+    };
+
+    /// Assigning a simulator is not allowed.
+    ///
+    NetlistSimulator& operator=(const NetlistSimulator &sim);
+
+    int findPort(const std::string &port, PortDirection dir, int width) const throw (NetlistException);
+
+    void addInput(int net, const InputBus<1> &line);
+
+    void addOutput(int net, const Bus<1> &line);
+
+    static bool isSet(const std::vector<unsigned int> &plane, int net)
+    {
+        return (plane[net >> 5] >> (net & 31)) & 1;
+    }
+
+    static void put(std::vector<unsigned int> &plane, int net, bool bit)
+    {
+        if (bit)
+            plane[net >> 5] |= 1u << (net & 31);
+        else
+            plane[net >> 5] &= ~(1u << (net & 31));
+    }
+
+    LineState read(int net) const;
+
+    bool isHigh(int net) const;
+
+    void write(int net, LineState state);
+
+    void setState(int net, LineState state, bool initial = false);
+
+    void drive(int cell, LineState state);
+
+    LineState evaluate(int cell) const;
+
+    void settle(void) throw (OscillationException);
+
+    void oscillate(const std::set<int> &nets) throw (OscillationException);
+
+    void flush(void);
+
+    const FlatNetlist &netlist_;
+    StateMode mode_;
+
+    // The states of the nets in the four state mode; in the two state modes, a bit plane of
+    // the nets which are HIGH, and in the checked mode, one of the nets which are unknown.
+    // The state arrays are all that a simulator allocates in proportion to the size of its
+    // netlist.
+    std::vector<unsigned char> state_;
+    std::vector<unsigned int> bits_, unknown_;
+    int unknownNet_;
+    unsigned int unknownTime_;
+
+    std::vector<bool> pending_;
+    std::vector<int> heap_;
+    std::vector< std::pair<int, LineState> > sampled_;
+    std::vector<Event> events_;
+    unsigned long sequence_;
+    unsigned long evaluations_;
+
+    std::vector< InputBus<1>* > inputs_;
+    std::vector<int> inputNet_;
+
+    std::vector< Bus<1>* > outputs_;
+    std::vector<int> outputNet_, nextOutput_, changedOutputs_;
+    std::vector<unsigned int> outputBits_;
+    std::map<int, int> netOutput_;
+    std::vector<bool> outputChanged_;
+};
+
+template <int w>
+void NetlistSimulator::bindInput(const std::string &port, const InputBus<w> &bus)
+                                 throw (NetlistException, OscillationException)
+{
+    int net = netlist_.getPortNet(findPort(port, INPUT_PORT, w));
+
+    for (int i = 0; i < w; i++)
+        addInput(net + i, bus[i]);
+
+    settle();
+    flush();
+}
+
+template <int w>
+void NetlistSimulator::bindOutput(const std::string &port, const Bus<w> &bus)
+                                  throw (NetlistException, OscillationException)
+{
+    int net = netlist_.getPortNet(findPort(port, OUTPUT_PORT, w));
+    Bus<w> b(bus);
+
+    for (int i = 0; i < w; i++)
+        addOutput(net + i, b[i]);
+
+    flush();
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_NETLIST_SIMULATOR_H__
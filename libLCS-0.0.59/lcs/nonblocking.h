@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NONBLOCKING_H__
+#define __LCS_NONBLOCKING_H__
+
+#include "systime.h"
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects open a nonblocking assignment region for the duration of their
+/// lifetime. The zero delay assignments made to lines while the region is open are
+/// buffered, and committed together as a single write group once all the zero delay
+/// changes pending at the time step have been made (see
+/// \p lcs::SystemTimer::beginNonblocking). The modules triggered by the same line event
+/// hence all see the states the lines had before the event, irrespective of the order in
+/// which they are notified, without having to add delays to their outputs. For example, a
+/// functional counter module can update its output on the positive edge of a clock as
+/// follows:
+///
+/// \code
+/// void Counter::onPosEdge(int portId)
+/// {
+///     NonblockingAssignment nba;
+///     outBus = outBus.toInt() + 1;
+/// }
+/// \endcode
+class NonblockingAssignment
+{
+public:
+
+    /// Opens a nonblocking assignment region.
+    ///
+    NonblockingAssignment(void) { SystemTimer::beginNonblocking(); }
+
+    /// Closes the nonblocking assignment region. The writes made in it are committed later
+    /// by the system timer.
+    ~NonblockingAssignment() { SystemTimer::endNonblocking(); }
+
+private:
+
+    /// Copying a nonblocking assignment region is not allowed.
+    ///
+    NonblockingAssignment(const NonblockingAssignment &nba);
+
+    /// Assigning a nonblocking assignment region is not allowed.
+    ///
+    NonblockingAssignment& operator=(const NonblockingAssignment &nba);
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_NONBLOCKING_H__
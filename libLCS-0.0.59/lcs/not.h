@@ -25,7 +25,7 @@
 #ifndef __LCS_NOT_H__
 #define __LCS_NOT_H__
 
-#include "module.h"
+#include "dyngate.h"
 #include "bus.h"
 
 namespace lcs
@@ -35,18 +35,8 @@ namespace lcs
 /// the NOT gate can only take a single line input bus. The template parameter \p delay
 /// indicates the propogation delay from the input to the output of the NOT gate.
 template <unsigned int delay = 0>
-class Not : public Module
+class Not : public DynGate
 {
-public:
-
-    /// A constant integer which denotes the port id for the input port/bus.
-    ///
-    static const int INPUT;
-
-    /// A constant integer which denotes the port id for the output bus/port.
-    ///
-    static const int OUTPUT;
-
 public:
 
     /// The only meaningfull constructor for the class.
@@ -59,45 +49,22 @@ public:
     ///
     Not(const Bus<1> &output, const InputBus<1> &input);
 
-    /// Destructor.
-    ///
-    virtual ~Not();
-
-    /// Propogates the input data line states to the output. This function is called
-    /// by the input bus line to notify the gate of a lcs::LINE_STATE_CHANGE event.
-    /// When notified, a NOT operation is performed on the line state of the data line
-    /// of the input bus and the result is propogated to the single line output bus.
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output is driven with the delay of the gate; see \p lcs::DynGate::onStateChange.
     virtual void onStateChange(int portId);
-
-private:
-    Bus<1> outBus;
-    InputBus<1> inBus;
 };
 
-template <unsigned int delay> const int Not<delay>::INPUT  = 0;
-template <unsigned int delay> const int Not<delay>::OUTPUT = 1;
-
 template <unsigned int delay>
 Not<delay>::Not(const Bus<1> &output, const InputBus<1> &input)
-    : Module(), outBus(output), inBus(input)
-{
-    inBus.notify(this, LINE_STATE_CHANGE, INPUT);
-    onStateChange(INPUT);
-}
-
-template <unsigned int delay>
-Not<delay>::~Not()
+    : DynGate(NOT_GATE, output, input, delay)
 {
-    inBus.stopNotification(this, LINE_STATE_CHANGE, INPUT);
+    setBatchEvaluator(&DynGate::evaluateBatch<delay>);
 }
 
 template <unsigned int delay>
 void Not<delay>::onStateChange(int portId)
 {
-    if (inBus == UNKNOWN || inBus == LOW || inBus == HIGH_IMPEDENCE)
-        outBus = (delay, HIGH);
-    else
-        outBus = (delay, LOW);
+    evaluate<delay>(portId);
 }
 
 } // End of namespace lcs
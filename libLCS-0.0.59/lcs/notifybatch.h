@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_NOTIFY_BATCH_H__
+#define __LCS_NOTIFY_BATCH_H__
+
+#include "linevent.h"
+#include "module.h"
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class which collects the line event notifications due to a group of line state
+/// changes, so that they can be delivered after all the changes in the group have been
+/// made. A module registered with several lines of the group for the same event is
+/// notified only once, whatever the ports at which the event occured. The notification
+/// carries the port id of the event if it occured on a single port, and \p lcs::ANY_PORT
+/// if it occured on more than one. Hence, a module which registers every net it reads
+/// with a port id of its own (as \p lcs::ContinuousAssignmentModule does) is evaluated
+/// once for all the nets of a group. The notifications are delivered in the order in
+/// which they were first collected.
+///
+/// A batch which groups the modules by type delivers the state change notifications of
+/// the modules which have batch evaluators (see \p lcs::Module::setBatchEvaluator)
+/// through a single call to every evaluator, after the other notifications. The state
+/// change notifications of the modules registered through \p lcs::InputBus::notifyBits
+/// carry the changes of the lines; the changes collected for a notification are delivered
+/// together through \p lcs::Module::onBitsChange. A user of libLCS will, under normal
+/// circumstances, never need to use this class directly.
+class NotificationBatch
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param groupTypes If \p true, the state change notifications are grouped by the
+    /// batch evaluators of the modules.
+    NotificationBatch(bool groupTypes = false) : groupTypes_(groupTypes) {}
+
+    /// Adds a notification of the event \p event to the module \p mod at the port
+    /// \p portId, unless a notification of the same event to the same module has already
+    /// been added.
+    void add(Module *mod, int portId, LineEvent event);
+
+    /// Adds a state change notification, which carries the line state change \p change,
+    /// to the module \p mod. The change is added to the state change notification of the
+    /// module if it has already been added. A notification to which notifications without
+    /// changes have also been added is delivered through \p lcs::Module::onStateChange.
+    void add(Module *mod, const BitChange &change);
+
+    /// Delivers all the collected notifications and empties the batch. Notifications
+    /// added while the notifications are being delivered go into the emptied batch.
+    void dispatch(void);
+
+    /// Returns the number of notifications collected.
+    ///
+    int size(void) const { return static_cast<int>(mods_.size()); }
+
+private:
+    std::vector<Module*> mods_;
+    std::vector<int> ports_;
+    std::vector<LineEvent> events_;
+    std::map< std::pair<Module*, int>, int > added_;
+    bool groupTypes_;
+
+    // Whether every notification carries line state changes, the changes, and the
+    // notification which carries every change.
+    std::vector<bool> bitsOnly_;
+    std::vector<BitChange> changes_;
+    std::vector<int> changeEntry_;
+
+    /// Returns the index of the notification of the event \p event to the module \p mod,
+    /// adding it at the port \p portId if it has not been added.
+    int find(Module *mod, int portId, LineEvent event, bool &added);
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_NOTIFY_BATCH_H__
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_OPT_PASS_H__
+#define __LCS_OPT_PASS_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the passes with which an \p lcs::NetlistOptimizer simplifies a flat
+/// netlist before it is simulated. All the passes are enabled by default.
+enum OptimizationPass
+{
+
+    /// The zero delay cells whose outputs are fixed by their constant inputs are replaced
+    /// by constant nets, and the constant inputs which do not fix the output of a cell are
+    /// dropped from its inputs.
+    CONSTANT_FOLDING   = 10240,
+
+    /// The zero delay buffers are removed, and the cells they drive read the input of the
+    /// buffer instead of its output.
+    BUFFER_COLLAPSING  = 10241,
+
+    /// Of the cells of the same type and delay with the same inputs, only one is kept, and
+    /// the cells driven by the others read its output instead.
+    STRUCTURAL_HASHING = 10242,
+
+    /// The cells which drive neither an output port nor a kept net, directly or through
+    /// other cells, are removed.
+    DEAD_LOGIC_REMOVAL = 10243
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_OPT_PASS_H__
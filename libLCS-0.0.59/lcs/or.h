@@ -25,7 +25,7 @@
 #ifndef __LCS_OR_H__
 #define __LCS_OR_H__
 
-#include "module.h"
+#include "dyngate.h"
 #include "bus.h"
 #include "linestate.h"
 
@@ -39,18 +39,8 @@ namespace lcs
 /// to N. The second template parameter indicates the propogation delay from the input
 /// to the output of the OR gate.
 template <unsigned int width = 1, unsigned int delay = 0>
-class Or : public Module
+class Or : public DynGate
 {
-public:
-
-    /// A constant integer which denotes the port id for the input port/bus.
-    ///
-    static const int INPUT;
-
-    /// A constant integer which denotes the port id for the output bus/port.
-    ///
-    static const int OUTPUT;
-
 public:
 
     /// The only meaningfull constructor for the class.
@@ -60,55 +50,29 @@ public:
     /// \param output The single line output bus of the gate.
     /// \param input The multiline input bus to the gate.
     /// \param width The number of lines in the input bus.
+    /// \param evaluation The manner in which the gate evaluates its output. See
+    /// \p lcs::GateEvaluation.
     ///
-    Or(const Bus<1> &output, const InputBus<width> &in1);
-
-    /// Destructor.
-    ///
-    virtual ~Or();
+    Or(const Bus<1> &output, const InputBus<width> &input,
+       GateEvaluation evaluation = AUTOMATIC_GATE_EVALUATION);
 
-    /// Propogates the input data line states to the output. This function is called
-    /// by the input bus lines to notify the gate of a lcs::LINE_STATE_CHANGE event.
-    /// When notified, an OR operation is performed on the line states of the data lines
-    /// of the input bus and the result is propogated to the single line output bus.
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output is driven with the delay of the gate; see \p lcs::DynGate::onStateChange.
     virtual void onStateChange(int portId);
-
-private:
-    Bus<1> outBus;
-    InputBus<width> inBus;
 };
 
-template <unsigned int width, unsigned int delay> const int Or<width, delay>::INPUT   = 0;
-template <unsigned int width, unsigned int delay> const int Or<width, delay>::OUTPUT  = 1;
-
 template <unsigned int width, unsigned int delay>
-Or<width, delay>::Or(const Bus<1>& output, const InputBus<width> &in)
-                    : Module(), outBus(output), inBus(in)
+Or<width, delay>::Or(const Bus<1> &output, const InputBus<width> &input,
+                     GateEvaluation evaluation)
+    : DynGate(OR_GATE, output, input, delay, evaluation)
 {
-    inBus.notify(this, LINE_STATE_CHANGE, INPUT);
-    onStateChange(INPUT);
-}
-
-template <unsigned int width, unsigned int delay>
-Or<width, delay>::~Or()
-{
-    inBus.stopNotification(this, LINE_STATE_CHANGE, INPUT);
+    setBatchEvaluator(&DynGate::evaluateBatch<delay>);
 }
 
 template <unsigned int width, unsigned int delay>
 void Or<width, delay>::onStateChange(int portId)
 {
-    for (unsigned int i = 0; i < width; i++)
-    {
-        if (inBus[i] == HIGH)
-        {
-            outBus[0] = (delay, HIGH);
-            return;
-        }
-    }
-
-    outBus[0] = (delay, LOW);
-    return;
+    evaluate<delay>(portId);
 }
 
 } // End of namespace lcs
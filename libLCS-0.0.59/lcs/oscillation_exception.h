@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_OSCILLATION_EXCEPTION_H__
+#define __LCS_OSCILLATION_EXCEPTION_H__
+
+#include "exception.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs.
+
+/// An exception class whose objects are thrown when the zero delay changes made at a time
+/// step do not settle within the delta cycle limit set using
+/// \p lcs::Simulation::setDeltaLimit. This happens when a zero delay combinational loop
+/// oscillates. The exception names the lines (or the nets of an
+/// \p lcs::NetlistSimulator) which kept changing after the limit was crossed; lines which
+/// were not named (see \p lcs::InputBus::setName) are only counted.
+class OscillationException : public Exception
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param time The time step at which the oscillation was found.
+    /// \param limit The delta cycle limit which was crossed.
+    /// \param names The names of the oscillating lines or nets.
+    /// \param unnamed The number of oscillating lines or nets which are not named.
+    OscillationException(unsigned int time, unsigned int limit,
+                         const std::vector<std::string> &names, int unnamed)
+        : Exception(), time_(time), limit_(limit), names_(names), unnamed_(unnamed) {}
+
+    /// Destructor.
+    ///
+    virtual ~OscillationException() {}
+
+    /// Returns a \p std::string message describing the error.
+    ///
+    virtual std::string getMessage(void)
+    {
+        std::ostringstream ss;
+        ss << "The zero delay changes at time " << time_ << " did not settle within "
+           << limit_ << " delta cycles. Oscillating lines:";
+
+        for (unsigned int i = 0; i < names_.size(); i++)
+            ss << (i == 0 ? " " : ", ") << names_[i];
+
+        if (unnamed_ > 0)
+            ss << (names_.size() == 0 ? " " : " and ") << unnamed_ << " unnamed";
+
+        ss << "\n";
+        return ss.str();
+    }
+
+    /// Returns the time step at which the oscillation was found.
+    ///
+    unsigned int getTime(void) const { return time_; }
+
+    /// Returns the names of the oscillating lines or nets which are named.
+    ///
+    const std::vector<std::string>& getNames(void) const { return names_; }
+
+    /// Returns the number of oscillating lines or nets which are not named.
+    ///
+    int getUnnamedCount(void) const { return unnamed_; }
+
+private:
+    unsigned int time_, limit_;
+    std::vector<std::string> names_;
+    int unnamed_;
+};
+
+} // End of namespace lcs.
+
+#endif // __LCS_OSCILLATION_EXCEPTION_H__
@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_READ_PORT_H__
+#define __LCS_READ_PORT_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the types of the read ports of the memory modules like \p lcs::RAM
+/// and \p lcs::ROM.
+enum ReadPortType
+{
+
+    /// The data output follows the word at the address input: it changes whenever the
+    /// address changes or the word at the address is written.
+    ASYNCHRONOUS_READ = 11264,
+
+    /// The word at the address input is read at the triggering edge of the clock of the
+    /// memory, and held at the data output until the next triggering edge. The word is
+    /// read before any of the writes made at the same edge.
+    SYNCHRONOUS_READ  = 11265
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_READ_PORT_H__
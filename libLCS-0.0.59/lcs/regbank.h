@@ -0,0 +1,197 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_REGISTER_BANK_H__
+#define __LCS_REGISTER_BANK_H__
+
+#include "dynbus.h"
+#include "inbus.h"
+#include "module.h"
+#include "outofrange_exception.h"
+#include "pulsedge.h"
+#include "shift.h"
+#include <vector>
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class (a \p lcs::Module derivative) whose objects hold a bank of registers triggered
+/// by the same clock. A bank subscribes to its clock only once, however many registers it
+/// holds, instead of once per register (as \p lcs::Register does) or once per bit (as a
+/// register built from \p lcs::DFlipFlop modules does). At every triggering edge of the
+/// clock, the bank first samples the inputs of all of its registers, and then drives the
+/// bits of their outputs which change, all in a single \p lcs::WriteGroup. Hence, the
+/// registers of a bank can be connected to each other (as in a pipeline) without any
+/// dependence on the order in which they were added.
+///
+/// A bank can hold registers of any widths, of three kinds:
+///
+/// - Parallel load registers (see \p lcs::RegisterBank::addRegister), which load the word
+///   on their input buses.
+/// - Shift registers (see \p lcs::RegisterBank::addShiftRegister), which shift in the bit
+///   on their serial input lines, as \p lcs::ShiftReg does.
+/// - Linear feedback shift registers (see \p lcs::RegisterBank::addLfsr), which shift left
+///   and shift in the XOR of their tapped bits.
+///
+/// A register can be given an enable input with \p lcs::RegisterBank::setEnable; such a
+/// register holds its contents at the edges at which its enable input is not
+/// \p lcs::HIGH. If the bank has a reset input, all the registers are loaded with their
+/// reset values as soon as the reset input becomes \p lcs::HIGH, and the edges are
+/// ignored as long as it stays \p lcs::HIGH (as with \p lcs::DFlipFlop); the registers
+/// start \p lcs::UNKNOWN. A bank without a reset input loads every register with its
+/// reset value (the seed of an LFSR) when the register is added. An unknown bit in a
+/// register stays unknown as it is shifted, and makes the feedback bit of an LFSR unknown
+/// if it is tapped.
+class RegisterBank : public Module
+{
+public:
+
+    /// Constructor.
+    ///
+    /// \param clk The clock of the bank.
+    /// \param edge The edge of the clock which triggers the registers.
+    /// \param delay The delay with which the outputs change after a triggering edge.
+    RegisterBank(const InputBus<1> &clk, PulseEdge edge = POS_EDGE, unsigned int delay = 0);
+
+    /// Constructs a bank with a reset input.
+    ///
+    /// \param clk The clock of the bank.
+    /// \param reset The active \p lcs::HIGH reset input of the bank.
+    /// \param edge The edge of the clock which triggers the registers.
+    /// \param delay The delay with which the outputs change after a triggering edge.
+    RegisterBank(const InputBus<1> &clk, const InputBus<1> &reset, PulseEdge edge = POS_EDGE,
+                 unsigned int delay = 0);
+
+    /// Destructor.
+    ///
+    virtual ~RegisterBank();
+
+    /// Adds a parallel load register to the bank, and returns its index. A
+    /// \p lcs::OutOfRangeException is thrown if the widths of \p out and \p in differ.
+    ///
+    /// \param out The output bus of the register.
+    /// \param in The input bus of the register.
+    /// \param resetValue The value which the register is loaded with at a reset, or when
+    /// it is added if the bank has no reset input.
+    int addRegister(const DynBus &out, const DynBus &in, unsigned long resetValue = 0)
+                    throw (OutOfRangeException<int>);
+
+    /// Adds a shift register to the bank, and returns its index.
+    ///
+    /// \param out The output bus of the register.
+    /// \param in The serial input line. Its state is shifted into bit 0 on a left shift,
+    /// and into the most significant bit on a right shift.
+    /// \param shift The direction of the shift.
+    /// \param resetValue The value which the register is loaded with at a reset, or when
+    /// it is added if the bank has no reset input.
+    int addShiftRegister(const DynBus &out, const InputBus<1> &in, Shift shift = LEFT_SHIFT,
+                         unsigned long resetValue = 0);
+
+    /// Adds a linear feedback shift register, in the Fibonacci form, to the bank and returns
+    /// its index. At every triggering edge, the register shifts left, and the XOR of the
+    /// bits selected by \p taps is shifted into bit 0. For example, a maximal length 16 bit
+    /// LFSR has the taps 0xB400 (bits 15, 13, 12 and 10). A \p lcs::OutOfRangeException is
+    /// thrown if the register is wider than an \p unsigned \p long.
+    ///
+    /// \param out The output bus of the register.
+    /// \param taps The mask of the bits which are fed back.
+    /// \param seed The value which the register is loaded with at a reset, or when it is
+    /// added if the bank has no reset input. An LFSR should not be seeded with zero, as it
+    /// then stays zero.
+    int addLfsr(const DynBus &out, unsigned long taps, unsigned long seed = 1)
+                throw (OutOfRangeException<int>);
+
+    /// Gives the register at the index \p index an enable input. A
+    /// \p lcs::OutOfRangeException is thrown if there is no such register.
+    void setEnable(int index, const InputBus<1> &enable) throw (OutOfRangeException<int>);
+
+    /// Returns the number of registers in the bank.
+    ///
+    int getRegisterCount(void) const { return static_cast<int>(regs_.size()); }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onPosEdge(int portId) { onEdge(); }
+
+    /// Internal function which will never be used by a user of libLCS.
+    ///
+    virtual void onNegEdge(int portId) { onEdge(); }
+
+    /// Internal function which will never be used by a user of libLCS. It is triggered
+    /// when the reset input changes.
+    virtual void onStateChange(int portId);
+
+private:
+
+    enum Kind { LOAD, SHIFT_LEFT, SHIFT_RIGHT, LFSR };
+
+    struct Reg
+    {
+        Reg(Kind k, const DynBus &o, const DynBus &i);
+
+        Kind kind;
+        DynBus out, in;
+        InputBus<1> *enable;
+        unsigned long taps;
+
+        // The contents, the contents at the next edge, the reset value and the states
+        // last driven on the output lines, as value and unknown planes.
+        std::vector<unsigned int> value, unknown, nextValue, nextUnknown, resetValue;
+        std::vector<unsigned int> drivenValue, drivenUnknown;
+    };
+
+    /// Copying a bank is not allowed.
+    ///
+    RegisterBank(const RegisterBank &bank);
+
+    /// Assigning a bank is not allowed.
+    ///
+    RegisterBank& operator=(const RegisterBank &bank);
+
+    int add(Reg *reg, unsigned long resetValue);
+
+    /// Loads the register \p reg with its reset value, and drives its output.
+    ///
+    void load(Reg &reg);
+
+    void onEdge(void);
+
+    /// Computes the contents of the register \p reg at the next edge.
+    ///
+    void sample(Reg &reg) const;
+
+    /// Drives the bits of the output of the register \p reg which differ from its contents.
+    ///
+    void drive(Reg &reg, unsigned int delay);
+
+    InputBus<1> clk_, reset_;
+    PulseEdge edge_;
+    unsigned int delay_;
+    bool hasReset_;
+    std::vector<Reg*> regs_;
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_REGISTER_BANK_H__
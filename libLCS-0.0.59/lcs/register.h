@@ -74,7 +74,7 @@ private:
 
     void onEdge(void)
     {
-        out_ = (delay, in_);
+        out_.template assign<delay>(in_);
     }
 
 };
@@ -79,14 +79,14 @@ private:
     {
         if (shift == LEFT_SHIFT)
         {
-            out_[0] = (delay, in_[0]);
+            out_.template set<delay>(0, in_.get(0));
             for (int i = 0; i < bits-1; i++)
-                out_[i+1] = (delay, out_[i]);
+                out_.template set<delay>(i+1, out_.get(i));
         }
         
         if (shift == RIGHT_SHIFT)
         {
-            out_[bits-1] = (delay, in_[0]);
+            out_.template set<delay>(bits-1, in_.get(0));
             for (int i = bits-2; i >= 0; i--)
                 out_[i] = out_[i+1];
         }
@@ -25,6 +25,8 @@
 #ifndef __LCS_SIMUL_H__
 #define __LCS_SIMUL_H__
 
+#include "evalmode.h"
+#include "oscillation_exception.h"
 #include "timeunit.h"
 #include <string>
 
@@ -37,8 +39,9 @@ class Simulation
 {
 public:
 
-    /// Starts the simulation.
-    ///
+    /// Starts the simulation. An \p lcs::OscillationException is thrown, and the simulation
+    /// is stopped, if the zero delay changes at a time step do not settle within the delta
+    /// cycle limit (see \p lcs::Simulation::setDeltaLimit).
     static void start(void);
 
     /// Sets the stop time of the simulation. The simulation, when started using the call
@@ -61,6 +64,46 @@ public:
     ///
     static void setTimeUnit(const TimeUnit &timeunit);
 
+    /// Enables or disables the expression graph mode. In this mode, the continuous assignments
+    /// made using \p lcs::Bus::cass are added to a single shared graph of bit level
+    /// expression nodes (see \p lcs::ExpressionGraph) instead of being translated into
+    /// individual hidden modules. Identical subexpressions used in different continuous
+    /// assignments are then evaluated only once per change of their operands. Continuous
+    /// assignments whose expressions cannot be represented in the graph (for example, the
+    /// ones which involve \p lcs::BitBuff objects) fall back to hidden modules. The mode
+    /// is disabled by default, and affects only the continuous assignments made after the
+    /// call.
+    ///
+    /// \param enable Pass \p true to enable the mode, \p false to disable it.
+    ///
+    static void setExpressionGraphMode(bool enable);
+
+    /// Sets the manner in which the modules are evaluated. In the \p lcs::DELTA_EVALUATION
+    /// mode, a module whose inputs change together (for example, the three inputs of a
+    /// \p lcs::FullAdder) is evaluated once, after all of them have changed, instead of once
+    /// for every input. This avoids the glitches on the module outputs due to the
+    /// intermediate evaluations, and the downstream evaluations they trigger. A module
+    /// notified of changes on more than one port is passed the port id \p lcs::ANY_PORT.
+    /// The \p lcs::BATCHED_EVALUATION mode further evaluates the dirty modules of a delta
+    /// cycle in groups of the same type, which is faster for designs with very many small
+    /// gates. The default is \p lcs::IMMEDIATE_EVALUATION.
+    ///
+    /// \param mode The desired evaluation mode.
+    ///
+    static void setEvaluationMode(const EvaluationMode &mode);
+
+    /// Sets the maximum number of delta cycles of zero delay changes allowed at a time
+    /// step. The changes made by zero delay modules in response to the changes of a delta
+    /// cycle form the next delta cycle; a zero delay combinational loop which oscillates
+    /// hence never runs out of delta cycles. When the limit is crossed, the simulation is
+    /// aborted with an \p lcs::OscillationException naming the lines which kept changing.
+    /// The same limit applies to the rounds of evaluation of the zero delay loops of an
+    /// \p lcs::NetlistSimulator. The default is 100000. Pass 0 to remove the limit.
+    ///
+    /// \param limit The maximum number of delta cycles per time step.
+    ///
+    static void setDeltaLimit(unsigned int limit);
+
 };
 
 } // End of namespace lcs
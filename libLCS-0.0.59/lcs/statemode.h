@@ -0,0 +1,58 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_STATE_MODE_H__
+#define __LCS_STATE_MODE_H__
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// An enumeration of the sets of line states with which an \p lcs::NetlistSimulator can
+/// simulate a netlist.
+enum StateMode
+{
+
+    /// Every net can take any of the four line states (see \p lcs::LineState). This is
+    /// the default.
+    FOUR_STATE_SIMULATION         = 13312,
+
+    /// Every net is a single bit, which is either \p lcs::LOW or \p lcs::HIGH, and every
+    /// cell is evaluated with boolean tests on the bits of its inputs. The \p lcs::UNKNOWN and
+    /// \p lcs::HIGH_IMPEDENCE states, of the bound inputs and of the initial states of the
+    /// nets, are taken as \p lcs::LOW. This suits the designs in which these states do not
+    /// occur after reset.
+    TWO_STATE_SIMULATION          = 13313,
+
+    /// The nets are simulated as in the \p lcs::TWO_STATE_SIMULATION mode, while a record
+    /// of the nets which would have been in an unknown state is also kept. The first time
+    /// an \p lcs::UNKNOWN or \p lcs::HIGH_IMPEDENCE state is produced, by a change of a
+    /// bound input or by a cell, is reported (see
+    /// \p lcs::NetlistSimulator::getFirstUnknownNet).
+    CHECKED_TWO_STATE_SIMULATION  = 13314
+
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_STATE_MODE_H__
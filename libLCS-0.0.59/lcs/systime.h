@@ -25,15 +25,24 @@
 #ifndef __LCS_SYS_TIME_H__
 #define __LCS_SYS_TIME_H__
 
+#include "evalmode.h"
+#include "linestate.h"
 #include "list.h"
+#include "oscillation_exception.h"
 #include "queue.h"
 #include "tickListener.h"
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace lcs
 { // Start of namespace lcs
 
 class Clock;
 class Line;
+class NotificationBatch;
 
 /// A class which manages the timing for the simulation of the digital system built using
 /// libLCS. This class is a time keeper which keeps the various other objects in the system
@@ -60,6 +69,21 @@ public:
     ///
     static void notifyTick(TickListener *tl);
 
+    /// An object which is an instance of a derivative of the class \p lcs::TickListener
+    /// can register through this function to be notified of every time tick as soon as the
+    /// lines scheduled to change at that time have changed, and before any zero delay
+    /// change is processed. Unlike the objects registered through
+    /// \p lcs::SystemTimer::notifyTick, which are notified at the end of a time tick, these
+    /// objects can make zero delay changes which take effect at the same time tick.
+    ///
+    /// \param tl Pointer to the object which is to be notified.
+    static void notifyUpdate(TickListener *tl);
+
+    /// A \p lcs::TickListener derivative registered through
+    /// \p lcs::SystemTimer::notifyUpdate should de-register using this function before it
+    /// ceases to exist.
+    static void stopUpdateNotification(TickListener *tl);
+
     /// A \p lcs::Line object should request for time tick notification through this
     /// function.
     ///
@@ -96,6 +120,47 @@ public:
     /// exist in the simulation system. Else, a segmentation fault is bound to occur.
     static void stopTickNotification(TickListener *tl);
 
+    /// Opens a write group. The zero delay line state changes requested until the matching
+    /// call to \p lcs::SystemTimer::endWriteGroup are made together, and the modules driven
+    /// by the changed lines are notified only after all of them have been made. Calls to
+    /// this function can be nested. It is more convenient to use an \p lcs::WriteGroup
+    /// object than to call this function directly.
+    static void beginWriteGroup(void);
+
+    /// Closes a write group opened by a call to \p lcs::SystemTimer::beginWriteGroup.
+    ///
+    static void endWriteGroup(void);
+
+    /// Opens a nonblocking assignment region. The zero delay line state changes requested
+    /// until the matching call to \p lcs::SystemTimer::endNonblocking are not made at once;
+    /// they are buffered, and committed together, as a single write group, when all the
+    /// pending zero delay changes of the time step have been made. The modules triggered
+    /// by a line event hence see the states the lines had before any of them wrote its
+    /// outputs, irrespective of the order in which they are notified. If a line is written
+    /// more than once before the commit, the last write wins. Changes with non-zero delay
+    /// are not affected. Calls to this function can be nested. It is more convenient to use
+    /// an \p lcs::NonblockingAssignment object than to call this function directly.
+    static void beginNonblocking(void);
+
+    /// Closes a nonblocking assignment region opened by a call to
+    /// \p lcs::SystemTimer::beginNonblocking.
+    static void endNonblocking(void);
+
+    // This function is used by the class Line. It buffers a zero delay write made in a
+    // nonblocking assignment region, and returns false if no region is open.
+    static bool deferWrite(List<Line*> *refList, const LineState &value);
+
+    /// Returns the maximum number of delta cycles of zero delay changes allowed at a time
+    /// step. See \p lcs::Simulation::setDeltaLimit.
+    static unsigned int getDeltaLimit(void) { return deltaLimit; }
+
+    // These functions are used by the class Line to manage the names with which the lines
+    // are referred to in the oscillation diagnostics. A line is identified by its
+    // reference list, which is shared by all the copies of the line.
+    static void nameLine(List<Line*> *refList, const std::string &name);
+
+    static void forgetLine(List<Line*> *refList);
+
 private:
 
     static void start(void);
@@ -104,21 +169,62 @@ private:
 
     static void setStopTime(const unsigned int stopTime);
 
+    static void setEvaluationMode(const EvaluationMode &mode);
+
+    static void setDeltaLimit(unsigned int limit);
+
     static void updateHiddenDelays(void);
 
+    static void updateHiddenLine(NotificationBatch *batch);
+
+    static void nextDelta(unsigned int &deltas) throw (OscillationException);
+
+    static void oscillate(void) throw (OscillationException);
+
+    static void clearHiddenQueue(void);
+
+    static bool commitNonblocking(void);
+
     static unsigned int stoptime;
 
     static unsigned int time;
 
     static unsigned int hiddenTime;
 
+    static EvaluationMode evalMode;
+
     static Clock *clock;
 
     static List< TickListener* > tlList;
 
+    static List< TickListener* > ulList;
+
     static List< List<Line*>* > refLists;
 
     static Queue< List<Line*>* > hiddenQueue;
+
+    // The write group of each entry in hiddenQueue; 0 for entries outside of a group.
+    static Queue< unsigned int > hiddenGroupQueue;
+
+    static unsigned int writeGroup;
+
+    static unsigned int writeGroupDepth;
+
+    static unsigned int lastWriteGroup;
+
+    static unsigned int deltaLimit;
+
+    static unsigned int nonblockingDepth;
+
+    // The writes buffered in nonblocking assignment regions, in the order they were made.
+    static std::vector< std::pair< List<Line*>*, LineState > > nonblockingWrites;
+
+    // The lines updated in the delta cycles run after the delta limit was crossed.
+    static std::set< List<Line*>* > traced;
+
+    static bool tracing;
+
+    static std::map< List<Line*>*, std::string > lineNames;
 };
 
 } // End of namespace lcs
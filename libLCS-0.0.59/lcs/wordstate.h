@@ -0,0 +1,488 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_WORD_STATE_H__
+#define __LCS_WORD_STATE_H__
+
+#include "linestate.h"
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class which holds the line states of a \p bits wide word as two packed bit planes:
+/// a value plane and an unknown plane. A bit whose unknown plane bit is clear is either
+/// \p lcs::LOW or \p lcs::HIGH as given by its value plane bit. A bit whose unknown
+/// plane bit is set is \p lcs::UNKNOWN (value plane bit clear) or \p lcs::HIGH_IMPEDENCE
+/// (value plane bit set). The arithmetic, comparison and shift expressions evaluate on
+/// objects of this class, a whole word at a time. A user of libLCS will, under normal
+/// circumstances, never need to use this class directly.
+///
+/// Arithmetic operations propagate unknown states conservatively: every result bit at or
+/// above the lowest unknown bit of the operands is \p lcs::UNKNOWN. Comparisons and
+/// reductions result in \p lcs::UNKNOWN if they depend on an unknown bit.
+template <int bits>
+class WordState
+{
+public:
+
+    /// The number of 32 bit limbs in each of the planes.
+    ///
+    enum { LIMBS = (bits + 31) / 32 };
+
+    /// Default constructor. All the bits are initialised to \p lcs::LOW.
+    ///
+    WordState(void);
+
+    /// Initialises the word with the binary equivalent of the unsigned value \p value.
+    ///
+    explicit WordState(unsigned int value);
+
+    /// Initialises the word from a word of a different width. The narrower word is zero
+    /// extended, or the wider word is truncated.
+    template <int w>
+    explicit WordState(const WordState<w> &word);
+
+    /// Returns the state of the bit at the index \p index.
+    ///
+    const LineState get(int index) const;
+
+    /// Sets the state of the bit at the index \p index.
+    ///
+    void set(int index, const LineState &state);
+
+    /// Returns the index of the lowest bit which is not \p lcs::LOW or \p lcs::HIGH. Returns
+    /// \p bits if all the bits are known.
+    int firstUnknown(void) const;
+
+    /// Returns \p true if none of the bits are \p lcs::UNKNOWN or \p lcs::HIGH_IMPEDENCE.
+    ///
+    bool isKnown(void) const { return firstUnknown() == bits; }
+
+    /// Makes all the bits from the index \p index upwards \p lcs::UNKNOWN.
+    ///
+    void setUnknownFrom(int index);
+
+    /// Returns the value plane limb at the index \p k.
+    ///
+    unsigned int limb(int k) const { return value_[k]; }
+
+    /// Returns the unknown plane limb at the index \p k.
+    ///
+    unsigned int unknownLimb(int k) const { return unknown_[k]; }
+
+    /// Sets the value and unknown plane limbs at the index \p k. The bits of the top limb
+    /// which lie beyond the width of the word are ignored.
+    void setLimb(int k, unsigned int value, unsigned int unknown);
+
+    /// Returns the word as a non-negative integer. Returns -1 if the word is not known or
+    /// if its value does not fit in an \p int.
+    int toInt(void) const;
+
+    /// Returns the sum of this word and \p word.
+    ///
+    const WordState<bits> add(const WordState<bits> &word) const;
+
+    /// Returns the two's complement difference of this word and \p word.
+    ///
+    const WordState<bits> subtract(const WordState<bits> &word) const;
+
+    /// Returns the product of this word and \p word, truncated to \p bits bits.
+    ///
+    const WordState<bits> multiply(const WordState<bits> &word) const;
+
+    /// Returns the word shifted left by the number of bits given by the word \p amount.
+    ///
+    template <int w>
+    const WordState<bits> shiftLeft(const WordState<w> &amount) const;
+
+    /// Returns the word shifted right (logically) by the number of bits given by the word
+    /// \p amount.
+    template <int w>
+    const WordState<bits> shiftRight(const WordState<w> &amount) const;
+
+    /// Compares this word with \p word as unsigned numbers. Returns a negative number, zero
+    /// or a positive number if this word is less than, equal to or greater than \p word.
+    /// The result is meaningless if either of the words is not known.
+    int compare(const WordState<bits> &word) const;
+
+    /// Returns the AND of all the bits of the word.
+    ///
+    const LineState andReduce(void) const;
+
+    /// Returns the OR of all the bits of the word.
+    ///
+    const LineState orReduce(void) const;
+
+    /// Returns the XOR of all the bits of the word.
+    ///
+    const LineState xorReduce(void) const;
+
+private:
+
+    template <int w>
+    friend class WordState;
+
+    /// Clears the bits of the top limbs which lie beyond the width of the word.
+    ///
+    void mask(void);
+
+    /// Returns the shift amount held by the word \p amount, or \p bits if the amount is
+    /// equal to or more than \p bits.
+    template <int w>
+    static int shiftAmount(const WordState<w> &amount);
+
+    unsigned int value_[LIMBS];
+    unsigned int unknown_[LIMBS];
+};
+
+template <int bits>
+WordState<bits>::WordState(void)
+{
+    for (int k = 0; k < LIMBS; k++)
+    {
+        value_[k] = 0;
+        unknown_[k] = 0;
+    }
+}
+
+template <int bits>
+WordState<bits>::WordState(unsigned int value)
+{
+    for (int k = 0; k < LIMBS; k++)
+    {
+        value_[k] = 0;
+        unknown_[k] = 0;
+    }
+
+    value_[0] = value;
+    mask();
+}
+
+template <int bits>
+template <int w>
+WordState<bits>::WordState(const WordState<w> &word)
+{
+    for (int k = 0; k < LIMBS; k++)
+    {
+        if (k < WordState<w>::LIMBS)
+        {
+            value_[k] = word.value_[k];
+            unknown_[k] = word.unknown_[k];
+        }
+        else
+        {
+            value_[k] = 0;
+            unknown_[k] = 0;
+        }
+    }
+
+    mask();
+}
+
+template <int bits>
+const LineState WordState<bits>::get(int index) const
+{
+    unsigned int m = 1u << (index % 32);
+    int k = index / 32;
+
+    int state = ((value_[k] & m) ? 1 : 0) | ((unknown_[k] & m) ? 2 : 0);
+    return static_cast<LineState>(state);
+}
+
+template <int bits>
+void WordState<bits>::set(int index, const LineState &state)
+{
+    unsigned int m = 1u << (index % 32);
+    int k = index / 32;
+
+    if (state & 1)
+        value_[k] |= m;
+    else
+        value_[k] &= ~m;
+
+    if (state & 2)
+        unknown_[k] |= m;
+    else
+        unknown_[k] &= ~m;
+}
+
+template <int bits>
+void WordState<bits>::setLimb(int k, unsigned int value, unsigned int unknown)
+{
+    value_[k] = value;
+    unknown_[k] = unknown;
+
+    if (k == LIMBS-1)
+        mask();
+}
+
+template <int bits>
+int WordState<bits>::firstUnknown(void) const
+{
+    for (int k = 0; k < LIMBS; k++)
+    {
+        if (unknown_[k] == 0)
+            continue;
+
+        for (int i = 0; i < 32; i++)
+        {
+            if (unknown_[k] & (1u << i))
+                return k*32 + i;
+        }
+    }
+
+    return bits;
+}
+
+template <int bits>
+int WordState<bits>::toInt(void) const
+{
+    if (!isKnown())
+        return -1;
+
+    for (int k = 1; k < LIMBS; k++)
+    {
+        if (value_[k] != 0)
+            return -1;
+    }
+
+    if (value_[0] > 0x7fffffffu)
+        return -1;
+
+    return static_cast<int>(value_[0]);
+}
+
+template <int bits>
+void WordState<bits>::setUnknownFrom(int index)
+{
+    for (int i = index; i < bits; i++)
+        set(i, UNKNOWN);
+}
+
+template <int bits>
+void WordState<bits>::mask(void)
+{
+    if (bits % 32 != 0)
+    {
+        unsigned int m = (1u << (bits % 32)) - 1;
+        value_[LIMBS-1] &= m;
+        unknown_[LIMBS-1] &= m;
+    }
+}
+
+template <int bits>
+const WordState<bits> WordState<bits>::add(const WordState<bits> &word) const
+{
+    WordState<bits> result;
+    unsigned long long carry = 0;
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        unsigned long long sum = static_cast<unsigned long long>(value_[k]) + word.value_[k] + carry;
+        result.value_[k] = static_cast<unsigned int>(sum);
+        carry = sum >> 32;
+    }
+
+    result.mask();
+
+    int u = firstUnknown(), v = word.firstUnknown();
+    result.setUnknownFrom(u < v ? u : v);
+
+    return result;
+}
+
+template <int bits>
+const WordState<bits> WordState<bits>::subtract(const WordState<bits> &word) const
+{
+    WordState<bits> result;
+    unsigned long long carry = 1;
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        unsigned long long sum = static_cast<unsigned long long>(value_[k]) + (~word.value_[k]) + carry;
+        result.value_[k] = static_cast<unsigned int>(sum);
+        carry = sum >> 32;
+    }
+
+    result.mask();
+
+    int u = firstUnknown(), v = word.firstUnknown();
+    result.setUnknownFrom(u < v ? u : v);
+
+    return result;
+}
+
+template <int bits>
+const WordState<bits> WordState<bits>::multiply(const WordState<bits> &word) const
+{
+    WordState<bits> result;
+
+    for (int i = 0; i < LIMBS; i++)
+    {
+        unsigned long long carry = 0;
+
+        for (int j = 0; i + j < LIMBS; j++)
+        {
+            unsigned long long p = static_cast<unsigned long long>(value_[i]) * word.value_[j]
+                                   + result.value_[i+j] + carry;
+            result.value_[i+j] = static_cast<unsigned int>(p);
+            carry = p >> 32;
+        }
+    }
+
+    result.mask();
+
+    int u = firstUnknown(), v = word.firstUnknown();
+    result.setUnknownFrom(u < v ? u : v);
+
+    return result;
+}
+
+template <int bits>
+template <int w>
+int WordState<bits>::shiftAmount(const WordState<w> &amount)
+{
+    for (int k = 1; k < WordState<w>::LIMBS; k++)
+    {
+        if (amount.value_[k] != 0)
+            return bits;
+    }
+
+    if (amount.value_[0] >= static_cast<unsigned int>(bits))
+        return bits;
+
+    return static_cast<int>(amount.value_[0]);
+}
+
+template <int bits>
+template <int w>
+const WordState<bits> WordState<bits>::shiftLeft(const WordState<w> &amount) const
+{
+    WordState<bits> result;
+
+    if (!amount.isKnown())
+    {
+        result.setUnknownFrom(0);
+        return result;
+    }
+
+    int n = shiftAmount(amount);
+    for (int i = bits-1; i >= n; i--)
+        result.set(i, get(i-n));
+
+    return result;
+}
+
+template <int bits>
+template <int w>
+const WordState<bits> WordState<bits>::shiftRight(const WordState<w> &amount) const
+{
+    WordState<bits> result;
+
+    if (!amount.isKnown())
+    {
+        result.setUnknownFrom(0);
+        return result;
+    }
+
+    int n = shiftAmount(amount);
+    for (int i = 0; i + n < bits; i++)
+        result.set(i, get(i+n));
+
+    return result;
+}
+
+template <int bits>
+int WordState<bits>::compare(const WordState<bits> &word) const
+{
+    for (int k = LIMBS-1; k >= 0; k--)
+    {
+        if (value_[k] < word.value_[k])
+            return -1;
+        else if (value_[k] > word.value_[k])
+            return 1;
+    }
+
+    return 0;
+}
+
+template <int bits>
+const LineState WordState<bits>::andReduce(void) const
+{
+    bool unknown = false;
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        unsigned int m = (k == LIMBS-1 && bits % 32 != 0) ? (1u << (bits % 32)) - 1 : ~0u;
+
+        if ((~value_[k] & ~unknown_[k] & m) != 0)
+            return LOW;
+        if (unknown_[k] != 0)
+            unknown = true;
+    }
+
+    return unknown ? UNKNOWN : HIGH;
+}
+
+template <int bits>
+const LineState WordState<bits>::orReduce(void) const
+{
+    bool unknown = false;
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        if ((value_[k] & ~unknown_[k]) != 0)
+            return HIGH;
+        if (unknown_[k] != 0)
+            unknown = true;
+    }
+
+    return unknown ? UNKNOWN : LOW;
+}
+
+template <int bits>
+const LineState WordState<bits>::xorReduce(void) const
+{
+    unsigned int parity = 0;
+
+    for (int k = 0; k < LIMBS; k++)
+    {
+        if (unknown_[k] != 0)
+            return UNKNOWN;
+
+        parity ^= value_[k];
+    }
+
+    parity ^= parity >> 16;
+    parity ^= parity >> 8;
+    parity ^= parity >> 4;
+    parity ^= parity >> 2;
+    parity ^= parity >> 1;
+
+    return (parity & 1) ? HIGH : LOW;
+}
+
+} // End of namespace lcs
+
+#endif // __LCS_WORD_STATE_H__
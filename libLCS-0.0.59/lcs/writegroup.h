@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LCS_WRITE_GROUP_H__
+#define __LCS_WRITE_GROUP_H__
+
+#include "systime.h"
+
+namespace lcs
+{ // Start of namespace lcs
+
+/// A class whose objects open a write group for the duration of their lifetime. The zero
+/// delay assignments made to lines while a write group is open form a single group: all
+/// the lines in the group take their new states first, and the modules registered with
+/// them are notified afterwards, each module only once per event, whatever the ports at
+/// which the event occured (see \p lcs::NotificationBatch). Hence, a module never sees a
+/// partially updated set of busses written in a group. Every assignment to an
+/// \p lcs::Bus object is a write group by itself. Write groups can be nested, in which
+/// case all the assignments made in the outermost group form a single group. For example,
+/// to apply a new stimulus to two busses as a single step:
+///
+/// \code
+/// {
+///     WriteGroup group;
+///     a = 5;
+///     b = 3;
+/// }
+/// \endcode
+class WriteGroup
+{
+public:
+
+    /// Opens a write group.
+    ///
+    WriteGroup(void) { SystemTimer::beginWriteGroup(); }
+
+    /// Closes the write group.
+    ///
+    ~WriteGroup() { SystemTimer::endWriteGroup(); }
+
+private:
+
+    /// Copying a write group is not allowed.
+    ///
+    WriteGroup(const WriteGroup &group);
+
+    /// Assigning a write group is not allowed.
+    ///
+    WriteGroup& operator=(const WriteGroup &group);
+};
+
+} // End of namespace lcs
+
+#endif // __LCS_WRITE_GROUP_H__
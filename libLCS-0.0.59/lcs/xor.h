@@ -25,7 +25,7 @@
 #ifndef __LCS_XOR_H__
 #define __LCS_XOR_H__
 
-#include "module.h"
+#include "dyngate.h"
 #include "bus.h"
 
 namespace lcs
@@ -38,18 +38,10 @@ namespace lcs
 /// to N. The second template parameter indicates the propogation delay from the input
 /// to the output of the XOR gate.
 template <unsigned int width = 1, unsigned int delay = 0>
-class Xor : public Module
+class Xor : public DynGate
 {
 public:
 
-    /// A constant integer which denotes the port id for the input port/bus.
-    ///
-    static const int INPUT;
-
-    /// A constant integer which denotes the port id for the output bus/port.
-    ///
-    static const int OUTPUT;
-
     /// The only meaningfull constructor for the class.
     /// A default constructor is not explicitly provided. Moreover, the one synthesized
     /// by the compiler is practically useless.
@@ -57,57 +49,29 @@ public:
     /// \param output The single line output bus of the gate.
     /// \param input The multiline input bus to the gate.
     /// \param width The number of lines in the input bus.
+    /// \param evaluation The manner in which the gate evaluates its output. See
+    /// \p lcs::GateEvaluation.
     ///
-    Xor(const Bus<1> &output, const InputBus<width> &input);
+    Xor(const Bus<1> &output, const InputBus<width> &input,
+        GateEvaluation evaluation = AUTOMATIC_GATE_EVALUATION);
 
-    /// Destructor.
-    ///
-    virtual ~Xor();
-
-    /// Propogates the input data line states to the output. This function is called
-    /// by the input bus lines to notify the gate of a lcs::LINE_STATE_CHANGE event.
-    /// When notified, an XOR operation is performed on the line states of the data lines
-    /// of the input bus and the result is propogated to the single line output bus.
+    /// This function is triggered when the state of any of the input lines changes. The
+    /// output is driven with the delay of the gate; see \p lcs::DynGate::onStateChange.
     virtual void onStateChange(int portId);
-
-private:
-    Bus<1> outBus;
-    InputBus<width> inBus;
 };
 
-template <unsigned int width, unsigned int delay> const int Xor<width, delay>::INPUT   = 0;
-template <unsigned int width, unsigned int delay> const int Xor<width, delay>::OUTPUT  = 1;
-
 template <unsigned int width, unsigned int delay>
-Xor<width, delay>::Xor(const Bus<1> &output, const InputBus<width> &input)
-            : Module(), outBus(output), inBus(input)
+Xor<width, delay>::Xor(const Bus<1> &output, const InputBus<width> &input,
+                       GateEvaluation evaluation)
+    : DynGate(XOR_GATE, output, input, delay, evaluation)
 {
-    inBus.notify(this, LINE_STATE_CHANGE, INPUT);
-    onStateChange(INPUT);
-}
-
-template <unsigned int width, unsigned int delay>
-Xor<width, delay>::~Xor()
-{
-    inBus.stopNotification(this, LINE_STATE_CHANGE, INPUT);
+    setBatchEvaluator(&DynGate::evaluateBatch<delay>);
 }
 
 template <unsigned int width, unsigned int delay>
 void Xor<width, delay>::onStateChange(int portId)
 {
-    int highCount = 0;
-    for (int i = 0; i < width; i++)
-    {
-        if (inBus[i] == HIGH)
-            highCount++;
-    }
-
-    if (highCount == 1)
-        outBus[0] = (delay, HIGH);
-    else
-        outBus[0] = (delay, LOW);
-
-    return;
+    evaluate<delay>(portId);
 }
 
 } // End of namespace lcs
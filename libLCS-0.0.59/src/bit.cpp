@@ -102,6 +102,9 @@ Bit& Bit::operator=(const Bit& rhs)
 
 void Bit::operator=(const LineState &rhs)
 {
+    if (*state_ == rhs)
+        return;
+
     *state_ = rhs;
 
     ListIterator<Module*> iter = modList.getListIterator();
@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/bitdepmap.h>
+#include <lcs/line.h>
+#include <lcs/hiddenmodman.h>
+
+using namespace lcs;
+
+BitDependencyMap::BitDependencyMap(Module *mod, bool dynamic)
+    : mod_(mod), dynamic_(dynamic), control_(false)
+{}
+
+BitDependencyMap::~BitDependencyMap()
+{
+    // The module of a map destroyed along with the other hidden modules is de-registered
+    // from the nets in bulk later.
+    bool detach = HiddenModuleManager::isDestroying();
+
+    for (unsigned int i = 0; i < nets_.size(); i++)
+    {
+        if (active_[i] && detach)
+        {
+            HiddenModuleManager::detachLine(nets_[i]);
+            continue;
+        }
+
+        if (active_[i])
+            nets_[i]->stopNotification(LINE_STATE_CHANGE, mod_, static_cast<int>(i)+1);
+
+        delete nets_[i];
+    }
+}
+
+void BitDependencyMap::add(const Line &line, int outBit)
+{
+    std::map<const void*, int>::iterator iter = index_.find(line.val);
+    int netIndex;
+
+    if (iter == index_.end())
+    {
+        netIndex = static_cast<int>(nets_.size());
+        index_[line.val] = netIndex;
+
+        Line *net = new Line(line);
+        nets_.push_back(net);
+        bits_.push_back(std::vector<int>());
+        active_.push_back(true);
+        used_.push_back(true);
+        isControl_.push_back(control_);
+
+        net->notify(LINE_STATE_CHANGE, mod_, netIndex+1);
+    }
+    else
+    {
+        netIndex = iter->second;
+
+        if (!active_[netIndex])
+        {
+            active_[netIndex] = true;
+            nets_[netIndex]->notify(LINE_STATE_CHANGE, mod_, netIndex+1);
+        }
+
+        used_[netIndex] = true;
+        if (control_)
+            isControl_[netIndex] = true;
+    }
+
+    std::vector<int> &bits = bits_[netIndex];
+    if (bits.size() == 0 || bits.back() != outBit)
+        bits.push_back(outBit);
+}
+
+int BitDependencyMap::bitCount(int portId) const
+{
+    if (portId < 1 || portId > static_cast<int>(bits_.size()))
+        return 0;
+
+    return static_cast<int>(bits_[portId-1].size());
+}
+
+bool BitDependencyMap::setControl(bool control)
+{
+    bool previous = control_;
+    control_ = control;
+
+    return previous;
+}
+
+bool BitDependencyMap::isControl(int portId) const
+{
+    if (portId < 1 || portId > static_cast<int>(isControl_.size()))
+        return false;
+
+    return isControl_[portId-1];
+}
+
+void BitDependencyMap::beginUpdate(void)
+{
+    for (unsigned int i = 0; i < nets_.size(); i++)
+    {
+        used_[i] = false;
+        isControl_[i] = false;
+        bits_[i].clear();
+    }
+}
+
+void BitDependencyMap::endUpdate(void)
+{
+    for (unsigned int i = 0; i < nets_.size(); i++)
+    {
+        if (active_[i] && !used_[i])
+        {
+            nets_[i]->stopNotification(LINE_STATE_CHANGE, mod_, static_cast<int>(i)+1);
+            active_[i] = false;
+        }
+    }
+}
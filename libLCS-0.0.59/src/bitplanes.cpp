@@ -0,0 +1,179 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/bitplanes.h>
+
+using namespace lcs;
+using namespace std;
+
+BitPlanes::BitPlanes(int width)
+    : value_((width + 31) / 32, 0), unknown_((width + 31) / 32, ~0u),
+      width_(width), refCount_(1)
+{}
+
+void BitPlanes::release(void)
+{
+    if (--refCount_ <= 0)
+        delete this;
+}
+
+const LineState BitPlanes::get(int index) const
+{
+    unsigned int m = 1u << (index % 32);
+    int k = index / 32;
+
+    int state = ((value_[k] & m) ? 1 : 0) | ((unknown_[k] & m) ? 2 : 0);
+    return static_cast<LineState>(state);
+}
+
+unsigned int BitPlanes::extract(const vector<unsigned int> &plane, int pos, int count)
+{
+    int k = pos / 32, s = pos % 32;
+
+    unsigned long long bits = plane[k];
+    if (s + count > 32)
+        bits |= static_cast<unsigned long long>(plane[k+1]) << 32;
+
+    bits >>= s;
+    if (count < 32)
+        bits &= (1u << count) - 1;
+
+    return static_cast<unsigned int>(bits);
+}
+
+void BitPlanes::deposit(vector<unsigned int> &plane, int pos, int count, unsigned int bits)
+{
+    int k = pos / 32, s = pos % 32;
+    unsigned long long m = (count < 32) ? ((1ull << count) - 1) : 0xffffffffull;
+
+    unsigned long long old = plane[k];
+    if (s + count > 32)
+        old |= static_cast<unsigned long long>(plane[k+1]) << 32;
+
+    unsigned long long word = (old & ~(m << s)) | ((bits & m) << s);
+
+    plane[k] = static_cast<unsigned int>(word);
+    if (s + count > 32)
+        plane[k+1] = static_cast<unsigned int>(word >> 32);
+}
+
+void BitPlanes::read(int offset, int count, unsigned int *value, unsigned int *unknown) const
+{
+    for (int i = 0; i < count; i += 32)
+    {
+        int n = (count - i < 32) ? count - i : 32;
+        value[i/32] = extract(value_, offset + i, n);
+        unknown[i/32] = extract(unknown_, offset + i, n);
+    }
+}
+
+void BitPlanes::write(int offset, int count, const unsigned int *value, const unsigned int *unknown)
+{
+    // The bits which change, relative to offset.
+    vector<unsigned int> changed((count + 31) / 32, 0);
+    bool anyChange = false;
+
+    for (int i = 0; i < count; i += 32)
+    {
+        int n = (count - i < 32) ? count - i : 32;
+        unsigned int m = (n < 32) ? (1u << n) - 1 : ~0u;
+
+        unsigned int v = value[i/32] & m, u = unknown[i/32] & m;
+        changed[i/32] = (extract(value_, offset + i, n) ^ v) | (extract(unknown_, offset + i, n) ^ u);
+
+        if (changed[i/32] != 0)
+        {
+            deposit(value_, offset + i, n, v);
+            deposit(unknown_, offset + i, n, u);
+            anyChange = true;
+        }
+    }
+
+    if (!anyChange)
+        return;
+
+    // The modules are collected before any of them is notified, as a module may register
+    // or write to the bits when it is notified.
+    vector<Module*> mods;
+    for (unsigned int k = 0; k < subscribers_.size(); k++)
+    {
+        const Subscriber &sub = subscribers_[k];
+
+        int first = (sub.first > offset) ? sub.first : offset;
+        int last = (sub.first + sub.count < offset + count) ? sub.first + sub.count : offset + count;
+
+        bool hit = false;
+        for (int i = first; i < last && !hit; i += 32)
+        {
+            int n = (last - i < 32) ? last - i : 32;
+            hit = extract(changed, i - offset, n) != 0;
+        }
+
+        if (!hit)
+            continue;
+
+        unsigned int j = 0;
+        while (j < mods.size() && mods[j] != sub.mod)
+            j++;
+
+        if (j == mods.size())
+            mods.push_back(sub.mod);
+    }
+
+    for (unsigned int j = 0; j < mods.size(); j++)
+        mods[j]->onStateChange(0);
+}
+
+void BitPlanes::notify(Module *mod, int first, int count)
+{
+    if (mod == NULL || first < 0 || count <= 0 || first + count > width_)
+        return;
+
+    for (unsigned int k = 0; k < subscribers_.size(); k++)
+    {
+        const Subscriber &sub = subscribers_[k];
+        if (sub.mod == mod && sub.first == first && sub.count == count)
+            return;
+    }
+
+    Subscriber sub;
+    sub.mod = mod;
+    sub.first = first;
+    sub.count = count;
+
+    subscribers_.push_back(sub);
+}
+
+void BitPlanes::stopNotification(Module *mod, int first, int count)
+{
+    for (unsigned int k = 0; k < subscribers_.size(); k++)
+    {
+        const Subscriber &sub = subscribers_[k];
+        if (sub.mod == mod && sub.first == first && sub.count == count)
+        {
+            subscribers_.erase(subscribers_.begin() + k);
+            return;
+        }
+    }
+}
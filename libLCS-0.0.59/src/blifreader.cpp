@@ -0,0 +1,530 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/netreader.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+// Splits a BLIF input into logical lines of whitespace separated tokens. Comments are
+// dropped and lines ending with '\' are joined with the next line.
+class BlifLexer
+{
+public:
+    BlifLexer(istream &in) : buf_(in.rdbuf()), line_(0), next_(1) {}
+
+    bool next(vector<string> &tokens)
+    {
+        tokens.clear();
+
+        while (tokens.size() == 0)
+        {
+            if (buf_ == NULL || buf_->sgetc() == char_traits<char>::eof())
+                return false;
+
+            line_ = next_;
+            string token;
+            bool comment = false, joined = false;
+
+            while (true)
+            {
+                int c = buf_->sbumpc();
+
+                if (c == char_traits<char>::eof() || (c == '\n' && !joined))
+                {
+                    next_++;
+                    break;
+                }
+
+                if (c == '\n')
+                {
+                    next_++;
+                    joined = false;
+                    continue;
+                }
+
+                if (comment)
+                    continue;
+
+                if (c == '#')
+                    comment = true;
+                else if (c == '\\')
+                    joined = true;
+                else if (c == ' ' || c == '\t' || c == '\r')
+                {
+                    if (token.size() != 0)
+                    {
+                        tokens.push_back(token);
+                        token.clear();
+                    }
+                }
+                else
+                {
+                    joined = false;
+                    token += static_cast<char>(c);
+                }
+            }
+
+            if (token.size() != 0)
+                tokens.push_back(token);
+        }
+
+        return true;
+    }
+
+    int getLine(void) const { return line_; }
+
+private:
+    streambuf *buf_;
+    int line_, next_;
+};
+
+struct Subcircuit
+{
+    Circuit *parent;
+    string model;
+    vector< pair<string, int> > connections;
+    int line;
+};
+
+class BlifParser
+{
+public:
+    BlifParser(istream &in, CircuitLibrary &lib)
+        : lexer_(in), lib_(lib), cur_(NULL), top_(NULL), clock_(-1), instances_(0) {}
+
+    Circuit& parse(void) throw (NetlistException);
+
+private:
+    void error(const string &message) const throw (NetlistException)
+    {
+        ostringstream ss;
+        ss << "BLIF line " << lexer_.getLine() << ": " << message;
+        throw NetlistException(ss.str());
+    }
+
+    int net(const string &name)
+    {
+        int id = cur_->findNet(name);
+        return (id >= 0) ? id : cur_->addNet(name);
+    }
+
+    int complement(int id)
+    {
+        map<int, int>::iterator iter = inverted_.find(id);
+        if (iter != inverted_.end())
+            return iter->second;
+
+        int out = cur_->addNet();
+        cur_->addCell(NOT_CELL, id, out);
+        inverted_[id] = out;
+
+        return out;
+    }
+
+    int clock(void)
+    {
+        if (clock_ < 0)
+        {
+            clock_ = cur_->findNet("clock");
+            if (clock_ < 0)
+                clock_ = cur_->addInput("clock");
+        }
+
+        return clock_;
+    }
+
+    // The clock nets of the latches are often not listed in the .inputs directive. Such a
+    // net, if not seen before, is made an input port of the model.
+    int control(const string &name)
+    {
+        int id = cur_->findNet(name);
+        return (id >= 0) ? id : cur_->addInput(name);
+    }
+
+    void checkModel(void) const
+    {
+        if (cur_ == NULL)
+            error("Directive outside of a model.");
+    }
+
+    void endNames(void);
+
+    void latch(const vector<string> &tokens);
+
+    BlifLexer lexer_;
+    CircuitLibrary &lib_;
+    Circuit *cur_, *top_;
+    int clock_, instances_;
+    map<int, int> inverted_;
+    vector<Subcircuit> subcircuits_;
+
+    // The logic function being read: its input nets, output net and cover rows.
+    vector<int> inputs_;
+    int output_;
+    vector<string> rows_;
+    bool inNames_;
+};
+
+void BlifParser::endNames(void)
+{
+    if (!inNames_)
+        return;
+
+    inNames_ = false;
+
+    int k = static_cast<int>(inputs_.size());
+    bool onSet = true;
+
+    for (unsigned int r = 0; r < rows_.size(); r++)
+    {
+        const string &row = rows_[r];
+        if (row[k] != '0' && row[k] != '1')
+            error("Malformed cover row " + row + ".");
+
+        if (r == 0)
+            onSet = (row[k] == '1');
+        else if ((row[k] == '1') != onSet)
+            error("The cover rows of a function should all be in the on-set or all in the off-set.");
+    }
+
+    // A function without rows is constant 0; one with a row without literals is
+    // constant as well.
+    bool constant = (rows_.size() == 0);
+    LineState value = LOW;
+    for (unsigned int r = 0; r < rows_.size() && !constant; r++)
+    {
+        if (rows_[r].find_first_not_of('-') == static_cast<string::size_type>(k))
+        {
+            constant = true;
+            value = onSet ? HIGH : LOW;
+        }
+    }
+
+    if (constant)
+    {
+        cur_->addCell(BUFFER_CELL, cur_->addConstant(value), output_);
+        return;
+    }
+
+    if (k == 2 && rows_.size() == 2)
+    {
+        string a = rows_[0].substr(0, 2), b = rows_[1].substr(0, 2);
+        if ((a == "01" && b == "10") || (a == "10" && b == "01"))
+        {
+            cur_->addCell(onSet ? PARITY_CELL : NPARITY_CELL, inputs_[0], inputs_[1], output_);
+            return;
+        }
+        else if ((a == "00" && b == "11") || (a == "11" && b == "00"))
+        {
+            cur_->addCell(onSet ? NPARITY_CELL : PARITY_CELL, inputs_[0], inputs_[1], output_);
+            return;
+        }
+    }
+
+    // The input part of the single cube, if there is only one.
+    string cube = (rows_.size() == 1) ? rows_[0].substr(0, k) : string("?");
+
+    // A single cube of positive literals is an AND gate.
+    if (cube.find_first_not_of("1-") == string::npos)
+    {
+        vector<int> literals;
+        for (int j = 0; j < k; j++)
+        {
+            if (rows_[0][j] == '1')
+                literals.push_back(inputs_[j]);
+        }
+
+        if (literals.size() == 1)
+            cur_->addCell(onSet ? BUFFER_CELL : NOT_CELL, literals, output_);
+        else
+            cur_->addCell(onSet ? AND_CELL : NAND_CELL, literals, output_);
+
+        return;
+    }
+
+    // A single cube of negative literals is a NOR gate.
+    if (cube.find_first_not_of("0-") == string::npos)
+    {
+        vector<int> literals;
+        for (int j = 0; j < k; j++)
+        {
+            if (rows_[0][j] == '0')
+                literals.push_back(inputs_[j]);
+        }
+
+        if (literals.size() == 1)
+            cur_->addCell(onSet ? NOT_CELL : BUFFER_CELL, literals, output_);
+        else
+            cur_->addCell(onSet ? NOR_CELL : OR_CELL, literals, output_);
+
+        return;
+    }
+
+    vector<int> cubes;
+    for (unsigned int r = 0; r < rows_.size(); r++)
+    {
+        vector<int> literals;
+        for (int j = 0; j < k; j++)
+        {
+            if (rows_[r][j] == '1')
+                literals.push_back(inputs_[j]);
+            else if (rows_[r][j] == '0')
+                literals.push_back(complement(inputs_[j]));
+        }
+
+        if (rows_.size() == 1)
+        {
+            cur_->addCell(onSet ? AND_CELL : NAND_CELL, literals, output_);
+            return;
+        }
+
+        if (literals.size() == 1)
+            cubes.push_back(literals[0]);
+        else
+        {
+            int out = cur_->addNet();
+            cur_->addCell(AND_CELL, literals, out);
+            cubes.push_back(out);
+        }
+    }
+
+    cur_->addCell(onSet ? OR_CELL : NOR_CELL, cubes, output_);
+}
+
+void BlifParser::latch(const vector<string> &tokens)
+{
+    int size = static_cast<int>(tokens.size());
+    if (size < 3 || size > 6)
+        error("Malformed .latch directive.");
+
+    vector<int> inputs(2);
+    inputs[0] = net(tokens[1]);
+    int out = net(tokens[2]);
+
+    CellType type = DFF_CELL;
+    string init = (size == 4 || size == 6) ? tokens[size-1] : "3";
+
+    if (size >= 5)
+    {
+        if (tokens[3] == "fe")
+            type = DFF_NEG_CELL;
+        else if (tokens[3] != "re")
+            error("Latches of type " + tokens[3] + " are not supported.");
+
+        inputs[1] = (tokens[4] == "NIL") ? clock() : control(tokens[4]);
+    }
+    else
+        inputs[1] = clock();
+
+    cur_->addCell(type, inputs, out);
+
+    if (init == "0")
+        cur_->setInitialState(out, LOW);
+    else if (init == "1")
+        cur_->setInitialState(out, HIGH);
+    else if (init != "2" && init != "3")
+        error("Invalid latch initial value " + init + ".");
+}
+
+Circuit& BlifParser::parse(void) throw (NetlistException)
+{
+    vector<string> tokens;
+    inNames_ = false;
+
+    while (lexer_.next(tokens))
+    {
+        const string &directive = tokens[0];
+
+        if (directive[0] != '.')
+        {
+            if (!inNames_)
+                error("Unexpected " + directive + ".");
+
+            // A cover row is the input plane and the output bit, or just the output bit
+            // for a function without inputs.
+            string row;
+            if (tokens.size() == 2)
+                row = tokens[0] + tokens[1];
+            else if (tokens.size() == 1)
+                row = tokens[0];
+
+            if (row.size() != inputs_.size() + 1 || row.find_first_not_of("01-") != string::npos)
+                error("Malformed cover row.");
+
+            rows_.push_back(row);
+
+            continue;
+        }
+
+        endNames();
+
+        try
+        {
+            if (directive == ".model")
+            {
+                cur_ = &lib_.define(tokens.size() > 1 ? tokens[1] : "unnamed");
+                if (top_ == NULL)
+                    top_ = cur_;
+
+                clock_ = -1;
+                inverted_.clear();
+            }
+            else if (directive == ".inputs" || directive == ".outputs")
+            {
+                checkModel();
+                for (unsigned int i = 1; i < tokens.size(); i++)
+                {
+                    if (directive == ".inputs")
+                        cur_->addInput(tokens[i]);
+                    else
+                        cur_->addOutput(tokens[i]);
+                }
+            }
+            else if (directive == ".clock")
+            {
+                checkModel();
+                if (tokens.size() > 1 && clock_ < 0)
+                    clock_ = net(tokens[1]);
+            }
+            else if (directive == ".names")
+            {
+                checkModel();
+                if (tokens.size() < 2)
+                    error("Malformed .names directive.");
+
+                inputs_.clear();
+                rows_.clear();
+                for (unsigned int i = 1; i < tokens.size() - 1; i++)
+                    inputs_.push_back(net(tokens[i]));
+
+                output_ = net(tokens.back());
+                inNames_ = true;
+            }
+            else if (directive == ".latch")
+            {
+                checkModel();
+                latch(tokens);
+            }
+            else if (directive == ".subckt")
+            {
+                checkModel();
+                if (tokens.size() < 2)
+                    error("Malformed .subckt directive.");
+
+                Subcircuit sub;
+                sub.parent = cur_;
+                sub.model = tokens[1];
+                sub.line = lexer_.getLine();
+
+                for (unsigned int i = 2; i < tokens.size(); i++)
+                {
+                    string::size_type eq = tokens[i].find('=');
+                    if (eq == string::npos)
+                        error("Malformed .subckt connection " + tokens[i] + ".");
+
+                    sub.connections.push_back(make_pair(tokens[i].substr(0, eq), net(tokens[i].substr(eq+1))));
+                }
+
+                subcircuits_.push_back(sub);
+            }
+            else if (directive == ".end")
+                cur_ = NULL;
+            else if (directive == ".exdc" || directive == ".gate" || directive == ".mlatch")
+                error("The " + directive + " directive is not supported.");
+
+            // The other directives (delays, arrival times, wire loads, etc.) do not
+            // affect the logic and are ignored.
+        }
+        catch (NetlistException &e)
+        {
+            string message = e.getMessage();
+            if (message.compare(0, 5, "BLIF ") == 0)
+                throw;
+
+            error(message.substr(0, message.size() - 1));
+        }
+    }
+
+    endNames();
+
+    if (top_ == NULL)
+        throw NetlistException("The BLIF input does not have a model.");
+
+    // The subcircuits are connected once all the models are known.
+    for (unsigned int i = 0; i < subcircuits_.size(); i++)
+    {
+        const Subcircuit &sub = subcircuits_[i];
+        Circuit *def = lib_.find(sub.model);
+
+        ostringstream ss;
+        ss << "BLIF line " << sub.line << ": ";
+
+        if (def == NULL)
+            throw NetlistException(ss.str() + "Undefined model " + sub.model + ".");
+
+        // The '#' makes the name distinct from every BLIF net name.
+        ostringstream name;
+        name << sub.model << "#" << instances_++;
+
+        try
+        {
+            int inst = sub.parent->addInstance(name.str(), *def);
+            for (unsigned int k = 0; k < sub.connections.size(); k++)
+                sub.parent->connect(inst, sub.connections[k].first, sub.connections[k].second);
+        }
+        catch (NetlistException &e)
+        {
+            string message = e.getMessage();
+            throw NetlistException(ss.str() + message.substr(0, message.size() - 1));
+        }
+    }
+
+    return *top_;
+}
+
+}
+
+Circuit& NetlistReader::readBlif(istream &in, CircuitLibrary &lib) throw (NetlistException)
+{
+    BlifParser parser(in, lib);
+    return parser.parse();
+}
+
+Circuit& NetlistReader::readBlif(const string &fileName, CircuitLibrary &lib)
+                                 throw (NetlistException)
+{
+    ifstream in(fileName.c_str());
+    if (!in)
+        throw NetlistException("Unable to open " + fileName + ".");
+
+    return readBlif(in, lib);
+}
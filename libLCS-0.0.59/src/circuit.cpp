@@ -0,0 +1,259 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/circuit.h>
+#include <sstream>
+
+using namespace lcs;
+using namespace std;
+
+Circuit::Circuit(const string &name) : name_(name), netCount_(0)
+{
+    cellInputOffset_.push_back(0);
+}
+
+Circuit::~Circuit() {}
+
+void Circuit::checkNet(int net) const throw (NetlistException)
+{
+    if (net < 0 || net >= netCount_)
+    {
+        ostringstream ss;
+        ss << "Circuit " << name_ << " has no net with id " << net << ".";
+        throw NetlistException(ss.str());
+    }
+}
+
+bool Circuit::suitsCell(int type, int inputs)
+{
+    switch (type)
+    {
+        case BUFFER_CELL  :
+        case NOT_CELL     : return inputs == 1;
+        case AND_CELL     :
+        case OR_CELL      :
+        case PARITY_CELL  :
+        case NAND_CELL    :
+        case NOR_CELL     :
+        case NPARITY_CELL : return inputs >= 1;
+        case DFF_CELL     :
+        case DFF_NEG_CELL : return inputs == 2 || inputs == 3;
+        default           : return false;
+    }
+}
+
+void Circuit::checkName(const string &name) const throw (NetlistException)
+{
+    if (netNames_.find(name) != netNames_.end() || instanceNames_.find(name) != instanceNames_.end())
+        throw NetlistException("The name " + name + " is already in use in circuit " + name_ + ".");
+}
+
+int Circuit::addPort(const string &name, PortDirection dir, int width) throw (NetlistException)
+{
+    int net = addNet(name, width);
+
+    Port port;
+    port.name = name;
+    port.dir = dir;
+    port.net = net;
+    port.width = width;
+    ports_.push_back(port);
+
+    return net;
+}
+
+int Circuit::addInput(const string &name, int width) throw (NetlistException)
+{
+    return addPort(name, INPUT_PORT, width);
+}
+
+int Circuit::addOutput(const string &name, int width) throw (NetlistException)
+{
+    return addPort(name, OUTPUT_PORT, width);
+}
+
+int Circuit::addNet(const string &name, int width) throw (NetlistException)
+{
+    checkName(name);
+
+    if (width < 1)
+        throw NetlistException("The nets " + name + " of circuit " + name_ + " should be atleast 1 bit wide.");
+
+    int net = netCount_;
+    netCount_ += width;
+    netNames_[name] = make_pair(net, width);
+
+    return net;
+}
+
+int Circuit::addNet(void) { return netCount_++; }
+
+int Circuit::addConstant(const LineState &state)
+{
+    int net = netCount_++;
+    constants_.push_back(make_pair(net, state));
+
+    return net;
+}
+
+void Circuit::setInitialState(int net, const LineState &state) throw (NetlistException)
+{
+    checkNet(net);
+    constants_.push_back(make_pair(net, state));
+}
+
+int Circuit::findNet(const string &name) const
+{
+    map< string, pair<int, int> >::const_iterator iter = netNames_.find(name);
+    if (iter == netNames_.end())
+        return -1;
+
+    return iter->second.first;
+}
+
+int Circuit::findPort(const string &name) const
+{
+    for (unsigned int i = 0; i < ports_.size(); i++)
+    {
+        if (ports_[i].name == name)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
+
+int Circuit::addCell(const CellType &type, const vector<int> &inputs, int output,
+                     unsigned int delay) throw (NetlistException)
+{
+    int count = static_cast<int>(inputs.size());
+
+    if (!isCellType(type))
+    {
+        ostringstream ss;
+        ss << type << " is not a cell type (circuit " << name_ << ").";
+        throw NetlistException(ss.str());
+    }
+
+    if (!suitsCell(type, count))
+    {
+        ostringstream ss;
+        ss << "A cell of type " << type << " cannot have " << count << " inputs (circuit "
+           << name_ << ").";
+        throw NetlistException(ss.str());
+    }
+
+    for (int i = 0; i < count; i++)
+        checkNet(inputs[i]);
+    checkNet(output);
+
+    cellType_.push_back(type);
+    cellDelay_.push_back(delay);
+    cellInputs_.insert(cellInputs_.end(), inputs.begin(), inputs.end());
+    cellInputOffset_.push_back(static_cast<int>(cellInputs_.size()));
+    cellOutput_.push_back(output);
+
+    return static_cast<int>(cellType_.size()) - 1;
+}
+
+int Circuit::addCell(const CellType &type, int input, int output, unsigned int delay)
+                     throw (NetlistException)
+{
+    return addCell(type, vector<int>(1, input), output, delay);
+}
+
+int Circuit::addCell(const CellType &type, int input1, int input2, int output,
+                     unsigned int delay) throw (NetlistException)
+{
+    vector<int> inputs(2);
+    inputs[0] = input1;
+    inputs[1] = input2;
+
+    return addCell(type, inputs, output, delay);
+}
+
+int Circuit::addInstance(const string &name, const Circuit &def) throw (NetlistException)
+{
+    checkName(name);
+
+    Instance inst;
+    inst.name = name;
+    inst.def = &def;
+
+    instances_.push_back(inst);
+    instanceNames_[name] = static_cast<int>(instances_.size()) - 1;
+
+    return static_cast<int>(instances_.size()) - 1;
+}
+
+void Circuit::connect(int instance, const string &port, int net) throw (NetlistException)
+{
+    if (instance < 0 || instance >= static_cast<int>(instances_.size()))
+    {
+        ostringstream ss;
+        ss << "Circuit " << name_ << " has no instance with index " << instance << ".";
+        throw NetlistException(ss.str());
+    }
+
+    int index = instances_[instance].def->findPort(port);
+    if (index < 0)
+        throw NetlistException("Circuit " + instances_[instance].def->name_ + " has no port " + port + ".");
+
+    int width = instances_[instance].def->ports_[index].width;
+    vector<int> nets(width);
+    for (int i = 0; i < width; i++)
+        nets[i] = net + i;
+
+    connect(instance, port, nets);
+}
+
+void Circuit::connect(int instance, const string &port, const vector<int> &nets)
+                      throw (NetlistException)
+{
+    if (instance < 0 || instance >= static_cast<int>(instances_.size()))
+    {
+        ostringstream ss;
+        ss << "Circuit " << name_ << " has no instance with index " << instance << ".";
+        throw NetlistException(ss.str());
+    }
+
+    Instance &inst = instances_[instance];
+    int index = inst.def->findPort(port);
+    if (index < 0)
+        throw NetlistException("Circuit " + inst.def->name_ + " has no port " + port + ".");
+
+    if (static_cast<int>(nets.size()) != inst.def->ports_[index].width)
+        throw NetlistException("The width of port " + port + " of instance " + inst.name
+                               + " does not match the number of nets connected.");
+
+    for (unsigned int i = 0; i < inst.connections.size(); i++)
+    {
+        if (inst.connections[i].first == index)
+            throw NetlistException("Port " + port + " of instance " + inst.name + " is already connected.");
+    }
+
+    for (unsigned int i = 0; i < nets.size(); i++)
+        checkNet(nets[i]);
+
+    inst.connections.push_back(make_pair(index, nets));
+}
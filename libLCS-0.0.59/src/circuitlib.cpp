@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/circuitlib.h>
+
+using namespace lcs;
+using namespace std;
+
+CircuitLibrary::~CircuitLibrary()
+{
+    for (unsigned int i = 0; i < circuits_.size(); i++)
+        delete circuits_[i];
+}
+
+Circuit& CircuitLibrary::define(const string &name) throw (NetlistException)
+{
+    if (index_.find(name) != index_.end())
+        throw NetlistException("The library already has a circuit named " + name + ".");
+
+    index_[name] = static_cast<int>(circuits_.size());
+    circuits_.push_back(new Circuit(name));
+
+    return *circuits_.back();
+}
+
+Circuit* CircuitLibrary::find(const string &name) const
+{
+    map<string, int>::const_iterator iter = index_.find(name);
+    if (iter == index_.end())
+        return NULL;
+
+    return circuits_[iter->second];
+}
@@ -0,0 +1,231 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/dynbus.h>
+#include <lcs/writegroup.h>
+#include <sstream>
+
+using namespace lcs;
+using namespace std;
+
+DynBus::DynBus(int width)
+    : width_(width), refCount_(new int(1)), lines_(new Line[width])
+{
+    for (int i = 0; i < width_; i++)
+        lines_[i].setLineValue(UNKNOWN);
+}
+
+DynBus::DynBus(int width, unsigned long val)
+    : width_(width), refCount_(new int(1)), lines_(new Line[width])
+{
+    for (int i = 0; i < width_; i++)
+    {
+        lines_[i].setLineValue((val & 1) ? HIGH : LOW);
+        val >>= 1;
+    }
+}
+
+DynBus::DynBus(const DynBus &bus)
+    : width_(bus.width_), refCount_(bus.refCount_), lines_(bus.lines_)
+{
+    (*refCount_)++;
+}
+
+DynBus::~DynBus()
+{
+    release();
+}
+
+void DynBus::release(void)
+{
+    if (--(*refCount_) == 0)
+    {
+        delete [] lines_;
+        delete refCount_;
+    }
+}
+
+const LineState DynBus::get(int index) const throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= width_)
+        throw OutOfRangeException<int>(0, width_-1, index);
+
+    return lines_[index]();
+}
+
+const Line& DynBus::getLine(int index) const throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= width_)
+        throw OutOfRangeException<int>(0, width_-1, index);
+
+    return lines_[index];
+}
+
+DynBus DynBus::operator[](int index) const throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= width_)
+        throw OutOfRangeException<int>(0, width_-1, index);
+
+    DynBus b(1);
+    b.lines_[0] = lines_[index];
+
+    return b;
+}
+
+DynBus DynBus::partSelect(int s, int w) const
+{
+    DynBus b(w);
+
+    for (int i = 0; i < w && i+s < width_; i++)
+    {
+        if (i+s >= 0)
+            b.lines_[i] = lines_[i+s];
+    }
+
+    return b;
+}
+
+DynBus DynBus::operator,(const DynBus &bus) const
+{
+    DynBus b(width_ + bus.width_);
+
+    for (int i = 0; i < width_; i++)
+        b.lines_[i] = lines_[i];
+
+    for (int i = 0; i < bus.width_; i++)
+        b.lines_[width_ + i] = bus.lines_[i];
+
+    return b;
+}
+
+void DynBus::set(int index, const LineState &state, unsigned int delay)
+                 throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= width_)
+        throw OutOfRangeException<int>(0, width_-1, index);
+
+    WriteGroup group;
+    lines_[index].assign(state, delay);
+}
+
+void DynBus::assign(const LineState &state, unsigned int delay)
+{
+    WriteGroup group;
+
+    for (int i = 0; i < width_; i++)
+        lines_[i].assign(state, delay);
+}
+
+void DynBus::assign(unsigned long val, unsigned int delay)
+{
+    WriteGroup group;
+
+    for (int i = 0; i < width_; i++)
+    {
+        lines_[i].assign((val & 1) ? HIGH : LOW, delay);
+        val >>= 1;
+    }
+}
+
+void DynBus::assign(const DynBus &bus, unsigned int delay)
+{
+    WriteGroup group;
+    int w = (width_ < bus.width_) ? width_ : bus.width_;
+
+    for (int i = 0; i < w; i++)
+        lines_[i].assign(bus.lines_[i](), delay);
+}
+
+void DynBus::notify(Module *mod, const LineEvent &event, int portId, int line)
+                    throw (OutOfRangeException<int>)
+{
+    if (line >= width_)
+        throw OutOfRangeException<int>(0, width_-1, line);
+
+    if (line >= 0)
+    {
+        lines_[line].notify(event, mod, portId);
+        return;
+    }
+
+    for (int i = 0; i < width_; i++)
+        lines_[i].notify(event, mod, portId);
+}
+
+void DynBus::notifyBits(Module *mod, int portId)
+{
+    for (int i = 0; i < width_; i++)
+        lines_[i].notify(LINE_STATE_CHANGE, mod, portId, i);
+}
+
+void DynBus::stopNotification(Module *mod, const LineEvent &event, int portId, int line)
+                              throw (OutOfRangeException<int>)
+{
+    if (line >= width_)
+        throw OutOfRangeException<int>(0, width_-1, line);
+
+    if (line >= 0)
+    {
+        lines_[line].stopNotification(event, mod, portId);
+        return;
+    }
+
+    for (int i = 0; i < width_; i++)
+        lines_[i].stopNotification(event, mod, portId);
+}
+
+unsigned long DynBus::toInt(void) const
+{
+    unsigned long val = 0;
+
+    for (int i = width_ - 1; i >= 0; i--)
+    {
+        LineState state = lines_[i]();
+        if (state == UNKNOWN || state == HIGH_IMPEDENCE)
+            return 0;
+
+        val = (val << 1) | ((state == HIGH) ? 1 : 0);
+    }
+
+    return val;
+}
+
+string DynBus::toStr(void) const
+{
+    string s(width_, '0');
+
+    for (int i = 0; i < width_; i++)
+    {
+        LineState state = lines_[i]();
+
+        if (state == HIGH)
+            s[i] = '1';
+        else if (state == HIGH_IMPEDENCE)
+            s[i] = 'z';
+        else if (state == UNKNOWN)
+            s[i] = 'x';
+    }
+
+    return s;
+}
@@ -0,0 +1,176 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/dyngate.h>
+#include <lcs/writegroup.h>
+
+using namespace lcs;
+
+namespace
+{
+
+// Returns the number of bits set in \p word.
+int bitCount(unsigned int word)
+{
+    word = word - ((word >> 1) & 0x55555555u);
+    word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+    word = (word + (word >> 4)) & 0x0f0f0f0fu;
+
+    return static_cast<int>((word * 0x01010101u) >> 24);
+}
+
+// The largest number of inputs for which lcs::AUTOMATIC_GATE_EVALUATION chooses
+// lcs::FULL_GATE_EVALUATION.
+const int AUTOMATIC_FULL_WIDTH = 8;
+
+}
+
+const int DynGate::INPUT  = 0;
+const int DynGate::OUTPUT = 1;
+
+DynGate::DynGate(GateType type, const DynBus &output, const DynBus &input, unsigned int delay,
+                 GateEvaluation evaluation) throw (OutOfRangeException<int>)
+    : Module(), type_(type), delay_(delay), outBus(output), inBus(input), deps_(NULL),
+      value_((input.width() + 31) / 32, 0), unknown_((input.width() + 31) / 32, 0),
+      highCount_(0), unknownCount_(0)
+{
+    int width = (type == NOT_GATE || type == BUFFER_GATE) ? inBus.width() : 1;
+    if (outBus.width() != width)
+        throw OutOfRangeException<int>(width, width, outBus.width());
+
+    if (evaluation == AUTOMATIC_GATE_EVALUATION)
+        evaluation = (inBus.width() > AUTOMATIC_FULL_WIDTH) ? INCREMENTAL_GATE_EVALUATION
+                                                             : FULL_GATE_EVALUATION;
+
+    if (evaluation == INCREMENTAL_GATE_EVALUATION)
+    {
+        deps_ = new BitDependencyMap(this);
+        for (int i = 0; i < inBus.width(); i++)
+            deps_->add(inBus.getLine(i), i);
+    }
+    else
+        inBus.notify(this, LINE_STATE_CHANGE, INPUT);
+
+    load();
+    setBatchEvaluator(&DynGate::evaluateBatch<RUNTIME_DELAY>);
+
+    // As lcs::Buffer does, a buffer copies its input to its output without the delay at
+    // the start.
+    if (type_ == BUFFER_GATE)
+        outBus.assign(inBus);
+    else
+        drive<RUNTIME_DELAY>(-1);
+}
+
+DynGate::~DynGate()
+{
+    if (deps_ != NULL)
+        delete deps_;
+    else
+        inBus.stopNotification(this, LINE_STATE_CHANGE, INPUT);
+}
+
+bool DynGate::setInput(int i, const LineState &state)
+{
+    unsigned int bit = 1u << (i % 32);
+    unsigned int &value = value_[i / 32], &unknown = unknown_[i / 32];
+
+    bool wasHigh = (value & ~unknown & bit) != 0, wasUnknown = (unknown & bit) != 0;
+    bool isHigh = (state == HIGH), isUnknown = (state == UNKNOWN || state == HIGH_IMPEDENCE);
+
+    // The value plane bit of an unknown input tells lcs::UNKNOWN and lcs::HIGH_IMPEDENCE
+    // apart.
+    bool newValue = (state == HIGH || state == HIGH_IMPEDENCE);
+    if (((value & bit) != 0) == newValue && wasUnknown == isUnknown)
+        return false;
+
+    value = newValue ? (value | bit) : (value & ~bit);
+    unknown = isUnknown ? (unknown | bit) : (unknown & ~bit);
+
+    highCount_ += static_cast<int>(isHigh) - static_cast<int>(wasHigh);
+    unknownCount_ += static_cast<int>(isUnknown) - static_cast<int>(wasUnknown);
+
+    return true;
+}
+
+void DynGate::load(void)
+{
+    int width = inBus.width(), limbs = static_cast<int>(value_.size());
+
+    for (int k = 0; k < limbs; k++)
+        value_[k] = unknown_[k] = 0;
+
+    for (int i = 0; i < width; i++)
+    {
+        LineState state = inBus.get(i);
+        unsigned int bit = 1u << (i % 32);
+
+        if (state == HIGH || state == HIGH_IMPEDENCE)
+            value_[i / 32] |= bit;
+        if (state == UNKNOWN || state == HIGH_IMPEDENCE)
+            unknown_[i / 32] |= bit;
+    }
+
+    highCount_ = unknownCount_ = 0;
+    for (int k = 0; k < limbs; k++)
+    {
+        highCount_ += bitCount(value_[k] & ~unknown_[k]);
+        unknownCount_ += bitCount(unknown_[k]);
+    }
+}
+
+void DynGate::onStateChange(int portId)
+{
+    evaluate<RUNTIME_DELAY>(portId);
+}
+
+LineState DynGate::getOutput(int index) const
+{
+    if (isPerLine())
+    {
+        unsigned int bit = 1u << (index % 32);
+        bool value = (value_[index / 32] & bit) != 0;
+        bool unknown = (unknown_[index / 32] & bit) != 0;
+
+        if (type_ == NOT_GATE)
+            return (value && !unknown) ? LOW : HIGH;
+        if (unknown)
+            return value ? HIGH_IMPEDENCE : UNKNOWN;
+
+        return value ? HIGH : LOW;
+    }
+
+    int width = inBus.width();
+    bool high;
+    switch (type_)
+    {
+        case AND_GATE  : { high = (highCount_ == width); break; }
+        case NAND_GATE : { high = (highCount_ != width); break; }
+        case OR_GATE   : { high = (highCount_ != 0); break; }
+        case NOR_GATE  : { high = (highCount_ == 0); break; }
+        default        : { high = (highCount_ == 1); break; }
+    }
+
+    return high ? HIGH : LOW;
+}
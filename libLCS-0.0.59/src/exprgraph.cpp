@@ -0,0 +1,345 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/exprgraph.h>
+#include <lcs/line.h>
+#include <algorithm>
+#include <functional>
+
+using namespace lcs;
+
+// The node type used for the nodes which are always in the lcs::UNKNOWN state. The other
+// nodes use the lcs::ExprType value of the corresponding expression as their type, with
+// the leaf nodes using lcs::BUS_EXPR.
+static const int UNKNOWN_NODE = 0;
+
+ExpressionGraph *ExpressionGraph::graph_ = NULL;
+bool ExpressionGraph::enabled_ = false;
+
+ExpressionGraph::ExpressionGraph(void)
+    : Module()
+{}
+
+ExpressionGraph::~ExpressionGraph()
+{
+    for (unsigned int k = 0; k < leafLines_.size(); k++)
+    {
+        if (live_[leafNodes_[k]])
+            leafLines_[k]->stopNotification(LINE_STATE_CHANGE, this, static_cast<int>(k)+1);
+
+        delete leafLines_[k];
+    }
+
+    for (unsigned int i = 0; i < sinks_.size(); i++)
+    {
+        for (unsigned int j = 0; j < sinks_[i].size(); j++)
+            delete sinks_[i][j];
+    }
+}
+
+ExpressionGraph* ExpressionGraph::instance(void)
+{
+    if (graph_ == NULL)
+        graph_ = new ExpressionGraph();
+
+    return graph_;
+}
+
+void ExpressionGraph::destroy(void)
+{
+    if (graph_ != NULL)
+    {
+        delete graph_;
+        graph_ = NULL;
+    }
+}
+
+int ExpressionGraph::size(void)
+{
+    if (graph_ == NULL)
+        return 0;
+
+    return static_cast<int>(graph_->type_.size());
+}
+
+void ExpressionGraph::truncate(int size)
+{
+    if (graph_ == NULL)
+        return;
+
+    ExpressionGraph *g = graph_;
+    for (int id = static_cast<int>(g->type_.size()) - 1; id >= size; id--)
+    {
+        if (g->type_[id] != BUS_EXPR)
+        {
+            g->nodeIndex_.erase(std::make_pair(g->type_[id], std::make_pair(g->left_[id], g->right_[id])));
+            continue;
+        }
+
+        // The leaves are added in the order of their nodes, so that the leaf of the node
+        // is the last one.
+        g->leafIndex_.erase(g->leafLines_.back()->val);
+        delete g->leafLines_.back();
+        g->leafLines_.pop_back();
+        g->leafNodes_.pop_back();
+    }
+
+    if (size >= static_cast<int>(g->type_.size()))
+        return;
+
+    g->type_.resize(size);
+    g->left_.resize(size);
+    g->right_.resize(size);
+    g->value_.resize(size);
+    g->live_.resize(size);
+    g->dirty_.resize(size);
+    g->fanout_.resize(size);
+    g->sinks_.resize(size);
+    g->sinkDelays_.resize(size);
+}
+
+int ExpressionGraph::addNode(int type, int l, int r, LineState value)
+{
+    int id = static_cast<int>(type_.size());
+
+    type_.push_back(type);
+    left_.push_back(l);
+    right_.push_back(r);
+    value_.push_back(value);
+    live_.push_back(false);
+    dirty_.push_back(false);
+    fanout_.push_back(std::vector<int>());
+    sinks_.push_back(std::vector<Line*>());
+    sinkDelays_.push_back(std::vector<unsigned int>());
+
+    if (type != BUS_EXPR)
+        nodeIndex_[std::make_pair(type, std::make_pair(l, r))] = id;
+
+    return id;
+}
+
+int ExpressionGraph::leaf(const Line &line)
+{
+    ExpressionGraph *g = instance();
+
+    std::map<const void*, int>::iterator iter = g->leafIndex_.find(line.val);
+    if (iter != g->leafIndex_.end())
+        return iter->second;
+
+    int id = g->addNode(BUS_EXPR, static_cast<int>(g->leafLines_.size()), -1, line());
+
+    g->leafIndex_[line.val] = id;
+    g->leafLines_.push_back(new Line(line));
+    g->leafNodes_.push_back(id);
+
+    return id;
+}
+
+int ExpressionGraph::unknown(void)
+{
+    ExpressionGraph *g = instance();
+
+    std::map< std::pair<int, std::pair<int, int> >, int >::iterator iter
+        = g->nodeIndex_.find(std::make_pair(UNKNOWN_NODE, std::make_pair(-1, -1)));
+    if (iter != g->nodeIndex_.end())
+        return iter->second;
+
+    return g->addNode(UNKNOWN_NODE, -1, -1, UNKNOWN);
+}
+
+int ExpressionGraph::complement(int in)
+{
+    ExpressionGraph *g = instance();
+
+    std::map< std::pair<int, std::pair<int, int> >, int >::iterator iter
+        = g->nodeIndex_.find(std::make_pair(static_cast<int>(ONES_COMPLEMENT_EXPR),
+                                            std::make_pair(in, -1)));
+    if (iter != g->nodeIndex_.end())
+        return iter->second;
+
+    return g->addNode(ONES_COMPLEMENT_EXPR, in, -1, ~(g->value_[in]));
+}
+
+int ExpressionGraph::binary(ExprType type, int l, int r)
+{
+    if (type != BITWISE_AND_EXPR && type != BITWISE_OR_EXPR && type != BITWISE_XOR_EXPR)
+        return -1;
+
+    ExpressionGraph *g = instance();
+
+    // The bitwise operations are commutative. Hence, the operands are ordered so that
+    // a&b and b&a map to the same node.
+    if (l > r)
+        std::swap(l, r);
+
+    std::map< std::pair<int, std::pair<int, int> >, int >::iterator iter
+        = g->nodeIndex_.find(std::make_pair(static_cast<int>(type), std::make_pair(l, r)));
+    if (iter != g->nodeIndex_.end())
+        return iter->second;
+
+    int id = g->addNode(type, l, r, UNKNOWN);
+    g->evaluate(id);
+
+    return id;
+}
+
+void ExpressionGraph::drive(int node, const Line &line, unsigned int delay)
+{
+    ExpressionGraph *g = instance();
+
+    g->makeLive(node);
+
+    Line *sink = new Line(line);
+    g->sinks_[node].push_back(sink);
+    g->sinkDelays_[node].push_back(delay);
+
+    sink->assign(g->value_[node], delay);
+}
+
+void ExpressionGraph::makeLive(int node)
+{
+    if (live_[node])
+        return;
+
+    live_[node] = true;
+
+    if (type_[node] == BUS_EXPR)
+    {
+        int k = left_[node];
+        leafLines_[k]->notify(LINE_STATE_CHANGE, this, k+1);
+        value_[node] = (*leafLines_[k])();
+
+        return;
+    }
+
+    if (left_[node] >= 0)
+    {
+        makeLive(left_[node]);
+        fanout_[left_[node]].push_back(node);
+    }
+
+    if (right_[node] >= 0)
+    {
+        makeLive(right_[node]);
+        fanout_[right_[node]].push_back(node);
+    }
+
+    evaluate(node);
+}
+
+void ExpressionGraph::evaluate(int node)
+{
+    int l = left_[node], r = right_[node];
+
+    switch (type_[node])
+    {
+        case ONES_COMPLEMENT_EXPR : { value_[node] = ~value_[l]; break; }
+        case BITWISE_AND_EXPR     : { value_[node] = value_[l] & value_[r]; break; }
+        case BITWISE_OR_EXPR      : { value_[node] = value_[l] | value_[r]; break; }
+        case BITWISE_XOR_EXPR     : { value_[node] = value_[l] ^ value_[r]; break; }
+        case UNKNOWN_NODE         : { value_[node] = UNKNOWN; break; }
+        default                   : break;
+    }
+}
+
+void ExpressionGraph::onStateChange(int portId)
+{
+    // In the delta evaluation mode, changes on several leaves are notified together.
+    if (portId == ANY_PORT)
+    {
+        for (unsigned int i = 0; i < leafLines_.size(); i++)
+            updateLeaf(i);
+    }
+    else if (portId >= 1 && portId <= static_cast<int>(leafLines_.size()))
+        updateLeaf(portId-1);
+    else
+        return;
+
+    propagate();
+}
+
+void ExpressionGraph::updateLeaf(int index)
+{
+    int node = leafNodes_[index];
+    LineState value = (*leafLines_[index])();
+
+    if (value == value_[node])
+        return;
+
+    value_[node] = value;
+
+    std::vector<int> &fanout = fanout_[node];
+    for (unsigned int i = 0; i < fanout.size(); i++)
+    {
+        if (!dirty_[fanout[i]])
+        {
+            dirty_[fanout[i]] = true;
+            heap_.push_back(fanout[i]);
+            std::push_heap(heap_.begin(), heap_.end(), std::greater<int>());
+        }
+    }
+
+    // The lines assigned the leaf itself (as by b.cass(a)) are not reached by
+    // lcs::ExpressionGraph::propagate, which writes the sinks of the nodes it evaluates.
+    std::vector<Line*> &sinks = sinks_[node];
+    for (unsigned int i = 0; i < sinks.size(); i++)
+    {
+        sinks[i]->assign(value_[node], sinkDelays_[node][i]);
+    }
+}
+
+void ExpressionGraph::propagate(void)
+{
+    while (heap_.size() != 0)
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<int>());
+        int node = heap_.back();
+        heap_.pop_back();
+
+        dirty_[node] = false;
+
+        LineState old = value_[node];
+        evaluate(node);
+
+        if (value_[node] == old)
+            continue;
+
+        std::vector<int> &fanout = fanout_[node];
+        for (unsigned int i = 0; i < fanout.size(); i++)
+        {
+            if (!dirty_[fanout[i]])
+            {
+                dirty_[fanout[i]] = true;
+                heap_.push_back(fanout[i]);
+                std::push_heap(heap_.begin(), heap_.end(), std::greater<int>());
+            }
+        }
+
+        std::vector<Line*> &sinks = sinks_[node];
+        for (unsigned int i = 0; i < sinks.size(); i++)
+        {
+            sinks[i]->assign(value_[node], sinkDelays_[node][i]);
+        }
+    }
+}
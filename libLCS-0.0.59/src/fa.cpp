@@ -46,8 +46,10 @@ FullAdder::~FullAdder()
 
 void FullAdder::onStateChange(int portId)
 {
-    s[0] = (~a[0] & ~b[0] & c[0]) | (~a[0] & b[0] & ~c[0]) |
-                    (a[0] & ~b[0] & ~c[0]) | (a[0] & b[0] & c[0]);
-    cout[0] = (~a[0] & b[0] & c[0]) | (a[0] & ~b[0] & c[0]) |
-                      (a[0] & b[0] & ~c[0]) | (a[0] & b[0] & c[0]);
+    // Each of the shared subterms is evaluated only once.
+    LineState av = a.get(0), bv = b.get(0), cv = c.get(0);
+    LineState na = ~av, nb = ~bv, nc = ~cv, ab = av & bv;
+
+    s = (na & nb & cv) | (na & bv & nc) | (av & nb & nc) | (ab & cv);
+    cout = (na & bv & cv) | (av & nb & cv) | (ab & nc) | (ab & cv);
 }
@@ -0,0 +1,771 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/flatnetlist.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+// Orders net ids by their names, which are stored in a shared character pool.
+class NameLess
+{
+public:
+    NameLess(const vector<char> &names, const vector<int> &offset) : names_(names), offset_(offset) {}
+
+    bool operator()(int l, int r) const
+    {
+        return strcmp(&names_[offset_[l]], &names_[offset_[r]]) < 0;
+    }
+
+private:
+    const vector<char> &names_;
+    const vector<int> &offset_;
+};
+
+bool isSequential(int type) { return type == DFF_CELL || type == DFF_NEG_CELL; }
+
+bool isZeroDelayCombinational(int type, unsigned int delay)
+{
+    return !isSequential(type) && delay == 0;
+}
+
+// The header of a saved netlist. It is followed by the arrays of the netlist, each padded
+// to a multiple of 8 bytes, in the order in which they are listed in FlatNetlist::save.
+struct FileHeader
+{
+    char magic[8];
+    unsigned int byteOrder;
+    unsigned int version;
+    unsigned long long key;
+    int nets, cells, inputs, fanout, names, namedNets, ports, portNames;
+};
+
+const char FILE_MAGIC[8] = { 'L', 'C', 'S', 'F', 'L', 'A', 'T', '\0' };
+const unsigned int FILE_BYTE_ORDER = 0x01020304;
+const unsigned int FILE_VERSION = 1;
+
+unsigned long padded(unsigned long bytes) { return (bytes + 7) & ~7UL; }
+
+// Returns the offset of the next array of \p count elements of type T in a saved netlist,
+// and advances \p offset past it.
+template <typename T>
+unsigned long section(unsigned long &offset, int count)
+{
+    unsigned long start = offset;
+    offset += padded(static_cast<unsigned long>(count) * sizeof(T));
+    return start;
+}
+
+template <typename T>
+void write(ostream &out, const T *data, int count)
+{
+    static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    unsigned long bytes = static_cast<unsigned long>(count) * sizeof(T);
+
+    if (bytes != 0)
+        out.write(reinterpret_cast<const char*>(data), bytes);
+
+    out.write(zeros, padded(bytes) - bytes);
+}
+
+template <typename T>
+const T* pointer(const vector<T> &v) { return v.empty() ? NULL : &v[0]; }
+
+}
+
+FlatNetlist::FlatNetlist(const Circuit &top) throw (NetlistException)
+    : file_(NULL)
+{
+    vector<int> netMap(top.netCount_, -1);
+    vector<const Circuit*> stack;
+
+    cellInputOffset_.push_back(0);
+    flatten(top, netMap, "", stack);
+
+    for (unsigned int i = 0; i < top.ports_.size(); i++)
+    {
+        portName_.push_back(top.ports_[i].name);
+        portDir_.push_back(top.ports_[i].dir);
+        portNet_.push_back(netMap[top.ports_[i].net]);
+        portWidth_.push_back(top.ports_[i].width);
+    }
+
+    order();
+    index();
+    bind();
+}
+
+FlatNetlist::FlatNetlist(MappedFile *file)
+    : file_(file)
+{}
+
+FlatNetlist::~FlatNetlist()
+{
+    delete file_;
+}
+
+void FlatNetlist::bind(void)
+{
+    arrays_.nets = static_cast<int>(initial_.size());
+    arrays_.cells = static_cast<int>(cellType_.size());
+    arrays_.namedNets = static_cast<int>(sortedNames_.size());
+    arrays_.initial = pointer(initial_);
+    arrays_.cellType = pointer(cellType_);
+    arrays_.cellDelay = pointer(cellDelay_);
+    arrays_.cellInputOffset = pointer(cellInputOffset_);
+    arrays_.cellInputs = pointer(cellInputs_);
+    arrays_.cellOutput = pointer(cellOutput_);
+    arrays_.fanoutOffset = pointer(fanoutOffset_);
+    arrays_.fanout = pointer(fanout_);
+    arrays_.driver = pointer(driver_);
+    arrays_.nameOffset = pointer(nameOffset_);
+    arrays_.names = pointer(names_);
+    arrays_.sortedNames = pointer(sortedNames_);
+}
+
+FlatNetlist* FlatNetlist::map(const string &fileName, unsigned long long key)
+{
+    MappedFile *file = new MappedFile(fileName);
+    const char *data = file->getData();
+
+    FileHeader h;
+    if (!file->isOpen() || file->getSize() < sizeof(FileHeader))
+    {
+        delete file;
+        return NULL;
+    }
+
+    memcpy(&h, data, sizeof(FileHeader));
+
+    bool valid = memcmp(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0
+                 && h.byteOrder == FILE_BYTE_ORDER && h.version == FILE_VERSION && h.key == key
+                 && h.nets >= 0 && h.cells >= 0 && h.inputs >= 0 && h.fanout >= 0
+                 && h.names >= 0 && h.namedNets >= 0 && h.ports >= 0 && h.portNames >= 0;
+
+    unsigned long offset = sizeof(FileHeader);
+    unsigned long at[16];
+    if (valid)
+    {
+        at[0] = section<int>(offset, h.nets);
+        at[1] = section<int>(offset, h.cells);
+        at[2] = section<unsigned int>(offset, h.cells);
+        at[3] = section<int>(offset, h.cells + 1);
+        at[4] = section<int>(offset, h.inputs);
+        at[5] = section<int>(offset, h.cells);
+        at[6] = section<int>(offset, h.nets + 1);
+        at[7] = section<int>(offset, h.fanout);
+        at[8] = section<int>(offset, h.nets);
+        at[9] = section<int>(offset, h.nets);
+        at[10] = section<char>(offset, h.names);
+        at[11] = section<int>(offset, h.namedNets);
+        at[12] = section<int>(offset, h.ports);
+        at[13] = section<int>(offset, h.ports);
+        at[14] = section<int>(offset, h.ports);
+        at[15] = section<char>(offset, h.portNames);
+
+        valid = (offset == file->getSize());
+    }
+
+    // Every port name, including the last one, should end within the pool.
+    if (valid && h.ports > 0)
+    {
+        const char *pool = data + at[15];
+        valid = (h.portNames > 0 && pool[h.portNames-1] == '\0'
+                 && count(pool, pool + h.portNames, '\0') >= h.ports);
+    }
+
+    if (!valid)
+    {
+        delete file;
+        return NULL;
+    }
+
+    FlatNetlist *netlist = new FlatNetlist(file);
+    Arrays &a = netlist->arrays_;
+
+    a.nets = h.nets;
+    a.cells = h.cells;
+    a.namedNets = h.namedNets;
+    a.initial = reinterpret_cast<const int*>(data + at[0]);
+    a.cellType = reinterpret_cast<const int*>(data + at[1]);
+    a.cellDelay = reinterpret_cast<const unsigned int*>(data + at[2]);
+    a.cellInputOffset = reinterpret_cast<const int*>(data + at[3]);
+    a.cellInputs = reinterpret_cast<const int*>(data + at[4]);
+    a.cellOutput = reinterpret_cast<const int*>(data + at[5]);
+    a.fanoutOffset = reinterpret_cast<const int*>(data + at[6]);
+    a.fanout = reinterpret_cast<const int*>(data + at[7]);
+    a.driver = reinterpret_cast<const int*>(data + at[8]);
+    a.nameOffset = reinterpret_cast<const int*>(data + at[9]);
+    a.names = data + at[10];
+    a.sortedNames = reinterpret_cast<const int*>(data + at[11]);
+
+    // The ports are few, and are copied out of the file.
+    const int *dir = reinterpret_cast<const int*>(data + at[12]);
+    const int *net = reinterpret_cast<const int*>(data + at[13]);
+    const int *width = reinterpret_cast<const int*>(data + at[14]);
+    const char *name = data + at[15];
+
+    for (int i = 0; i < h.ports; i++)
+    {
+        netlist->portName_.push_back(string(name));
+        netlist->portDir_.push_back(dir[i]);
+        netlist->portNet_.push_back(net[i]);
+        netlist->portWidth_.push_back(width[i]);
+
+        name += netlist->portName_.back().size() + 1;
+    }
+
+    if (!netlist->isConsistent(h.inputs, h.fanout, h.names))
+    {
+        delete netlist;
+        return NULL;
+    }
+
+    return netlist;
+}
+
+bool FlatNetlist::isConsistent(int inputs, int fanout, int names) const
+{
+    const Arrays &a = arrays_;
+
+    if (a.cellInputOffset[0] != 0 || a.fanoutOffset[0] != 0)
+        return false;
+
+    for (int n = 0; n < a.nets; n++)
+    {
+        if (a.initial[n] < LOW || a.initial[n] > HIGH_IMPEDENCE)
+            return false;
+        if (a.fanoutOffset[n+1] < a.fanoutOffset[n])
+            return false;
+        if (a.driver[n] < -1 || a.driver[n] >= a.cells)
+            return false;
+        if (a.nameOffset[n] < -1 || a.nameOffset[n] >= names)
+            return false;
+    }
+
+    // The last name, like every other, should end within the pool.
+    if (names > 0 && a.names[names-1] != '\0')
+        return false;
+
+    for (int c = 0; c < a.cells; c++)
+    {
+        int first = a.cellInputOffset[c], last = a.cellInputOffset[c+1];
+
+        if (last < first || !Circuit::suitsCell(a.cellType[c], last - first))
+            return false;
+        if (a.cellOutput[c] < 0 || a.cellOutput[c] >= a.nets)
+            return false;
+    }
+
+    // The offsets are in order; the last ones should end the arrays.
+    if (a.cellInputOffset[a.cells] != inputs || a.fanoutOffset[a.nets] != fanout)
+        return false;
+
+    for (int i = 0; i < inputs; i++)
+    {
+        if (a.cellInputs[i] < 0 || a.cellInputs[i] >= a.nets)
+            return false;
+    }
+
+    for (int i = 0; i < fanout; i++)
+    {
+        if (a.fanout[i] < 0 || a.fanout[i] >= a.cells)
+            return false;
+    }
+
+    for (int i = 0; i < a.namedNets; i++)
+    {
+        int net = a.sortedNames[i];
+        if (net < 0 || net >= a.nets || a.nameOffset[net] < 0)
+            return false;
+    }
+
+    for (unsigned int p = 0; p < portName_.size(); p++)
+    {
+        if (portDir_[p] != INPUT_PORT && portDir_[p] != OUTPUT_PORT)
+            return false;
+        if (portWidth_[p] < 0 || portNet_[p] < 0 || portNet_[p] > a.nets - portWidth_[p])
+            return false;
+    }
+
+    return true;
+}
+
+void FlatNetlist::save(const string &fileName, unsigned long long key) const
+                       throw (NetlistException)
+{
+    const Arrays &a = arrays_;
+    int ports = getPortCount();
+
+    string portNames;
+    for (int i = 0; i < ports; i++)
+    {
+        portNames += portName_[i];
+        portNames += '\0';
+    }
+
+    FileHeader h;
+    memset(&h, 0, sizeof(FileHeader));
+    memcpy(h.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    h.byteOrder = FILE_BYTE_ORDER;
+    h.version = FILE_VERSION;
+    h.key = key;
+    h.nets = a.nets;
+    h.cells = a.cells;
+    h.inputs = a.cellInputOffset[a.cells];
+    h.fanout = a.fanoutOffset[a.nets];
+    h.names = 0;
+    h.namedNets = a.namedNets;
+    h.ports = ports;
+    h.portNames = static_cast<int>(portNames.size());
+
+    // The name pool ends with the terminating '\0' of the name at the largest offset.
+    for (int n = 0; n < a.nets; n++)
+    {
+        if (a.nameOffset[n] >= h.names)
+            h.names = a.nameOffset[n] + static_cast<int>(strlen(a.names + a.nameOffset[n])) + 1;
+    }
+
+    // The netlist is written to a temporary file which then replaces the file. A netlist
+    // mapped from the old file keeps its data, as the old file is not written over.
+    ostringstream ss;
+    ss << fileName << ".tmp" << getpid();
+    string tempName = ss.str();
+
+    ofstream out(tempName.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!out)
+        throw NetlistException("Unable to open " + tempName + " for writing.");
+
+    write(out, &h, 1);
+    write(out, a.initial, h.nets);
+    write(out, a.cellType, h.cells);
+    write(out, a.cellDelay, h.cells);
+    write(out, a.cellInputOffset, h.cells + 1);
+    write(out, a.cellInputs, h.inputs);
+    write(out, a.cellOutput, h.cells);
+    write(out, a.fanoutOffset, h.nets + 1);
+    write(out, a.fanout, h.fanout);
+    write(out, a.driver, h.nets);
+    write(out, a.nameOffset, h.nets);
+    write(out, a.names, h.names);
+    write(out, a.sortedNames, h.namedNets);
+    write(out, pointer(portDir_), ports);
+    write(out, pointer(portNet_), ports);
+    write(out, pointer(portWidth_), ports);
+    write(out, portNames.data(), h.portNames);
+
+    out.close();
+    if (!out)
+    {
+        remove(tempName.c_str());
+        throw NetlistException("Unable to write " + tempName + ".");
+    }
+
+#if defined(_WIN32)
+    // A file cannot be renamed over an existing one on Windows, where the netlists are
+    // read into memory rather than mapped.
+    remove(fileName.c_str());
+#endif
+
+    if (rename(tempName.c_str(), fileName.c_str()) != 0)
+    {
+        remove(tempName.c_str());
+        throw NetlistException("Unable to write " + fileName + ".");
+    }
+}
+
+void FlatNetlist::setNetName(int net, const string &name)
+{
+    if (nameOffset_[net] >= 0)
+        return;
+
+    nameOffset_[net] = static_cast<int>(names_.size());
+    names_.insert(names_.end(), name.begin(), name.end());
+    names_.push_back('\0');
+}
+
+void FlatNetlist::flatten(const Circuit &def, vector<int> &netMap, const string &prefix,
+                          vector<const Circuit*> &stack) throw (NetlistException)
+{
+    stack.push_back(&def);
+
+    // The nets which are not connected to the enclosing circuit are new nets.
+    for (int i = 0; i < def.netCount_; i++)
+    {
+        if (netMap[i] < 0)
+        {
+            netMap[i] = static_cast<int>(initial_.size());
+            initial_.push_back(UNKNOWN);
+            nameOffset_.push_back(-1);
+        }
+    }
+
+    std::map< string, pair<int, int> >::const_iterator nameIter;
+    for (nameIter = def.netNames_.begin(); nameIter != def.netNames_.end(); ++nameIter)
+    {
+        int first = nameIter->second.first, width = nameIter->second.second;
+        if (width == 1)
+        {
+            setNetName(netMap[first], prefix + nameIter->first);
+            continue;
+        }
+
+        for (int b = 0; b < width; b++)
+        {
+            ostringstream ss;
+            ss << prefix << nameIter->first << "[" << b << "]";
+            setNetName(netMap[first + b], ss.str());
+        }
+    }
+
+    for (unsigned int i = 0; i < def.constants_.size(); i++)
+        initial_[netMap[def.constants_[i].first]] = def.constants_[i].second;
+
+    for (unsigned int c = 0; c < def.cellType_.size(); c++)
+    {
+        cellType_.push_back(def.cellType_[c]);
+        cellDelay_.push_back(def.cellDelay_[c]);
+
+        for (int i = def.cellInputOffset_[c]; i < def.cellInputOffset_[c+1]; i++)
+            cellInputs_.push_back(netMap[def.cellInputs_[i]]);
+
+        cellInputOffset_.push_back(static_cast<int>(cellInputs_.size()));
+        cellOutput_.push_back(netMap[def.cellOutput_[c]]);
+    }
+
+    for (unsigned int i = 0; i < def.instances_.size(); i++)
+    {
+        const Circuit::Instance &inst = def.instances_[i];
+
+        if (find(stack.begin(), stack.end(), inst.def) != stack.end())
+            throw NetlistException("Circuit " + inst.def->name_ + " instantiates itself through instance "
+                                   + prefix + inst.name + ".");
+
+        vector<int> subMap(inst.def->netCount_, -1);
+        for (unsigned int k = 0; k < inst.connections.size(); k++)
+        {
+            const Circuit::Port &port = inst.def->ports_[inst.connections[k].first];
+            const vector<int> &nets = inst.connections[k].second;
+
+            for (int b = 0; b < port.width; b++)
+                subMap[port.net + b] = netMap[nets[b]];
+        }
+
+        flatten(*inst.def, subMap, prefix + inst.name + ".", stack);
+    }
+
+    stack.pop_back();
+}
+
+void FlatNetlist::order(void)
+{
+    int cells = static_cast<int>(cellType_.size()), nets = static_cast<int>(initial_.size());
+
+    driver_.assign(nets, -1);
+    for (int c = 0; c < cells; c++)
+    {
+        int out = cellOutput_[c];
+        if (driver_[out] >= 0)
+        {
+            ostringstream ss;
+            ss << "Net ";
+            if (nameOffset_[out] >= 0)
+                ss << &names_[nameOffset_[out]];
+            else
+                ss << out;
+            ss << " is driven by more than one cell.";
+            throw NetlistException(ss.str());
+        }
+
+        driver_[out] = c;
+    }
+
+    // The number of inputs of every cell which are driven by zero delay combinational
+    // cells yet to be ordered.
+    vector<int> pending(cells, 0);
+    vector<int> readers(nets + 1, 0), reader;
+    for (int c = 0; c < cells; c++)
+    {
+        for (int i = cellInputOffset_[c]; i < cellInputOffset_[c+1]; i++)
+        {
+            int d = driver_[cellInputs_[i]];
+            if (d >= 0 && !isSequential(cellType_[d]) && cellDelay_[d] == 0)
+                pending[c]++;
+
+            readers[cellInputs_[i] + 1]++;
+        }
+    }
+
+    for (int n = 0; n < nets; n++)
+        readers[n+1] += readers[n];
+
+    reader.resize(cellInputs_.size());
+    vector<int> fill(readers.begin(), readers.end() - 1);
+    for (int c = 0; c < cells; c++)
+    {
+        for (int i = cellInputOffset_[c]; i < cellInputOffset_[c+1]; i++)
+            reader[fill[cellInputs_[i]]++] = c;
+    }
+
+    vector<int> sequence;
+    sequence.reserve(cells);
+    for (int c = 0; c < cells; c++)
+    {
+        if (pending[c] == 0)
+            sequence.push_back(c);
+    }
+
+    for (unsigned int k = 0; k < sequence.size(); k++)
+    {
+        int c = sequence[k];
+        if (isSequential(cellType_[c]) || cellDelay_[c] != 0)
+            continue;
+
+        int out = cellOutput_[c];
+        for (int i = readers[out]; i < readers[out+1]; i++)
+        {
+            if (--pending[reader[i]] == 0)
+                sequence.push_back(reader[i]);
+        }
+    }
+
+    // The cells on the combinational loops are never ready.
+    for (int c = 0; c < cells; c++)
+    {
+        if (pending[c] > 0)
+            sequence.push_back(c);
+    }
+
+    vector<int> type(cells), output(cells), offset(1, 0), inputs;
+    vector<unsigned int> delay(cells);
+    inputs.reserve(cellInputs_.size());
+    offset.reserve(cells + 1);
+
+    for (int k = 0; k < cells; k++)
+    {
+        int c = sequence[k];
+
+        type[k] = cellType_[c];
+        delay[k] = cellDelay_[c];
+        output[k] = cellOutput_[c];
+        inputs.insert(inputs.end(), cellInputs_.begin() + cellInputOffset_[c],
+                      cellInputs_.begin() + cellInputOffset_[c+1]);
+        offset.push_back(static_cast<int>(inputs.size()));
+    }
+
+    cellType_.swap(type);
+    cellDelay_.swap(delay);
+    cellOutput_.swap(output);
+    cellInputs_.swap(inputs);
+    cellInputOffset_.swap(offset);
+}
+
+void FlatNetlist::index(void) throw (NetlistException)
+{
+    int cells = static_cast<int>(cellType_.size()), nets = static_cast<int>(initial_.size());
+
+    driver_.assign(nets, -1);
+    for (int c = 0; c < cells; c++)
+        driver_[cellOutput_[c]] = c;
+
+    // A cell reading a net at more than one input appears once in its fanout.
+    vector<int> last(nets, -1);
+    fanoutOffset_.assign(nets + 1, 0);
+    for (int c = 0; c < cells; c++)
+    {
+        for (int i = cellInputOffset_[c]; i < cellInputOffset_[c+1]; i++)
+        {
+            int net = cellInputs_[i];
+            if (last[net] != c)
+            {
+                last[net] = c;
+                fanoutOffset_[net + 1]++;
+            }
+        }
+    }
+
+    for (int n = 0; n < nets; n++)
+        fanoutOffset_[n+1] += fanoutOffset_[n];
+
+    fanout_.resize(fanoutOffset_[nets]);
+    vector<int> fill(fanoutOffset_.begin(), fanoutOffset_.end() - 1);
+    last.assign(nets, -1);
+    for (int c = 0; c < cells; c++)
+    {
+        for (int i = cellInputOffset_[c]; i < cellInputOffset_[c+1]; i++)
+        {
+            int net = cellInputs_[i];
+            if (last[net] != c)
+            {
+                last[net] = c;
+                fanout_[fill[net]++] = c;
+            }
+        }
+    }
+
+    sortedNames_.clear();
+    for (int n = 0; n < nets; n++)
+    {
+        if (nameOffset_[n] >= 0)
+            sortedNames_.push_back(n);
+    }
+
+    sort(sortedNames_.begin(), sortedNames_.end(), NameLess(names_, nameOffset_));
+}
+
+int FlatNetlist::findCombinationalLoops(vector< vector<int> > &loops) const
+{
+    const Arrays &a = arrays_;
+    loops.clear();
+
+    // Tarjan's algorithm, with an explicit stack as the netlists can be very deep. For
+    // every cell on the depth first path, edge holds the position in the fanout of its
+    // output of the next cell to visit.
+    vector<int> index(a.cells, -1), low(a.cells, 0), edge(a.cells, 0), path, component;
+    vector<bool> onComponent(a.cells, false);
+    int count = 0;
+
+    for (int root = 0; root < a.cells; root++)
+    {
+        if (index[root] >= 0 || !isZeroDelayCombinational(a.cellType[root], a.cellDelay[root]))
+            continue;
+
+        index[root] = low[root] = count++;
+        edge[root] = a.fanoutOffset[a.cellOutput[root]];
+        path.push_back(root);
+        component.push_back(root);
+        onComponent[root] = true;
+
+        while (path.size() != 0)
+        {
+            int c = path.back(), out = a.cellOutput[c];
+
+            if (edge[c] < a.fanoutOffset[out+1])
+            {
+                int d = a.fanout[edge[c]++];
+                if (!isZeroDelayCombinational(a.cellType[d], a.cellDelay[d]))
+                    continue;
+
+                if (index[d] < 0)
+                {
+                    index[d] = low[d] = count++;
+                    edge[d] = a.fanoutOffset[a.cellOutput[d]];
+                    path.push_back(d);
+                    component.push_back(d);
+                    onComponent[d] = true;
+                }
+                else if (onComponent[d] && index[d] < low[c])
+                {
+                    low[c] = index[d];
+                }
+
+                continue;
+            }
+
+            path.pop_back();
+            if (path.size() != 0 && low[c] < low[path.back()])
+                low[path.back()] = low[c];
+
+            if (low[c] != index[c])
+                continue;
+
+            vector<int> nets;
+            int d;
+            do
+            {
+                d = component.back();
+                component.pop_back();
+                onComponent[d] = false;
+                nets.push_back(a.cellOutput[d]);
+            }
+            while (d != c);
+
+            bool loop = nets.size() > 1;
+            for (int i = a.cellInputOffset[c]; !loop && i < a.cellInputOffset[c+1]; i++)
+                loop = (a.cellInputs[i] == out);
+
+            if (loop)
+            {
+                sort(nets.begin(), nets.end());
+                loops.push_back(nets);
+            }
+        }
+    }
+
+    return static_cast<int>(loops.size());
+}
+
+string FlatNetlist::getNetName(int net) const
+{
+    if (arrays_.nameOffset[net] < 0)
+        return string();
+
+    return string(arrays_.names + arrays_.nameOffset[net]);
+}
+
+int FlatNetlist::findNet(const string &name) const
+{
+    int low = 0, high = arrays_.namedNets - 1;
+
+    while (low <= high)
+    {
+        int mid = (low + high) / 2, net = arrays_.sortedNames[mid];
+        int cmp = strcmp(arrays_.names + arrays_.nameOffset[net], name.c_str());
+
+        if (cmp == 0)
+            return net;
+        else if (cmp < 0)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+
+    return -1;
+}
+
+int FlatNetlist::findPort(const string &name) const
+{
+    for (unsigned int i = 0; i < portName_.size(); i++)
+    {
+        if (portName_[i] == name)
+            return static_cast<int>(i);
+    }
+
+    return -1;
+}
@@ -24,20 +24,109 @@
 
 #include <lcs/hiddenmodman.h>
 #include <lcs/module.h>
+#include <lcs/line.h>
+#include <algorithm>
+#include <utility>
 
 using namespace lcs;
+using namespace std;
 
-List<Module*> HiddenModuleManager::modList = List<Module*>();
+// The size of the chunks of the arena. A module larger than a quarter of a chunk gets a
+// chunk of its own.
+static const size_t CHUNK_SIZE = 64 * 1024;
+
+// The alignment of the memory returned for every module.
+static const size_t ALIGNMENT = 16;
+
+vector<Module*> HiddenModuleManager::arenaMods;
+vector<Module*> HiddenModuleManager::heapMods;
+vector<Line*> HiddenModuleManager::detached;
+vector<char*> HiddenModuleManager::chunks;
+size_t HiddenModuleManager::used = CHUNK_SIZE;
+bool HiddenModuleManager::destroying = false;
+
+void* HiddenModuleManager::allocate(size_t size)
+{
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    if (size > CHUNK_SIZE / 4)
+    {
+        // The chunk is placed before the last one, so that the space left in the last one
+        // is still used.
+        char *chunk = new char[size];
+        chunks.insert(chunks.end() - (chunks.empty() ? 0 : 1), chunk);
+
+        return chunk;
+    }
+
+    if (used + size > CHUNK_SIZE)
+    {
+        chunks.push_back(new char[CHUNK_SIZE]);
+        used = 0;
+    }
+
+    void *mem = chunks.back() + used;
+    used += size;
+
+    return mem;
+}
+
+void HiddenModuleManager::registerModule(Module *mod, bool inArena)
+{
+    if (mod == NULL)
+        return;
+
+    if (inArena)
+        arenaMods.push_back(mod);
+    else
+        heapMods.push_back(mod);
+}
+
+void HiddenModuleManager::detachLine(Line *line)
+{
+    detached.push_back(line);
+}
 
 void HiddenModuleManager::destroyModules(void)
 {
-    ListIterator<Module*> li = modList.getListIterator();
+    destroying = true;
+
+    for (unsigned int i = 0; i < heapMods.size(); i++)
+        delete heapMods[i];
+
+    for (unsigned int i = 0; i < arenaMods.size(); i++)
+        arenaMods[i]->~Module();
 
-    li.reset();
-    while (li.hasNext())
+    destroying = false;
+
+    // The modules are only compared with the ones registered with the lines from here on.
+    vector<Module*> mods(arenaMods);
+    mods.insert(mods.end(), heapMods.begin(), heapMods.end());
+    sort(mods.begin(), mods.end());
+
+    // The detached copies of the same line share the reference list; every line is swept
+    // once.
+    vector< pair< List<Line*>*, Line* > > lines(detached.size());
+    for (unsigned int i = 0; i < detached.size(); i++)
+        lines[i] = make_pair(detached[i]->refList, detached[i]);
+
+    sort(lines.begin(), lines.end());
+
+    for (unsigned int i = 0; i < lines.size(); i++)
     {
-        Module *mod = li.next();
-        if (mod != NULL)
-            delete mod;
+        if (i == 0 || lines[i].first != lines[i-1].first)
+            lines[i].second->removeModules(mods);
     }
+
+    for (unsigned int i = 0; i < lines.size(); i++)
+        delete lines[i].second;
+
+    for (unsigned int i = 0; i < chunks.size(); i++)
+        delete [] chunks[i];
+
+    vector<Module*>().swap(arenaMods);
+    vector<Module*>().swap(heapMods);
+    vector<Line*>().swap(detached);
+    vector<char*>().swap(chunks);
+    used = CHUNK_SIZE;
 }
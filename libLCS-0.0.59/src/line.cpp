@@ -24,6 +24,8 @@
 
 #include <lcs/bus.h>
 #include <lcs/systime.h>
+#include <lcs/notifybatch.h>
+#include <algorithm>
 
 using namespace lcs;
 using namespace std;
@@ -47,7 +49,7 @@ Line::Line(const Line& line)
       changeModList(line.changeModList),
       posEdgeList(line.posEdgeList), negEdgeList(line.negEdgeList),
       changeModIdList(line.changeModIdList), posEdgeIdList(line.posEdgeIdList),
-      negEdgeIdList(line.negEdgeIdList),
+      negEdgeIdList(line.negEdgeIdList), changeModBitList(line.changeModBitList),
       nextChangeTimeQueue(line.nextChangeTimeQueue),
       zeroDelayChangeTimeQueue(line.zeroDelayChangeTimeQueue),
       valueQueue(line.valueQueue), zeroDelayValueQueue(line.zeroDelayValueQueue)
@@ -60,25 +62,43 @@ Line::~Line()
 {
     if (*refCount <= 1)
     {
+        SystemTimer::forgetLine(refList);
         delete val; delete refCount; delete delay_; delete refList;
     }
     else
     {
+        // The copies are usually destroyed in, or in the reverse of, the order in which
+        // they were made; hence, they are searched for from both ends of the list.
         (*refCount)--;
-        refList->removeFirstMatch(this);
+        refList->removeMatch(this);
     }
 }
 
-void Line::notify(const LineEvent &event, Module *mod, const int &portId)
+void Line::notify(const LineEvent &event, Module *mod, const int &portId, int bit)
 {
     if (mod != NULL)
     {
         if (event == LINE_STATE_CHANGE)
         {
-            if (!changeModList.isPresent(mod))
+            // A module told of the indices of the lines is registered once for every index
+            // at which the line is connected, and otherwise only once.
+            bool present = false;
+            ListIterator<Module*> modIter = changeModList.getListIterator();
+            ListIterator<int> bitIter = changeModBitList.getListIterator();
+
+            modIter.reset(); bitIter.reset();
+            while (modIter.hasNext() && !present)
+            {
+                Module *m = modIter.next();
+                int b = bitIter.next();
+                present = (m == mod && (bit < 0 || b == bit));
+            }
+
+            if (!present)
             {
                 changeModList.append(mod);
                 changeModIdList.append(portId);
+                changeModBitList.append(bit);
             }
         }
         else if (event == LINE_POS_EDGE)
@@ -100,19 +120,103 @@ void Line::stopNotification(const LineEvent& event, Module *mod, const int &port
     {
         if (event == LINE_STATE_CHANGE)
         {
-            changeModList.removeFirstMatch(mod);
-            changeModIdList.removeFirstMatch(portId);
+            int index = removeModule(changeModList, changeModIdList, mod, portId);
+            if (index >= 0)
+                changeModBitList.removeAt(index);
         }
         else if (event == LINE_POS_EDGE)
-        {
-            posEdgeList.removeFirstMatch(mod);
-            posEdgeIdList.removeFirstMatch(portId);
-        }
+            removeModule(posEdgeList, posEdgeIdList, mod, portId);
         else if (event == LINE_NEG_EDGE)
+            removeModule(negEdgeList, negEdgeIdList, mod, portId);
+    }
+}
+
+int Line::removeModule(List<Module*> &modList, List<int> &idList, Module *mod, int portId)
+{
+    // The module list and the port id list are parallel lists. Hence, the entries are
+    // removed from the same position in both of them.
+    ListIterator<Module*> modIter = modList.getListIterator();
+    ListIterator<int> idIter = idList.getListIterator();
+
+    int index = 0, match = -1;
+    modIter.reset(); idIter.reset();
+    while (modIter.hasNext())
+    {
+        Module *m = modIter.next();
+        int id = idIter.next();
+
+        if (m == mod)
         {
-            negEdgeList.removeFirstMatch(mod);
-            negEdgeIdList.removeFirstMatch(portId);
+            if (id == portId)
+            {
+                match = index;
+                break;
+            }
+            else if (match < 0)
+                match = index;
         }
+
+        index++;
+    }
+
+    if (match >= 0)
+    {
+        modList.removeAt(match);
+        idList.removeAt(match);
+    }
+
+    return match;
+}
+
+void Line::removeModules(const vector<Module*> &mods)
+{
+    removeModules(changeModList, changeModIdList, &changeModBitList, mods);
+    removeModules(posEdgeList, posEdgeIdList, NULL, mods);
+    removeModules(negEdgeList, negEdgeIdList, NULL, mods);
+}
+
+void Line::removeModules(List<Module*> &modList, List<int> &idList, List<int> *bitList,
+                         const vector<Module*> &mods)
+{
+    vector<Module*> keptMods;
+    vector<int> keptIds, keptBits;
+
+    ListIterator<Module*> modIter = modList.getListIterator();
+    ListIterator<int> idIter = idList.getListIterator();
+    ListIterator<int> bitIter = (bitList != NULL) ? bitList->getListIterator()
+                                                  : ListIterator<int>();
+
+    modIter.reset(); idIter.reset(); bitIter.reset();
+    while (modIter.hasNext())
+    {
+        Module *m = modIter.next();
+        int id = idIter.next();
+        int bit = (bitList != NULL) ? bitIter.next() : -1;
+
+        if (binary_search(mods.begin(), mods.end(), m))
+            continue;
+
+        keptMods.push_back(m);
+        keptIds.push_back(id);
+        keptBits.push_back(bit);
+    }
+
+    if (static_cast<int>(keptMods.size()) == modList.getSize())
+        return;
+
+    // The lists are shared by all the copies of the line; they are emptied and refilled
+    // in place.
+    modList.destroy();
+    idList.destroy();
+    if (bitList != NULL)
+        bitList->destroy();
+
+    for (unsigned int i = 0; i < keptMods.size(); i++)
+    {
+        modList.append(keptMods[i]);
+        idList.append(keptIds[i]);
+        if (bitList != NULL)
+            bitList->append(keptBits[i]);
     }
 }
 
@@ -127,7 +231,12 @@ void Line::setAssDelay(unsigned int delay)
     *delay_ = delay;
 }
 
-void Line::hiddenUpdate(void)
+void Line::setName(const string &name)
+{
+    SystemTimer::nameLine(refList, name);
+}
+
+void Line::hiddenUpdate(NotificationBatch *batch)
 {
     if (zeroDelayChangeTimeQueue.getSize() == 0)
     {
@@ -144,11 +253,11 @@ void Line::hiddenUpdate(void)
         LineState value = zeroDelayValueQueue.getFirstInQueue();
         zeroDelayValueQueue.deQueue();
 
-        setLineValue(value);
+        setLineValue(value, batch);
     }
 }
 
-void Line::update(void)
+void Line::update(NotificationBatch *batch)
 {
     if (nextChangeTimeQueue.getSize() == 0)
     {
@@ -165,60 +274,72 @@ void Line::update(void)
         LineState value = valueQueue.getFirstInQueue();
         valueQueue.deQueue();
 
-        setLineValue(value);
+        setLineValue(value, batch);
     }
 }
 
 void Line::operator=(const LineState& value)
 {
     if (*delay_ != 0)
-    {
-        SystemTimer::notifyLine(refList);
+        assignLater(value, *delay_);
+    else
+        assignNow(value);
+}
+
+void Line::assignLater(const LineState &value, unsigned int delay)
+{
+    // The delay is kept with the line, as the assignments made without a delay take the
+    // delay of the last one made with a delay.
+    *delay_ = delay;
 
-        unsigned int nextTime = SystemTimer::getTime() + *delay_;
+    SystemTimer::notifyLine(refList);
 
-        nextChangeTimeQueue.removeLower(nextTime);
-        valueQueue.removeLower(nextTime);
+    unsigned int nextTime = SystemTimer::getTime() + delay;
 
-        nextChangeTimeQueue.enQueue(nextTime, nextTime);
-        valueQueue.enQueue(value, nextTime);
+    nextChangeTimeQueue.removeLower(nextTime);
+    valueQueue.removeLower(nextTime);
 
+    nextChangeTimeQueue.enQueue(nextTime, nextTime);
+    valueQueue.enQueue(value, nextTime);
+}
+
+void Line::assignNow(const LineState &value)
+{
+    if (*delay_ != 0)
+        setAssDelay(0);
+
+    if (SystemTimer::deferWrite(refList, value))
         return;
+
+    if (zeroDelayValueQueue.getSize() == 0)
+    {
+        if (value == *val)
+            return;
+        else
+        {
+            SystemTimer::notifyHiddenTick(refList);
+            zeroDelayChangeTimeQueue.enQueue(SystemTimer::getHiddenTime() + 1);
+            zeroDelayValueQueue.enQueue(value);
+        }
     }
-    else
+    else if (zeroDelayValueQueue.getSize() == 1)
     {
-        if (zeroDelayValueQueue.getSize() == 0)
+        LineState qval = zeroDelayValueQueue.getFirstInQueue();
+        if (qval == value)
+            return;
+        else if (*val == value)
         {
-            if (value == *val)
-                return;
-            else
-            {
-                SystemTimer::notifyHiddenTick(refList);
-                zeroDelayChangeTimeQueue.enQueue(SystemTimer::getHiddenTime() + 1);
-                zeroDelayValueQueue.enQueue(value);
-            }
+            zeroDelayChangeTimeQueue.deQueue();
+            zeroDelayValueQueue.deQueue();
         }
-        else if (zeroDelayValueQueue.getSize() == 1)
+        else
         {
-            LineState qval = zeroDelayValueQueue.getFirstInQueue();
-            if (qval == value)
-                return;
-            else if (*val == value)
-            {
-                zeroDelayChangeTimeQueue.deQueue();
-                zeroDelayValueQueue.deQueue();
-            }
-            else
-            {
-                zeroDelayChangeTimeQueue.deQueue();
-                zeroDelayValueQueue.deQueue();
+            zeroDelayChangeTimeQueue.deQueue();
+            zeroDelayValueQueue.deQueue();
 
-                zeroDelayChangeTimeQueue.enQueue(SystemTimer::getHiddenTime() + 1);
-                zeroDelayValueQueue.enQueue(value);
-            }
+            zeroDelayChangeTimeQueue.enQueue(SystemTimer::getHiddenTime() + 1);
+            zeroDelayValueQueue.enQueue(value);
         }
-
-        return;
     }
 }
 
@@ -227,7 +348,7 @@ const Line& Line::operator=(const Line &line)
     if (*refCount > 1)
     {
         (*refCount)--;
-        refList->removeFirstMatch(this);
+        refList->removeMatch(this);
 
         val = line.val;
         delay_ = line.delay_;
@@ -237,6 +358,7 @@ const Line& Line::operator=(const Line &line)
         changeModIdList = line.changeModIdList;
         posEdgeIdList = line.posEdgeIdList;
         negEdgeIdList = line.negEdgeIdList;
+        changeModBitList = line.changeModBitList;
         refCount = line.refCount;
         valueQueue = line.valueQueue;
         nextChangeTimeQueue = line.nextChangeTimeQueue;
@@ -259,6 +381,7 @@ const Line& Line::operator=(const Line &line)
         changeModIdList = line.changeModIdList;
         posEdgeIdList = line.posEdgeIdList;
         negEdgeIdList = line.negEdgeIdList;
+        changeModBitList = line.changeModBitList;
         refCount = line.refCount;
         valueQueue = line.valueQueue;
         nextChangeTimeQueue = line.nextChangeTimeQueue;
@@ -273,7 +396,7 @@ const Line& Line::operator=(const Line &line)
     return *this;
 }
 
-void Line::setLineValue(const LineState &value)
+void Line::setLineValue(const LineState &value, NotificationBatch *batch)
 {
     bool posEdge = false;
     if (value == HIGH && (*val == LOW || *val == UNKNOWN))
@@ -281,16 +404,33 @@ void Line::setLineValue(const LineState &value)
 
     if (*val != value)
     {
+        BitChange change;
+        change.previous = *val;
+
         *val = value;
 
         ListIterator<Module*> changeIter = changeModList.getListIterator();
         ListIterator< int > changeIdIter = changeModIdList.getListIterator();
+        ListIterator< int > changeBitIter = changeModBitList.getListIterator();
 
-        changeIter.reset(); changeIdIter.reset();
+        changeIter.reset(); changeIdIter.reset(); changeBitIter.reset();
         while (changeIter.hasNext())
         {
             Module *mod = changeIter.next();
-            mod->onStateChange(changeIdIter.next());
+            change.portId = changeIdIter.next();
+            change.bit = changeBitIter.next();
+
+            if (change.bit >= 0)
+            {
+                if (batch != NULL)
+                    batch->add(mod, change);
+                else
+                    mod->onBitsChange(change.portId, &change, 1);
+            }
+            else if (batch != NULL)
+                batch->add(mod, change.portId, LINE_STATE_CHANGE);
+            else
+                mod->onStateChange(change.portId);
         }
 
         if (posEdge)
@@ -302,7 +442,10 @@ void Line::setLineValue(const LineState &value)
             while (posEdgeIter.hasNext())
             {
                 Module *mod = posEdgeIter.next();
-                mod->onPosEdge(posEdgeIdIter.next());
+                if (batch != NULL)
+                    batch->add(mod, posEdgeIdIter.next(), LINE_POS_EDGE);
+                else
+                    mod->onPosEdge(posEdgeIdIter.next());
             }
         }
         else
@@ -314,7 +457,10 @@ void Line::setLineValue(const LineState &value)
             while (negEdgeIter.hasNext())
             {
                 Module *mod = negEdgeIter.next();
-                mod->onNegEdge(negEdgeIdIter.next());
+                if (batch != NULL)
+                    batch->add(mod, negEdgeIdIter.next(), LINE_NEG_EDGE);
+                else
+                    mod->onNegEdge(negEdgeIdIter.next());
             }
         }
     }
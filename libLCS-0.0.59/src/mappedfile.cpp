@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/mappedfile.h>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace lcs;
+using namespace std;
+
+MappedFile::MappedFile(const string &fileName)
+    : data_(NULL), size_(0), mapped_(false), open_(false)
+{
+#if !defined(_WIN32)
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    // An empty file cannot be mapped, and has nothing to map.
+    struct stat info;
+    bool sized = (fstat(fd, &info) == 0);
+
+    if (sized && info.st_size == 0)
+        open_ = true;
+    else if (sized && info.st_size > 0)
+    {
+        void *addr = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            data_ = static_cast<const char*>(addr);
+            size_ = static_cast<unsigned long>(info.st_size);
+            mapped_ = open_ = true;
+        }
+    }
+
+    // The mapping stays valid after the file is closed.
+    close(fd);
+
+    if (open_)
+        return;
+#endif
+
+    ifstream in(fileName.c_str(), ios::in | ios::binary);
+    if (!in)
+        return;
+
+    in.seekg(0, ios::end);
+    streamoff size = in.tellg();
+    in.seekg(0, ios::beg);
+
+    if (size <= 0)
+    {
+        open_ = (size == 0);
+        return;
+    }
+
+    char *buffer = new char[static_cast<unsigned long>(size)];
+    if (!in.read(buffer, size))
+    {
+        delete [] buffer;
+        return;
+    }
+
+    data_ = buffer;
+    size_ = static_cast<unsigned long>(size);
+    open_ = true;
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ == NULL)
+        return;
+
+#if !defined(_WIN32)
+    if (mapped_)
+    {
+        munmap(const_cast<char*>(data_), size_);
+        return;
+    }
+#endif
+
+    delete [] data_;
+}
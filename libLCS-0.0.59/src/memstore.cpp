@@ -0,0 +1,313 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/memstore.h>
+#include <lcs/mappedfile.h>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+using namespace lcs;
+using namespace std;
+
+const int MemoryStore::PAGE_BITS;
+const unsigned long MemoryStore::PAGE_WORDS;
+
+MemoryStore::MemoryStore(int addrBits, int dataBits)
+    : addrBits_(addrBits), dataBits_(dataBits), limbs_((dataBits + 31) / 32),
+      topMask_((dataBits % 32 == 0) ? ~0u : ((1u << (dataBits % 32)) - 1)),
+      lastPage_(0), last_(NULL)
+{}
+
+MemoryStore::~MemoryStore()
+{
+    map<unsigned long, unsigned int*>::iterator iter;
+    for (iter = pages_.begin(); iter != pages_.end(); ++iter)
+        delete [] iter->second;
+}
+
+bool MemoryStore::contains(unsigned long address) const
+{
+    if (addrBits_ >= static_cast<int>(8 * sizeof(unsigned long)))
+        return true;
+
+    return address < (1UL << addrBits_);
+}
+
+const unsigned int* MemoryStore::find(unsigned long address) const
+{
+    unsigned long page = address >> PAGE_BITS;
+
+    if (last_ == NULL || page != lastPage_)
+    {
+        map<unsigned long, unsigned int*>::const_iterator iter = pages_.find(page);
+        if (iter == pages_.end())
+            return NULL;
+
+        lastPage_ = page;
+        last_ = iter->second;
+    }
+
+    return last_ + (address & (PAGE_WORDS - 1)) * 2 * limbs_;
+}
+
+unsigned int* MemoryStore::word(unsigned long address)
+{
+    const unsigned int *planes = find(address);
+    if (planes != NULL)
+        return const_cast<unsigned int*>(planes);
+
+    // A new page holds only unknown words.
+    unsigned int *page = new unsigned int[PAGE_WORDS * 2 * limbs_];
+    for (unsigned long w = 0; w < PAGE_WORDS; w++)
+    {
+        unsigned int *planes = page + w * 2 * limbs_;
+        for (int k = 0; k < limbs_; k++)
+        {
+            planes[k] = 0;
+            planes[limbs_ + k] = (k == limbs_ - 1) ? topMask_ : ~0u;
+        }
+    }
+
+    pages_[address >> PAGE_BITS] = page;
+    lastPage_ = address >> PAGE_BITS;
+    last_ = page;
+
+    return page + (address & (PAGE_WORDS - 1)) * 2 * limbs_;
+}
+
+void MemoryStore::read(unsigned long address, unsigned int *value, unsigned int *unknown) const
+{
+    const unsigned int *planes = find(address);
+
+    for (int k = 0; k < limbs_; k++)
+    {
+        if (planes != NULL)
+        {
+            value[k] = planes[k];
+            unknown[k] = planes[limbs_ + k];
+        }
+        else
+        {
+            value[k] = 0;
+            unknown[k] = (k == limbs_ - 1) ? topMask_ : ~0u;
+        }
+    }
+}
+
+void MemoryStore::write(unsigned long address, const unsigned int *value,
+                        const unsigned int *unknown)
+{
+    unsigned int *planes = word(address);
+
+    for (int k = 0; k < limbs_; k++)
+    {
+        unsigned int mask = (k == limbs_ - 1) ? topMask_ : ~0u;
+
+        planes[k] = value[k] & mask;
+        planes[limbs_ + k] = unknown[k] & mask;
+    }
+}
+
+void MemoryStore::write(unsigned long address, unsigned long value) throw (MemoryException)
+{
+    if (!contains(address))
+    {
+        ostringstream str;
+        str << "The address " << address << " is not within the memory.";
+        throw MemoryException(str.str());
+    }
+
+    vector<unsigned int> planes(2 * limbs_, 0);
+
+    for (int k = 0; k < limbs_ && k < static_cast<int>(sizeof(unsigned long) / 4); k++)
+        planes[k] = static_cast<unsigned int>(value >> (32 * k));
+
+    write(address, &planes[0], &planes[limbs_]);
+}
+
+string MemoryStore::toStr(unsigned long address) const
+{
+    vector<unsigned int> planes(2 * limbs_);
+    read(address, &planes[0], &planes[limbs_]);
+
+    string str(dataBits_, '0');
+    for (int i = 0; i < dataBits_; i++)
+    {
+        unsigned int bit = 1u << (i % 32);
+        bool high = (planes[i / 32] & bit) != 0, unknown = (planes[limbs_ + i / 32] & bit) != 0;
+
+        if (unknown)
+            str[i] = high ? 'z' : 'x';
+        else if (high)
+            str[i] = '1';
+    }
+
+    return str;
+}
+
+void MemoryStore::load(const string &fileName, MemoryImageFormat format, unsigned long base)
+                       throw (MemoryException)
+{
+    MappedFile file(fileName);
+    if (!file.isOpen())
+        throw MemoryException("Unable to open " + fileName + ".");
+
+    if (format == BINARY_IMAGE)
+        loadBinary(fileName, file.getData(), file.getSize(), base);
+    else
+        loadHex(fileName, file.getData(), file.getSize(), base);
+}
+
+void MemoryStore::loadHex(const string &fileName, const char *data, unsigned long size,
+                          unsigned long base) throw (MemoryException)
+{
+    const char *p = data, *end = data + size;
+    unsigned long address = base;
+    int line = 1;
+    vector<unsigned int> planes(2 * limbs_);
+
+    while (p < end)
+    {
+        if (*p == '\n')
+            line++;
+
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == '\f' || *p == '\v')
+        {
+            p++;
+            continue;
+        }
+
+        if (*p == '/' && p + 1 < end && p[1] == '/')
+        {
+            while (p < end && *p != '\n')
+                p++;
+            continue;
+        }
+
+        const char *start = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '\f'
+               && *p != '\v' && !(*p == '/' && p + 1 < end && p[1] == '/'))
+            p++;
+
+        string token(start, p);
+        ostringstream where;
+        where << fileName << " line " << line << ": ";
+
+        if (token[0] == '@')
+        {
+            address = 0;
+            int digits = 0;
+            for (unsigned int i = 1; i < token.size(); i++)
+            {
+                char ch = token[i];
+                int digit = (ch >= '0' && ch <= '9') ? ch - '0' :
+                            (ch >= 'a' && ch <= 'f') ? ch - 'a' + 10 :
+                            (ch >= 'A' && ch <= 'F') ? ch - 'A' + 10 : -1;
+
+                if (ch == '_')
+                    continue;
+                if (digit < 0)
+                    throw MemoryException(where.str() + "Invalid address " + token + ".");
+
+                address = (address << 4) | static_cast<unsigned long>(digit);
+                digits++;
+            }
+
+            if (digits == 0)
+                throw MemoryException(where.str() + "Invalid address " + token + ".");
+
+            continue;
+        }
+
+        if (!contains(address))
+            throw MemoryException(where.str() + "The image does not fit in the memory.");
+
+        for (int k = 0; k < 2 * limbs_; k++)
+            planes[k] = 0;
+
+        // The digits are read from the least significant one. The digits beyond the width
+        // of the word are dropped.
+        int bit = 0;
+        for (int i = static_cast<int>(token.size()) - 1; i >= 0; i--)
+        {
+            char ch = token[i];
+            if (ch == '_')
+                continue;
+
+            unsigned int value = 0, unknown = 0;
+            if (ch >= '0' && ch <= '9')
+                value = ch - '0';
+            else if (ch >= 'a' && ch <= 'f')
+                value = ch - 'a' + 10;
+            else if (ch >= 'A' && ch <= 'F')
+                value = ch - 'A' + 10;
+            else if (ch == 'x' || ch == 'X')
+                unknown = 0xf;
+            else if (ch == 'z' || ch == 'Z')
+                value = unknown = 0xf;
+            else
+                throw MemoryException(where.str() + "Invalid word " + token + ".");
+
+            if (bit < dataBits_)
+            {
+                planes[bit / 32] |= value << (bit % 32);
+                planes[limbs_ + bit / 32] |= unknown << (bit % 32);
+            }
+
+            bit += 4;
+        }
+
+        write(address++, &planes[0], &planes[limbs_]);
+    }
+}
+
+void MemoryStore::loadBinary(const string &fileName, const char *data, unsigned long size,
+                             unsigned long base) throw (MemoryException)
+{
+    unsigned long bytes = static_cast<unsigned long>((dataBits_ + 7) / 8);
+    if (size % bytes != 0)
+        throw MemoryException("The size of " + fileName + " is not a multiple of the word size.");
+
+    unsigned long words = size / bytes;
+    if (words == 0)
+        return;
+
+    if (!contains(base + words - 1) || base + words - 1 < base)
+        throw MemoryException("The image " + fileName + " does not fit in the memory.");
+
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(data);
+    vector<unsigned int> planes(2 * limbs_, 0);
+
+    for (unsigned long w = 0; w < words; w++)
+    {
+        for (int k = 0; k < limbs_; k++)
+            planes[k] = 0;
+
+        for (unsigned long b = 0; b < bytes; b++)
+            planes[b / 4] |= static_cast<unsigned int>(*p++) << (8 * (b % 4));
+
+        write(base + w, &planes[0], &planes[limbs_]);
+    }
+}
@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/netreader.h>
+#include <lcs/mappedfile.h>
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+// The 64 bit FNV-1a hash of the \p size bytes at \p data.
+unsigned long long contentHash(const char *data, unsigned long size)
+{
+    unsigned long long h = 14695981039346656037ULL;
+
+    for (unsigned long i = 0; i < size; i++)
+    {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+bool endsWith(const string &s, const string &suffix)
+{
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}
+
+FlatNetlist* NetlistReader::load(const string &fileName, const string &cacheFileName)
+                                 throw (NetlistException)
+{
+    bool blif = endsWith(fileName, ".blif");
+    if (!blif && !endsWith(fileName, ".v"))
+        throw NetlistException("The format of the netlist " + fileName + " is not known.");
+
+    unsigned long long key;
+    {
+        MappedFile source(fileName);
+        if (!source.isOpen())
+            throw NetlistException("Unable to open " + fileName + ".");
+
+        key = contentHash(source.getData(), source.getSize());
+    }
+
+    string cache = cacheFileName.empty() ? fileName + ".lcsnet" : cacheFileName;
+
+    FlatNetlist *netlist = FlatNetlist::map(cache, key);
+    if (netlist != NULL)
+        return netlist;
+
+    CircuitLibrary lib;
+    Circuit &top = blif ? readBlif(fileName, lib) : readVerilog(fileName, lib);
+    netlist = new FlatNetlist(top);
+
+    try
+    {
+        netlist->save(cache, key);
+    }
+    catch (NetlistException &)
+    {}
+
+    return netlist;
+}
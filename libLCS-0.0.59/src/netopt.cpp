@@ -0,0 +1,511 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/netopt.h>
+#include <algorithm>
+#include <sstream>
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+bool isSequential(int type) { return type == DFF_CELL || type == DFF_NEG_CELL; }
+
+// The working copy of a netlist being optimized. The inputs of a cell are only ever
+// rewritten or dropped, and hence are kept in place in a copy of the input array.
+class Work
+{
+public:
+    Work(const FlatNetlist &netlist);
+
+    // Returns the net to which the net \p net is aliased.
+    int find(int net)
+    {
+        while (alias[net] != net)
+        {
+            alias[net] = alias[alias[net]];
+            net = alias[net];
+        }
+
+        return net;
+    }
+
+    // Returns true if the net \p net can never change during the simulation.
+    bool isConstant(int net) const { return driver[net] < 0 && !input[net]; }
+
+    void remove(int cell)
+    {
+        alive[cell] = false;
+        driver[out[cell]] = -1;
+    }
+
+    int fold(int cell);
+    void normalize(int cell);
+
+    // Returns true if the output of the cell \p cell is not a function of its current
+    // inputs alone: the output of a sequential cell, or of a cell with a delay, is its
+    // initial state until the cell first changes it.
+    bool holdsState(int cell) const { return isSequential(type[cell]) || delay[cell] != 0; }
+
+    unsigned int hash(int cell) const;
+    bool same(int cell1, int cell2) const;
+
+    vector<int> type, out, first, count, inputs;
+    vector<unsigned int> delay;
+    vector<bool> alive;
+
+    vector<int> initial, driver, alias;
+    vector<bool> input, kept, folded;
+};
+
+Work::Work(const FlatNetlist &netlist)
+{
+    int nets = netlist.getNetCount(), cells = netlist.getCellCount();
+
+    for (int c = 0; c < cells; c++)
+    {
+        type.push_back(netlist.getCellType(c));
+        delay.push_back(netlist.getCellDelay(c));
+        out.push_back(netlist.getCellOutput(c));
+        first.push_back(static_cast<int>(inputs.size()));
+        count.push_back(netlist.getCellInputCount(c));
+
+        for (int i = 0; i < count[c]; i++)
+            inputs.push_back(netlist.getCellInput(c, i));
+    }
+
+    alive.assign(cells, true);
+
+    for (int n = 0; n < nets; n++)
+    {
+        initial.push_back(netlist.getInitialState(n));
+        driver.push_back(netlist.getDriver(n));
+        alias.push_back(n);
+    }
+
+    input.assign(nets, false);
+    kept.assign(nets, false);
+    folded.assign(nets, false);
+
+    for (int p = 0; p < netlist.getPortCount(); p++)
+    {
+        for (int b = 0; b < netlist.getPortWidth(p); b++)
+        {
+            if (netlist.getPortDirection(p) == INPUT_PORT)
+                input[netlist.getPortNet(p) + b] = true;
+            else
+                kept[netlist.getPortNet(p) + b] = true;
+        }
+    }
+}
+
+// Drops the constant inputs of the combinational cell \p cell which do not fix its output.
+// Returns the state of the output if it is fixed by the constant inputs, or -1 otherwise.
+int Work::fold(int cell)
+{
+    int *in = &inputs[first[cell]];
+    int k = 0;
+
+    switch (type[cell])
+    {
+        case BUFFER_CELL :
+            return isConstant(in[0]) ? initial[in[0]] : -1;
+
+        case NOT_CELL :
+            return isConstant(in[0]) ? (initial[in[0]] == HIGH ? LOW : HIGH) : -1;
+
+        case AND_CELL :
+        case NAND_CELL :
+        case OR_CELL :
+        case NOR_CELL :
+        {
+            // A constant input fixes the output if it is LOW for AND and NAND, or HIGH for
+            // OR and NOR. The unknown states count as LOW.
+            bool andLike = (type[cell] == AND_CELL || type[cell] == NAND_CELL);
+            bool inverting = (type[cell] == NAND_CELL || type[cell] == NOR_CELL);
+
+            for (int i = 0; i < count[cell]; i++)
+            {
+                if (!isConstant(in[i]))
+                    in[k++] = in[i];
+                else if ((initial[in[i]] == HIGH) != andLike)
+                    return (andLike == inverting) ? HIGH : LOW;
+            }
+
+            count[cell] = k;
+            if (k == 0)
+                return (andLike != inverting) ? HIGH : LOW;
+
+            return -1;
+        }
+
+        case PARITY_CELL :
+        case NPARITY_CELL :
+        {
+            // A HIGH constant input complements the output, and a pair of inputs connected
+            // to the same net never changes it.
+            bool odd = false;
+
+            sort(in, in + count[cell]);
+            for (int i = 0; i < count[cell]; i++)
+            {
+                if (isConstant(in[i]))
+                    odd = (odd != (initial[in[i]] == HIGH));
+                else if (i + 1 < count[cell] && in[i+1] == in[i])
+                    i++;
+                else
+                    in[k++] = in[i];
+            }
+
+            count[cell] = k;
+            if (odd)
+                type[cell] = (type[cell] == PARITY_CELL) ? NPARITY_CELL : PARITY_CELL;
+
+            if (k == 0)
+                return (type[cell] == NPARITY_CELL) ? HIGH : LOW;
+
+            return -1;
+        }
+    }
+
+    return -1;
+}
+
+// Sorts the inputs of the gate \p cell, and drops the repeated inputs of the gates whose
+// output does not change when an input is repeated.
+void Work::normalize(int cell)
+{
+    int *in = &inputs[first[cell]];
+
+    sort(in, in + count[cell]);
+
+    if (type[cell] == PARITY_CELL || type[cell] == NPARITY_CELL)
+        return;
+
+    count[cell] = static_cast<int>(unique(in, in + count[cell]) - in);
+}
+
+// Returns a hash of the type, the delay and the inputs of the cell \p cell, and of the
+// initial state of its output if the cell holds a state.
+unsigned int Work::hash(int cell) const
+{
+    unsigned int h = 2166136261u;
+
+    h = (h ^ static_cast<unsigned int>(type[cell])) * 16777619u;
+    h = (h ^ delay[cell]) * 16777619u;
+    for (int i = 0; i < count[cell]; i++)
+        h = (h ^ static_cast<unsigned int>(inputs[first[cell] + i])) * 16777619u;
+
+    if (holdsState(cell))
+        h = (h ^ static_cast<unsigned int>(initial[out[cell]])) * 16777619u;
+
+    return h;
+}
+
+// Returns true if the cells \p cell1 and \p cell2 have the same type, delay and inputs,
+// and, if they hold states, the same initial output states.
+bool Work::same(int cell1, int cell2) const
+{
+    if (type[cell1] != type[cell2] || delay[cell1] != delay[cell2] || count[cell1] != count[cell2])
+        return false;
+
+    if (holdsState(cell1) && initial[out[cell1]] != initial[out[cell2]])
+        return false;
+
+    return equal(inputs.begin() + first[cell1], inputs.begin() + first[cell1] + count[cell1],
+                 inputs.begin() + first[cell2]);
+}
+
+// An open addressing hash table of the cells of a netlist, for finding the identical
+// cells in linear time.
+class CellTable
+{
+public:
+    CellTable(const Work &work, int cells) : work_(work), mask_(1)
+    {
+        while (mask_ < 2 * static_cast<unsigned int>(cells))
+            mask_ <<= 1;
+
+        slots_.assign(mask_, -1);
+        mask_--;
+    }
+
+    // Returns a cell identical to \p cell if the table has one. Adds \p cell to the table
+    // and returns -1 otherwise.
+    int insert(int cell)
+    {
+        unsigned int k = work_.hash(cell) & mask_;
+
+        while (slots_[k] >= 0)
+        {
+            if (work_.same(slots_[k], cell))
+                return slots_[k];
+
+            k = (k + 1) & mask_;
+        }
+
+        slots_[k] = cell;
+        return -1;
+    }
+
+private:
+    const Work &work_;
+    unsigned int mask_;
+    vector<int> slots_;
+};
+
+}
+
+NetlistOptimizer::NetlistOptimizer(void)
+    : keepNamed_(false), cells_(0), folded_(0), collapsed_(0), merged_(0), removed_(0)
+{
+    for (int i = 0; i < 4; i++)
+        passes_[i] = true;
+}
+
+void NetlistOptimizer::setPass(OptimizationPass pass, bool enabled)
+{
+    passes_[pass - CONSTANT_FOLDING] = enabled;
+}
+
+bool NetlistOptimizer::isPassEnabled(OptimizationPass pass) const
+{
+    return passes_[pass - CONSTANT_FOLDING];
+}
+
+FlatNetlist* NetlistOptimizer::optimize(const FlatNetlist &netlist) throw (NetlistException)
+{
+    Work w(netlist);
+    int nets = netlist.getNetCount(), cells = netlist.getCellCount();
+
+    cells_ = cells;
+    folded_ = collapsed_ = merged_ = removed_ = 0;
+    removedNets_.clear();
+
+    for (unsigned int i = 0; i < keptNames_.size(); i++)
+    {
+        int net = netlist.findNet(keptNames_[i]);
+        if (net < 0)
+            throw NetlistException("The netlist has no net named " + keptNames_[i] + ".");
+
+        w.kept[net] = true;
+    }
+
+    if (keepNamed_)
+    {
+        for (int n = 0; n < nets; n++)
+        {
+            if (!netlist.getNetName(n).empty())
+                w.kept[n] = true;
+        }
+    }
+
+    bool folding = isPassEnabled(CONSTANT_FOLDING), collapsing = isPassEnabled(BUFFER_COLLAPSING),
+         hashing = isPassEnabled(STRUCTURAL_HASHING);
+
+    // The cells are visited in the topological order of the netlist, so most of the
+    // simplifications propagate forward within a single pass. The passes are repeated for
+    // those which propagate backward, through the loops and the sequential cells.
+    bool changed = folding || collapsing || hashing;
+    while (changed)
+    {
+        changed = false;
+        CellTable table(w, hashing ? cells : 0);
+
+        for (int c = 0; c < cells; c++)
+        {
+            if (!w.alive[c])
+                continue;
+
+            int *in = &w.inputs[w.first[c]];
+            for (int i = 0; i < w.count[c]; i++)
+                in[i] = w.find(in[i]);
+
+            if (!isSequential(w.type[c]))
+            {
+                if (folding)
+                {
+                    // The output of a cell with a delay is unknown until the delay after the
+                    // start, and hence is not constant even if its inputs are.
+                    int state = w.fold(c);
+                    if (state >= 0 && w.delay[c] == 0)
+                    {
+                        w.remove(c);
+                        w.initial[w.out[c]] = state;
+                        w.folded[w.out[c]] = true;
+                        folded_++;
+                        changed = true;
+                        continue;
+                    }
+                }
+
+                if (w.type[c] != BUFFER_CELL && w.type[c] != NOT_CELL)
+                    w.normalize(c);
+            }
+
+            // The kept nets, and the input port nets, are never aliased to other nets.
+            int out = w.out[c];
+            bool fixed = w.kept[out] || w.input[out];
+
+            if (collapsing && !fixed && w.type[c] == BUFFER_CELL && w.delay[c] == 0 && in[0] != out)
+            {
+                w.remove(c);
+                w.alias[out] = in[0];
+                collapsed_++;
+                changed = true;
+                continue;
+            }
+
+            if (!hashing)
+                continue;
+
+            int twin = table.insert(c);
+            if (twin >= 0 && !fixed)
+            {
+                w.remove(c);
+                w.alias[out] = w.out[twin];
+                merged_++;
+                changed = true;
+            }
+        }
+    }
+
+    if (isPassEnabled(DEAD_LOGIC_REMOVAL))
+    {
+        // The cells which drive the kept nets, directly or through other cells, are live.
+        vector<bool> live(cells, false);
+        vector<int> stack;
+
+        for (int n = 0; n < nets; n++)
+        {
+            if (w.kept[n] && w.driver[n] >= 0)
+                stack.push_back(w.driver[n]);
+        }
+
+        while (stack.size() != 0)
+        {
+            int c = stack.back();
+            stack.pop_back();
+
+            if (live[c])
+                continue;
+
+            live[c] = true;
+            for (int i = 0; i < w.count[c]; i++)
+            {
+                int d = w.driver[w.inputs[w.first[c] + i]];
+                if (d >= 0 && !live[d])
+                    stack.push_back(d);
+            }
+        }
+
+        for (int c = 0; c < cells; c++)
+        {
+            if (w.alive[c] && !live[c])
+            {
+                w.remove(c);
+                removed_++;
+            }
+        }
+    }
+
+    FlatNetlist *result = new FlatNetlist(static_cast<MappedFile*>(NULL));
+
+    result->initial_ = w.initial;
+    result->nameOffset_.assign(nets, -1);
+    for (int n = 0; n < nets; n++)
+    {
+        string name = netlist.getNetName(n);
+        if (name.empty())
+            continue;
+
+        // A net which is aliased, or which is no longer driven though it is not constant,
+        // does not carry the state it is named for.
+        if (w.alias[n] != n || (netlist.getDriver(n) >= 0 && w.driver[n] < 0 && !w.folded[n]))
+            removedNets_.push_back(name);
+        else
+            result->setNetName(n, name);
+    }
+
+    result->cellInputOffset_.push_back(0);
+    for (int c = 0; c < cells; c++)
+    {
+        if (!w.alive[c])
+            continue;
+
+        result->cellType_.push_back(w.type[c]);
+        result->cellDelay_.push_back(w.delay[c]);
+        result->cellOutput_.push_back(w.out[c]);
+        result->cellInputs_.insert(result->cellInputs_.end(), w.inputs.begin() + w.first[c],
+                                   w.inputs.begin() + w.first[c] + w.count[c]);
+        result->cellInputOffset_.push_back(static_cast<int>(result->cellInputs_.size()));
+    }
+
+    for (int p = 0; p < netlist.getPortCount(); p++)
+    {
+        result->portName_.push_back(netlist.getPortName(p));
+        result->portDir_.push_back(netlist.getPortDirection(p));
+        result->portNet_.push_back(netlist.getPortNet(p));
+        result->portWidth_.push_back(netlist.getPortWidth(p));
+    }
+
+    try
+    {
+        result->order();
+        result->index();
+    }
+    catch (NetlistException&)
+    {
+        delete result;
+        throw;
+    }
+
+    result->bind();
+
+    return result;
+}
+
+string NetlistOptimizer::getReport(void) const
+{
+    ostringstream ss;
+
+    ss << "Netlist optimization: " << cells_ - folded_ - collapsed_ - merged_ - removed_
+       << " of " << cells_ << " cells kept." << endl;
+    ss << "    Constant cells folded  : " << folded_ << endl;
+    ss << "    Buffers collapsed      : " << collapsed_ << endl;
+    ss << "    Duplicate cells merged : " << merged_ << endl;
+    ss << "    Dead cells removed     : " << removed_ << endl;
+
+    if (removedNets_.size() != 0)
+    {
+        ss << "    Nets removed           :";
+        for (unsigned int i = 0; i < removedNets_.size(); i++)
+            ss << " " << removedNets_[i];
+        ss << endl;
+    }
+
+    return ss.str();
+}
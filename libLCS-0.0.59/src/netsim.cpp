@@ -0,0 +1,473 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/netsim.h>
+#include <lcs/systime.h>
+#include <lcs/writegroup.h>
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+using namespace lcs;
+using namespace std;
+
+// The number of rounds of evaluation, after the delta limit is crossed, in which the
+// oscillating nets are recorded.
+static const unsigned int TRACED_ROUNDS = 16;
+
+NetlistSimulator::NetlistSimulator(const FlatNetlist &netlist, StateMode mode)
+                 : Module(), TickListener(), netlist_(netlist), mode_(mode), unknownNet_(-1),
+                   unknownTime_(0), sequence_(0), evaluations_(0)
+{
+    int nets = netlist_.getNetCount(), cells = netlist_.getCellCount();
+
+    if (mode_ == FOUR_STATE_SIMULATION)
+        state_.resize(nets);
+    else
+        bits_.assign((nets + 31) / 32, 0);
+
+    if (mode_ == CHECKED_TWO_STATE_SIMULATION)
+        unknown_.assign((nets + 31) / 32, 0);
+
+    for (int n = 0; n < nets; n++)
+        write(n, netlist_.getInitialState(n));
+
+    pending_.assign(cells, false);
+    outputBits_.assign((nets + 31) / 32, 0);
+
+    for (int c = 0; c < cells; c++)
+    {
+        CellType type = netlist_.getCellType(c);
+        if (type != DFF_CELL && type != DFF_NEG_CELL)
+        {
+            pending_[c] = true;
+            heap_.push_back(c);
+        }
+    }
+
+    settle();
+
+    SystemTimer::notifyUpdate(this);
+}
+
+NetlistSimulator::NetlistSimulator(const NetlistSimulator &sim)
+                 : Module(), TickListener(), netlist_(sim.netlist_), mode_(sim.mode_),
+                   state_(sim.state_), bits_(sim.bits_), unknown_(sim.unknown_), unknownNet_(-1),
+                   unknownTime_(0), pending_(sim.pending_), events_(sim.events_),
+                   sequence_(sim.sequence_), evaluations_(0), outputBits_(sim.outputBits_.size(), 0)
+{
+    SystemTimer::notifyUpdate(this);
+}
+
+NetlistSimulator::~NetlistSimulator()
+{
+    SystemTimer::stopUpdateNotification(this);
+
+    for (unsigned int i = 0; i < inputs_.size(); i++)
+    {
+        inputs_[i]->stopNotification(this, LINE_STATE_CHANGE, static_cast<int>(i));
+        delete inputs_[i];
+    }
+
+    for (unsigned int i = 0; i < outputs_.size(); i++)
+        delete outputs_[i];
+}
+
+int NetlistSimulator::findPort(const string &port, PortDirection dir, int width) const
+                               throw (NetlistException)
+{
+    int index = netlist_.findPort(port);
+
+    if (index < 0 || netlist_.getPortDirection(index) != dir || netlist_.getPortWidth(index) != width)
+    {
+        ostringstream ss;
+        ss << "The netlist has no " << width << " bit " << (dir == INPUT_PORT ? "input" : "output")
+           << " port named " << port << ".";
+        throw NetlistException(ss.str());
+    }
+
+    return index;
+}
+
+void NetlistSimulator::addInput(int net, const InputBus<1> &line)
+{
+    int index = static_cast<int>(inputs_.size());
+
+    inputs_.push_back(new InputBus<1>(line));
+    inputNet_.push_back(net);
+    inputs_[index]->notify(this, LINE_STATE_CHANGE, index);
+
+    setState(net, inputs_[index]->get(0), true);
+}
+
+void NetlistSimulator::addOutput(int net, const Bus<1> &line)
+{
+    int index = static_cast<int>(outputs_.size());
+
+    outputs_.push_back(new Bus<1>(line));
+    outputNet_.push_back(net);
+    nextOutput_.push_back(isSet(outputBits_, net) ? netOutput_[net] : -1);
+    netOutput_[net] = index;
+    put(outputBits_, net, true);
+
+    outputChanged_.push_back(true);
+    changedOutputs_.push_back(index);
+}
+
+void NetlistSimulator::bindInput(const string &port, const DynBus &bus)
+                                 throw (NetlistException, OscillationException)
+{
+    int net = netlist_.getPortNet(findPort(port, INPUT_PORT, bus.width()));
+
+    for (int i = 0; i < bus.width(); i++)
+        addInput(net + i, bus[i].toBus<1>());
+
+    settle();
+    flush();
+}
+
+void NetlistSimulator::bindOutput(const string &port, const DynBus &bus)
+                                  throw (NetlistException, OscillationException)
+{
+    int net = netlist_.getPortNet(findPort(port, OUTPUT_PORT, bus.width()));
+
+    for (int i = 0; i < bus.width(); i++)
+        addOutput(net + i, bus[i].toBus<1>());
+
+    flush();
+}
+
+LineState NetlistSimulator::getState(const string &name) const throw (NetlistException)
+{
+    int net = netlist_.findNet(name);
+    if (net < 0)
+        throw NetlistException("The netlist has no net named " + name + ".");
+
+    return getState(net);
+}
+
+void NetlistSimulator::onStateChange(int portId)
+{
+    // In the delta evaluation mode, changes on several inputs are notified together.
+    if (portId == ANY_PORT)
+    {
+        for (unsigned int i = 0; i < inputs_.size(); i++)
+            setState(inputNet_[i], inputs_[i]->get(0));
+    }
+    else if (portId >= 0 && portId < static_cast<int>(inputs_.size()))
+        setState(inputNet_[portId], inputs_[portId]->get(0));
+    else
+        return;
+
+    settle();
+    flush();
+}
+
+void NetlistSimulator::onTick(void)
+{
+    unsigned int time = SystemTimer::getTime();
+
+    if (events_.size() == 0 || events_.front().time > time)
+        return;
+
+    while (events_.size() != 0 && events_.front().time <= time)
+    {
+        Event e = events_.front();
+        pop_heap(events_.begin(), events_.end(), greater<Event>());
+        events_.pop_back();
+
+        setState(e.net, e.state);
+    }
+
+    settle();
+    flush();
+}
+
+LineState NetlistSimulator::read(int net) const
+{
+    if (mode_ == FOUR_STATE_SIMULATION)
+        return static_cast<LineState>(state_[net]);
+
+    if (mode_ == CHECKED_TWO_STATE_SIMULATION && isSet(unknown_, net))
+        return UNKNOWN;
+
+    return isSet(bits_, net) ? HIGH : LOW;
+}
+
+bool NetlistSimulator::isHigh(int net) const
+{
+    if (mode_ == FOUR_STATE_SIMULATION)
+        return state_[net] == HIGH;
+
+    return isSet(bits_, net);
+}
+
+void NetlistSimulator::write(int net, LineState state)
+{
+    if (mode_ == FOUR_STATE_SIMULATION)
+    {
+        state_[net] = static_cast<unsigned char>(state);
+        return;
+    }
+
+    put(bits_, net, state == HIGH);
+
+    if (mode_ == CHECKED_TWO_STATE_SIMULATION)
+        put(unknown_, net, state == UNKNOWN || state == HIGH_IMPEDENCE);
+}
+
+void NetlistSimulator::setState(int net, LineState state, bool initial)
+{
+    // The two state modes take the unknown states as LOW; the checked mode records them,
+    // but does not tell them apart.
+    if (mode_ != FOUR_STATE_SIMULATION && (state == UNKNOWN || state == HIGH_IMPEDENCE))
+        state = (mode_ == TWO_STATE_SIMULATION) ? LOW : UNKNOWN;
+
+    LineState old = read(net);
+    if (old == state)
+        return;
+
+    if (state == UNKNOWN && mode_ == CHECKED_TWO_STATE_SIMULATION && unknownNet_ < 0 && !initial)
+    {
+        unknownNet_ = net;
+        unknownTime_ = SystemTimer::getTime();
+    }
+
+    write(net, state);
+
+    if (isSet(outputBits_, net))
+    {
+        for (int o = netOutput_[net]; o >= 0; o = nextOutput_[o])
+        {
+            if (!outputChanged_[o])
+            {
+                outputChanged_[o] = true;
+                changedOutputs_.push_back(o);
+            }
+        }
+    }
+
+    bool posEdge = (state == HIGH && (old == LOW || old == UNKNOWN));
+
+    // In the checked mode, the flipflops see only the changes of the two state values, as
+    // they would in the two state mode.
+    bool edge = (mode_ != CHECKED_TWO_STATE_SIMULATION || (old == HIGH) != (state == HIGH));
+
+    int count = netlist_.getFanoutCount(net);
+    for (int i = 0; i < count; i++)
+    {
+        int c = netlist_.getFanout(net, i);
+        CellType type = netlist_.getCellType(c);
+
+        if (type == DFF_CELL || type == DFF_NEG_CELL)
+        {
+            if (!edge)
+                continue;
+
+            // As with the line events, every change which is not a positive edge is a
+            // negetive edge. The D input is sampled right away, so that the flipflops
+            // triggered together all see the states before any of them changes.
+            bool reset = (netlist_.getCellInputCount(c) == 3);
+            int rst = reset ? netlist_.getCellInput(c, 2) : -1;
+
+            if (reset && net == rst && state == HIGH)
+                sampled_.push_back(make_pair(c, LOW));
+            else if (net == netlist_.getCellInput(c, 1) && posEdge == (type == DFF_CELL))
+            {
+                if (!reset || !isHigh(rst))
+                    sampled_.push_back(make_pair(c, read(netlist_.getCellInput(c, 0))));
+            }
+
+            continue;
+        }
+
+        if (!pending_[c])
+        {
+            pending_[c] = true;
+            heap_.push_back(c);
+            push_heap(heap_.begin(), heap_.end(), greater<int>());
+        }
+    }
+}
+
+void NetlistSimulator::drive(int cell, LineState state)
+{
+    unsigned int delay = netlist_.getCellDelay(cell);
+    int out = netlist_.getCellOutput(cell);
+
+    if (delay == 0)
+    {
+        setState(out, state);
+        return;
+    }
+
+    Event e;
+    e.time = SystemTimer::getTime() + delay;
+    e.sequence = sequence_++;
+    e.net = out;
+    e.state = state;
+
+    events_.push_back(e);
+    push_heap(events_.begin(), events_.end(), greater<Event>());
+}
+
+LineState NetlistSimulator::evaluate(int cell) const
+{
+    int count = netlist_.getCellInputCount(cell);
+
+    switch (netlist_.getCellType(cell))
+    {
+        case BUFFER_CELL :
+            return read(netlist_.getCellInput(cell, 0));
+
+        case NOT_CELL :
+            return isHigh(netlist_.getCellInput(cell, 0)) ? LOW : HIGH;
+
+        case AND_CELL :
+        case NAND_CELL :
+        {
+            bool high = true;
+            for (int i = 0; i < count && high; i++)
+                high = isHigh(netlist_.getCellInput(cell, i));
+
+            return (high == (netlist_.getCellType(cell) == AND_CELL)) ? HIGH : LOW;
+        }
+
+        case OR_CELL :
+        case NOR_CELL :
+        {
+            bool high = false;
+            for (int i = 0; i < count && !high; i++)
+                high = isHigh(netlist_.getCellInput(cell, i));
+
+            return (high == (netlist_.getCellType(cell) == OR_CELL)) ? HIGH : LOW;
+        }
+
+        case PARITY_CELL :
+        case NPARITY_CELL :
+        {
+            bool odd = false;
+            for (int i = 0; i < count; i++)
+            {
+                if (isHigh(netlist_.getCellInput(cell, i)))
+                    odd = !odd;
+            }
+
+            return (odd == (netlist_.getCellType(cell) == PARITY_CELL)) ? HIGH : LOW;
+        }
+
+        default :
+            return read(netlist_.getCellOutput(cell));
+    }
+}
+
+void NetlistSimulator::settle(void) throw (OscillationException)
+{
+    // A cell evaluated after a cell of a higher index starts a new round of evaluation,
+    // which happens only on the zero delay loops. The rounds are counted to enforce the
+    // delta limit; the nets driven in the rounds after the limit are the oscillating ones.
+    unsigned int limit = SystemTimer::getDeltaLimit(), rounds = 0;
+    set<int> traced;
+    int last = -1;
+
+    while (true)
+    {
+        // The pending cells are evaluated in the topological order of their indices.
+        while (heap_.size() != 0)
+        {
+            int c = heap_.front();
+            pop_heap(heap_.begin(), heap_.end(), greater<int>());
+            heap_.pop_back();
+
+            if (c <= last && limit != 0 && ++rounds > limit && rounds - limit > TRACED_ROUNDS)
+                oscillate(traced);
+
+            if (rounds > limit && limit != 0)
+                traced.insert(netlist_.getCellOutput(c));
+
+            last = c;
+            pending_[c] = false;
+            evaluations_++;
+
+            drive(c, evaluate(c));
+        }
+
+        if (sampled_.size() == 0)
+            break;
+
+        vector< pair<int, LineState> > sampled;
+        sampled.swap(sampled_);
+
+        for (unsigned int i = 0; i < sampled.size(); i++)
+            drive(sampled[i].first, sampled[i].second);
+
+        last = -1;
+    }
+
+    if (traced.size() != 0)
+        oscillate(traced);
+}
+
+void NetlistSimulator::oscillate(const set<int> &nets) throw (OscillationException)
+{
+    for (unsigned int i = 0; i < heap_.size(); i++)
+        pending_[heap_[i]] = false;
+
+    heap_.clear();
+    sampled_.clear();
+
+    vector<string> names;
+    int unnamed = 0;
+
+    for (set<int>::const_iterator iter = nets.begin(); iter != nets.end(); ++iter)
+    {
+        string name = netlist_.getNetName(*iter);
+        if (name.size() != 0)
+            names.push_back(name);
+        else
+            unnamed++;
+    }
+
+    sort(names.begin(), names.end());
+
+    throw OscillationException(SystemTimer::getTime(), SystemTimer::getDeltaLimit(), names, unnamed);
+}
+
+void NetlistSimulator::flush(void)
+{
+    if (changedOutputs_.size() == 0)
+        return;
+
+    vector<int> changed;
+    changed.swap(changedOutputs_);
+
+    WriteGroup group;
+    for (unsigned int i = 0; i < changed.size(); i++)
+    {
+        int o = changed[i];
+
+        outputChanged_[o] = false;
+        *outputs_[o] = (0, getState(outputNet_[o]));
+    }
+}
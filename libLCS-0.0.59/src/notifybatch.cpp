@@ -0,0 +1,214 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/notifybatch.h>
+#include <algorithm>
+
+using namespace lcs;
+
+namespace
+{
+
+// Delivers a notification. The notification carries the line state changes changes[0] to
+// changes[count-1] if changes is not NULL.
+void deliver(Module *mod, int portId, LineEvent event, const BitChange *changes, int count)
+{
+    if (changes != NULL)
+    {
+        mod->onBitsChange(portId, changes, count);
+        return;
+    }
+
+    switch (event)
+    {
+        case LINE_STATE_CHANGE : { mod->onStateChange(portId); break; }
+        case LINE_POS_EDGE     : { mod->onPosEdge(portId); break; }
+        case LINE_NEG_EDGE     : { mod->onNegEdge(portId); break; }
+    }
+}
+
+// Orders the line state changes by their ports and line indices.
+bool changeLess(const BitChange &l, const BitChange &r)
+{
+    return l.portId < r.portId || (l.portId == r.portId && l.bit < r.bit);
+}
+
+bool sameLine(const BitChange &l, const BitChange &r)
+{
+    return l.portId == r.portId && l.bit == r.bit;
+}
+
+}
+
+int NotificationBatch::find(Module *mod, int portId, LineEvent event, bool &added)
+{
+    std::pair<Module*, int> key(mod, static_cast<int>(event));
+
+    std::map< std::pair<Module*, int>, int >::iterator iter = added_.find(key);
+
+    if (iter != added_.end())
+    {
+        // The module is already dirty for the event. It keeps the port id if the event
+        // occured only on that port, and re-reads all its inputs otherwise.
+        if (ports_[iter->second] != portId)
+            ports_[iter->second] = ANY_PORT;
+
+        added = false;
+        return iter->second;
+    }
+
+    int index = static_cast<int>(mods_.size());
+    added_[key] = index;
+
+    mods_.push_back(mod);
+    ports_.push_back(portId);
+    events_.push_back(event);
+    bitsOnly_.push_back(false);
+
+    added = true;
+    return index;
+}
+
+void NotificationBatch::add(Module *mod, int portId, LineEvent event)
+{
+    bool added;
+    bitsOnly_[find(mod, portId, event, added)] = false;
+}
+
+void NotificationBatch::add(Module *mod, const BitChange &change)
+{
+    bool added;
+    int index = find(mod, change.portId, LINE_STATE_CHANGE, added);
+
+    if (added)
+        bitsOnly_[index] = true;
+
+    if (bitsOnly_[index])
+    {
+        changes_.push_back(change);
+        changeEntry_.push_back(index);
+    }
+}
+
+void NotificationBatch::dispatch(void)
+{
+    std::vector<Module*> mods;
+    std::vector<int> ports;
+    std::vector<LineEvent> events;
+    std::vector<bool> bitsOnly;
+    std::vector<BitChange> changes;
+    std::vector<int> changeEntry;
+
+    mods.swap(mods_);
+    ports.swap(ports_);
+    events.swap(events_);
+    bitsOnly.swap(bitsOnly_);
+    changes.swap(changes_);
+    changeEntry.swap(changeEntry_);
+    added_.clear();
+
+    int n = static_cast<int>(mods.size());
+
+    // The changes carried by the notification i are sorted[first[i]] to
+    // sorted[first[i+1]-1].
+    std::vector<int> first(n + 1, 0);
+    std::vector<BitChange> sorted(changes.size());
+    if (changes.size() != 0)
+    {
+        for (unsigned int k = 0; k < changes.size(); k++)
+            first[changeEntry[k] + 1]++;
+
+        for (int i = 0; i < n; i++)
+            first[i + 1] += first[i];
+
+        std::vector<int> fill(first.begin(), first.end() - 1);
+        for (unsigned int k = 0; k < changes.size(); k++)
+            sorted[fill[changeEntry[k]]++] = changes[k];
+    }
+
+    // The group of every notification; -1 for the ones delivered individually. A design
+    // has only a few module types, so that the evaluators are looked up linearly, starting
+    // with the one of the previous notification.
+    std::vector<BatchEvaluator> evaluators;
+    std::vector<int> group(n, -1), offset(1, 0);
+
+    if (groupTypes_)
+    {
+        int last = -1;
+        for (int i = 0; i < n; i++)
+        {
+            BatchEvaluator evaluator = mods[i]->getBatchEvaluator();
+            if (evaluator == NULL || events[i] != LINE_STATE_CHANGE || bitsOnly[i])
+                continue;
+
+            if (last < 0 || evaluators[last] != evaluator)
+            {
+                last = 0;
+                while (last < static_cast<int>(evaluators.size()) && evaluators[last] != evaluator)
+                    last++;
+
+                if (last == static_cast<int>(evaluators.size()))
+                {
+                    evaluators.push_back(evaluator);
+                    offset.push_back(0);
+                }
+            }
+
+            group[i] = last;
+            offset[last + 1]++;
+        }
+
+        for (unsigned int g = 0; g < evaluators.size(); g++)
+            offset[g + 1] += offset[g];
+    }
+
+    // The modules of a group and their port ids are placed contiguously.
+    std::vector<Module*> groupMods(offset.back());
+    std::vector<int> groupPorts(offset.back()), fill(offset.begin(), offset.end() - 1);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (group[i] >= 0)
+        {
+            int k = fill[group[i]]++;
+            groupMods[k] = mods[i];
+            groupPorts[k] = ports[i];
+        }
+        else if (bitsOnly[i])
+        {
+            // Only the first change of every line is kept, as it holds the state of the
+            // line before the batch.
+            BitChange *begin = &sorted[0] + first[i], *end = &sorted[0] + first[i + 1];
+            std::stable_sort(begin, end, changeLess);
+            end = std::unique(begin, end, sameLine);
+
+            deliver(mods[i], ports[i], events[i], begin, static_cast<int>(end - begin));
+        }
+        else
+            deliver(mods[i], ports[i], events[i], NULL, 0);
+    }
+
+    for (unsigned int g = 0; g < evaluators.size(); g++)
+        evaluators[g](&groupMods[offset[g]], &groupPorts[offset[g]], offset[g + 1] - offset[g]);
+}
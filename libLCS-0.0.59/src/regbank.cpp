@@ -0,0 +1,314 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/regbank.h>
+#include <lcs/writegroup.h>
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+// Returns the mask of the bits of the top limb of a \p width bit word.
+unsigned int topMask(int width)
+{
+    return (width % 32 == 0) ? ~0u : ((1u << (width % 32)) - 1);
+}
+
+// Shifts the plane \p src left by one bit into \p dst, shifting \p in into bit 0.
+void shiftUp(const vector<unsigned int> &src, vector<unsigned int> &dst, int width, unsigned int in)
+{
+    unsigned int carry = in;
+    for (unsigned int k = 0; k < src.size(); k++)
+    {
+        dst[k] = (src[k] << 1) | carry;
+        carry = src[k] >> 31;
+    }
+
+    dst.back() &= topMask(width);
+}
+
+// Shifts the plane \p src right by one bit into \p dst, shifting \p in into the most
+// significant bit of the \p width bit word.
+void shiftDown(const vector<unsigned int> &src, vector<unsigned int> &dst, int width, unsigned int in)
+{
+    unsigned int carry = 0;
+    for (int k = static_cast<int>(src.size()) - 1; k >= 0; k--)
+    {
+        dst[k] = (src[k] >> 1) | (carry << 31);
+        carry = src[k] & 1;
+    }
+
+    dst[(width - 1) / 32] |= in << ((width - 1) % 32);
+}
+
+// Returns the parity of the bits of \p word.
+unsigned int parity(unsigned int word)
+{
+    word ^= word >> 16;
+    word ^= word >> 8;
+    word ^= word >> 4;
+    word ^= word >> 2;
+    word ^= word >> 1;
+
+    return word & 1;
+}
+
+}
+
+RegisterBank::Reg::Reg(Kind k, const DynBus &o, const DynBus &i)
+    : kind(k), out(o), in(i), enable(NULL), taps(0)
+{
+    int limbs = (out.width() + 31) / 32;
+
+    value.assign(limbs, 0);
+    unknown.assign(limbs, ~0u);
+    unknown.back() = topMask(out.width());
+
+    nextValue = value;
+    nextUnknown = unknown;
+    drivenValue = value;
+    drivenUnknown = unknown;
+}
+
+RegisterBank::RegisterBank(const InputBus<1> &clk, PulseEdge edge, unsigned int delay)
+    : Module(), clk_(clk), edge_(edge), delay_(delay), hasReset_(false)
+{
+    clk_.notify(this, (edge_ == POS_EDGE) ? LINE_POS_EDGE : LINE_NEG_EDGE, 0);
+}
+
+RegisterBank::RegisterBank(const InputBus<1> &clk, const InputBus<1> &reset, PulseEdge edge,
+                           unsigned int delay)
+    : Module(), clk_(clk), reset_(reset), edge_(edge), delay_(delay), hasReset_(true)
+{
+    clk_.notify(this, (edge_ == POS_EDGE) ? LINE_POS_EDGE : LINE_NEG_EDGE, 0);
+    reset_.notify(this, LINE_STATE_CHANGE, 0);
+}
+
+RegisterBank::~RegisterBank()
+{
+    clk_.stopNotification(this, (edge_ == POS_EDGE) ? LINE_POS_EDGE : LINE_NEG_EDGE, 0);
+
+    if (hasReset_)
+        reset_.stopNotification(this, LINE_STATE_CHANGE, 0);
+
+    for (unsigned int i = 0; i < regs_.size(); i++)
+    {
+        delete regs_[i]->enable;
+        delete regs_[i];
+    }
+}
+
+int RegisterBank::add(Reg *reg, unsigned long resetValue)
+{
+    reg->resetValue.assign(reg->value.size(), 0);
+    for (unsigned int k = 0; k < reg->value.size() && k < sizeof(unsigned long) / 4; k++)
+        reg->resetValue[k] = static_cast<unsigned int>(resetValue >> (32 * k));
+
+    reg->resetValue.back() &= topMask(reg->out.width());
+
+    regs_.push_back(reg);
+
+    // A register added while the bank is being reset is reset right away. The registers
+    // of a bank which is never reset take their reset values when they are added.
+    if (!hasReset_ || reset_.get(0) == HIGH)
+    {
+        WriteGroup group;
+        load(*reg);
+    }
+
+    return static_cast<int>(regs_.size()) - 1;
+}
+
+int RegisterBank::addRegister(const DynBus &out, const DynBus &in, unsigned long resetValue)
+                              throw (OutOfRangeException<int>)
+{
+    if (in.width() != out.width())
+        throw OutOfRangeException<int>(out.width(), out.width(), in.width());
+
+    return add(new Reg(LOAD, out, in), resetValue);
+}
+
+int RegisterBank::addShiftRegister(const DynBus &out, const InputBus<1> &in, Shift shift,
+                                   unsigned long resetValue)
+{
+    return add(new Reg((shift == LEFT_SHIFT) ? SHIFT_LEFT : SHIFT_RIGHT, out, DynBus(in)),
+               resetValue);
+}
+
+int RegisterBank::addLfsr(const DynBus &out, unsigned long taps, unsigned long seed)
+                          throw (OutOfRangeException<int>)
+{
+    int bits = static_cast<int>(8 * sizeof(unsigned long));
+    if (out.width() > bits)
+        throw OutOfRangeException<int>(1, bits, out.width());
+
+    Reg *reg = new Reg(LFSR, out, out);
+    reg->taps = taps;
+
+    return add(reg, seed);
+}
+
+void RegisterBank::setEnable(int index, const InputBus<1> &enable) throw (OutOfRangeException<int>)
+{
+    if (index < 0 || index >= getRegisterCount())
+        throw OutOfRangeException<int>(0, getRegisterCount() - 1, index);
+
+    delete regs_[index]->enable;
+    regs_[index]->enable = new InputBus<1>(enable);
+}
+
+void RegisterBank::onStateChange(int portId)
+{
+    if (reset_.get(0) != HIGH)
+        return;
+
+    WriteGroup group;
+    for (unsigned int i = 0; i < regs_.size(); i++)
+        load(*regs_[i]);
+}
+
+void RegisterBank::load(Reg &reg)
+{
+    reg.value = reg.resetValue;
+    reg.unknown.assign(reg.unknown.size(), 0);
+    drive(reg, 0);
+}
+
+void RegisterBank::onEdge(void)
+{
+    if (hasReset_ && reset_.get(0) == HIGH)
+        return;
+
+    // All the registers are sampled before any of them changes.
+    for (unsigned int i = 0; i < regs_.size(); i++)
+        sample(*regs_[i]);
+
+    WriteGroup group;
+    for (unsigned int i = 0; i < regs_.size(); i++)
+    {
+        Reg &reg = *regs_[i];
+
+        reg.value.swap(reg.nextValue);
+        reg.unknown.swap(reg.nextUnknown);
+        drive(reg, delay_);
+    }
+}
+
+void RegisterBank::sample(Reg &reg) const
+{
+    int width = reg.out.width();
+
+    if (reg.enable != NULL && reg.enable->get(0) != HIGH)
+    {
+        reg.nextValue = reg.value;
+        reg.nextUnknown = reg.unknown;
+        return;
+    }
+
+    switch (reg.kind)
+    {
+        case LOAD :
+        {
+            reg.nextValue.assign(reg.value.size(), 0);
+            reg.nextUnknown.assign(reg.value.size(), 0);
+
+            for (int i = 0; i < width; i++)
+            {
+                LineState state = reg.in.get(i);
+                unsigned int bit = 1u << (i % 32);
+
+                if (state == HIGH || state == HIGH_IMPEDENCE)
+                    reg.nextValue[i / 32] |= bit;
+                if (state == UNKNOWN || state == HIGH_IMPEDENCE)
+                    reg.nextUnknown[i / 32] |= bit;
+            }
+
+            break;
+        }
+
+        case SHIFT_LEFT :
+        case SHIFT_RIGHT :
+        {
+            LineState state = reg.in.get(0);
+            unsigned int value = (state == HIGH || state == HIGH_IMPEDENCE) ? 1 : 0,
+                         unknown = (state == UNKNOWN || state == HIGH_IMPEDENCE) ? 1 : 0;
+
+            if (reg.kind == SHIFT_LEFT)
+            {
+                shiftUp(reg.value, reg.nextValue, width, value);
+                shiftUp(reg.unknown, reg.nextUnknown, width, unknown);
+            }
+            else
+            {
+                shiftDown(reg.value, reg.nextValue, width, value);
+                shiftDown(reg.unknown, reg.nextUnknown, width, unknown);
+            }
+
+            break;
+        }
+
+        case LFSR :
+        {
+            unsigned int value = 0, unknown = 0;
+            for (unsigned int k = 0; k < reg.value.size(); k++)
+            {
+                unsigned int taps = static_cast<unsigned int>(reg.taps >> (32 * k));
+
+                value ^= parity(reg.value[k] & taps);
+                if (reg.unknown[k] & taps)
+                    unknown = 1;
+            }
+
+            shiftUp(reg.value, reg.nextValue, width, unknown ? 0 : value);
+            shiftUp(reg.unknown, reg.nextUnknown, width, unknown);
+            break;
+        }
+    }
+}
+
+void RegisterBank::drive(Reg &reg, unsigned int delay)
+{
+    for (int i = 0; i < reg.out.width(); i++)
+    {
+        int k = i / 32;
+        unsigned int bit = 1u << (i % 32);
+
+        if (((reg.value[k] ^ reg.drivenValue[k]) & bit) == 0
+            && ((reg.unknown[k] ^ reg.drivenUnknown[k]) & bit) == 0)
+            continue;
+
+        LineState state = LOW;
+        if (reg.unknown[k] & bit)
+            state = (reg.value[k] & bit) ? HIGH_IMPEDENCE : UNKNOWN;
+        else if (reg.value[k] & bit)
+            state = HIGH;
+
+        reg.out.set(i, state, delay);
+    }
+
+    reg.drivenValue = reg.value;
+    reg.drivenUnknown = reg.unknown;
+}
@@ -25,6 +25,7 @@
 #include <lcs/simul.h>
 #include <lcs/systime.h>
 #include <lcs/hiddenmodman.h>
+#include <lcs/exprgraph.h>
 #include <lcs/vcdman.h>
 #include <lcs/clock.h>
 #include <iostream>
@@ -38,9 +39,22 @@ void Simulation::start()
          << "--------------------------------------\n\n";
 
     VCDManager::init();
-    SystemTimer::start();
+
+    try
+    {
+        SystemTimer::start();
+    }
+    catch (OscillationException &)
+    {
+        SystemTimer::clearHiddenQueue();
+        HiddenModuleManager::destroyModules();
+        ExpressionGraph::destroy();
+        VCDManager::terminate();
+        throw;
+    }
 
     HiddenModuleManager::destroyModules();
+    ExpressionGraph::destroy();
 
     cout << "\n"
          << "--------------------------------------\n\n"
@@ -63,3 +77,18 @@ void Simulation::setStopTime(unsigned int stopTime)
 {
     SystemTimer::setStopTime(stopTime);
 }
+
+void Simulation::setExpressionGraphMode(bool enable)
+{
+    ExpressionGraph::setEnabled(enable);
+}
+
+void Simulation::setEvaluationMode(const EvaluationMode &mode)
+{
+    SystemTimer::setEvaluationMode(mode);
+}
+
+void Simulation::setDeltaLimit(unsigned int limit)
+{
+    SystemTimer::setDeltaLimit(limit);
+}
@@ -25,27 +25,83 @@
 #include <lcs/systime.h>
 #include <lcs/line.h>
 #include <lcs/clock.h>
+#include <lcs/notifybatch.h>
+#include <algorithm>
 
 using namespace lcs;
+using namespace std;
+
+// The number of delta cycles, after the delta limit is crossed, in which the oscillating
+// lines are recorded.
+static const unsigned int TRACED_DELTAS = 16;
 
 unsigned int SystemTimer::time = 0;
 unsigned int SystemTimer::hiddenTime = 0;
 unsigned int SystemTimer::stoptime = 0;
+EvaluationMode SystemTimer::evalMode = IMMEDIATE_EVALUATION;
+unsigned int SystemTimer::writeGroup = 0;
+unsigned int SystemTimer::writeGroupDepth = 0;
+unsigned int SystemTimer::lastWriteGroup = 0;
+unsigned int SystemTimer::deltaLimit = 100000;
+unsigned int SystemTimer::nonblockingDepth = 0;
+bool SystemTimer::tracing = false;
 
 List<TickListener*> SystemTimer::tlList = List<TickListener*>();
+List<TickListener*> SystemTimer::ulList = List<TickListener*>();
 List< List<Line*>* > SystemTimer::refLists = List< List<Line*>* >();
 Queue< List<Line*>* > SystemTimer::hiddenQueue = Queue< List<Line*>* >();
+Queue< unsigned int > SystemTimer::hiddenGroupQueue = Queue< unsigned int >();
+set< List<Line*>* > SystemTimer::traced;
+map< List<Line*>*, string > SystemTimer::lineNames;
+vector< pair< List<Line*>*, LineState > > SystemTimer::nonblockingWrites;
 
 Clock *SystemTimer::clock = NULL;
 
 void SystemTimer::setStopTime(unsigned int stopTime) { stoptime = stopTime; }
 
+void SystemTimer::setEvaluationMode(const EvaluationMode &mode) { evalMode = mode; }
+
+void SystemTimer::setDeltaLimit(unsigned int limit) { deltaLimit = limit; }
+
+void SystemTimer::nameLine(List<Line*> *list, const string &name)
+{
+    if (list != NULL)
+        lineNames[list] = name;
+}
+
+void SystemTimer::forgetLine(List<Line*> *list)
+{
+    if (!lineNames.empty())
+        lineNames.erase(list);
+
+    // A buffered write to a line which ceases to exist is dropped.
+    for (unsigned int i = 0; i < nonblockingWrites.size(); )
+    {
+        if (nonblockingWrites[i].first == list)
+            nonblockingWrites.erase(nonblockingWrites.begin() + i);
+        else
+            i++;
+    }
+}
+
 void SystemTimer::notifyTick(TickListener *tl)
 {
     if (tl != NULL)
         tlList.append(tl);
 }
 
+void SystemTimer::notifyUpdate(TickListener *tl)
+{
+    if (tl != NULL)
+        ulList.append(tl);
+}
+
+void SystemTimer::stopUpdateNotification(TickListener *tl)
+{
+    if (tl != NULL)
+        ulList.removeFirstMatch(tl);
+}
+
 void SystemTimer::notifyClock(Clock *clk)
 {
     if (clk != NULL && clock == NULL)
@@ -61,7 +117,48 @@ void SystemTimer::notifyLine(List<Line*> *list)
 void SystemTimer::notifyHiddenTick(List<Line*> *list)
 {
     if (list != NULL)
+    {
         hiddenQueue.enQueue(list);
+        hiddenGroupQueue.enQueue(writeGroup);
+    }
+}
+
+void SystemTimer::beginWriteGroup(void)
+{
+    if (writeGroupDepth++ == 0)
+    {
+        lastWriteGroup++;
+        if (lastWriteGroup == 0)
+            lastWriteGroup++;
+
+        writeGroup = lastWriteGroup;
+    }
+}
+
+void SystemTimer::endWriteGroup(void)
+{
+    if (writeGroupDepth == 0)
+        return;
+
+    if (--writeGroupDepth == 0)
+        writeGroup = 0;
+}
+
+void SystemTimer::beginNonblocking(void) { nonblockingDepth++; }
+
+void SystemTimer::endNonblocking(void)
+{
+    if (nonblockingDepth != 0)
+        nonblockingDepth--;
+}
+
+bool SystemTimer::deferWrite(List<Line*> *list, const LineState &value)
+{
+    if (nonblockingDepth == 0 || list == NULL)
+        return false;
+
+    nonblockingWrites.push_back(make_pair(list, value));
+    return true;
 }
 
 unsigned int SystemTimer::getTime(void) { return time; }
@@ -104,6 +201,7 @@ void SystemTimer::start(void)
     {
         time++;
 
+        NotificationBatch batch(evalMode == BATCHED_EVALUATION);
         ListIterator< List<Line*>* > refIter = refLists.getListIterator();
         refIter.reset();
         while (refIter.hasNext())
@@ -112,7 +210,18 @@ void SystemTimer::start(void)
 
             Line *line = list->first();
             if (line != NULL)
-                line->update();
+                line->update(&batch);
+        }
+
+        batch.dispatch();
+
+        ListIterator<TickListener*> updateIter = ulList.getListIterator();
+        updateIter.reset();
+        while (updateIter.hasNext())
+        {
+            TickListener *tl = updateIter.next();
+            if (tl != NULL)
+                tl->onTick();
         }
 
         updateHiddenDelays();
@@ -136,17 +245,163 @@ void SystemTimer::start(void)
 
 void SystemTimer::updateHiddenDelays(void)
 {
-    while (hiddenQueue.getSize() != 0)
+    unsigned int deltas = 0;
+
+    // The nonblocking writes are committed once the zero delay changes have settled, and
+    // the changes due to them are made in the same manner, until nothing is pending.
+    do
+    {
+        if (evalMode != IMMEDIATE_EVALUATION)
+        {
+            // Each pass of the loop is a delta cycle: the lines which are due to change in
+            // the cycle take their new states, and then every module driven by them is
+            // notified once. The changes made by the modules form the next delta cycle.
+            while (hiddenQueue.getSize() != 0)
+            {
+                nextDelta(deltas);
+
+                NotificationBatch batch(evalMode == BATCHED_EVALUATION);
+
+                for (int n = hiddenQueue.getSize(); n > 0; n--)
+                    updateHiddenLine(&batch);
+
+                batch.dispatch();
+            }
+
+            continue;
+        }
+
+        // The changes are made one at a time here. The changes queued while the ones of a
+        // delta cycle are made form the next delta cycle; the cycles are counted only to
+        // enforce the delta limit.
+        int cycle = 0;
+        while (hiddenQueue.getSize() != 0)
+        {
+            if (cycle <= 0)
+            {
+                cycle = hiddenQueue.getSize();
+                nextDelta(deltas);
+            }
+
+            unsigned int group = hiddenGroupQueue.getFirstInQueue();
+
+            if (group == 0)
+            {
+                updateHiddenLine(NULL);
+                cycle--;
+
+                continue;
+            }
+
+            // All the lines written in a write group take their new states before any of
+            // the modules driven by them is notified.
+            NotificationBatch batch;
+            while (hiddenQueue.getSize() != 0 && hiddenGroupQueue.getFirstInQueue() == group)
+            {
+                updateHiddenLine(&batch);
+                cycle--;
+            }
+
+            batch.dispatch();
+        }
+    }
+    while (commitNonblocking());
+
+    if (tracing)
+        oscillate();
+
+    hiddenTime = 0;
+}
+
+bool SystemTimer::commitNonblocking(void)
+{
+    if (nonblockingWrites.empty())
+        return false;
+
+    vector< pair< List<Line*>*, LineState > > writes;
+    writes.swap(nonblockingWrites);
+
+    // The writes are made as zero delay writes, even if the region in which they were
+    // buffered is still open.
+    unsigned int depth = nonblockingDepth;
+    nonblockingDepth = 0;
+
+    beginWriteGroup();
+    for (unsigned int i = 0; i < writes.size(); i++)
+    {
+        Line *line = writes[i].first->first();
+        if (line != NULL)
+            *line = writes[i].second;
+    }
+    endWriteGroup();
+
+    nonblockingDepth = depth;
+
+    return hiddenQueue.getSize() != 0;
+}
+
+void SystemTimer::updateHiddenLine(NotificationBatch *batch)
+{
+    hiddenTime++;
+    List<Line*> *hdList = hiddenQueue.getFirstInQueue();
+
+    if (tracing)
+        traced.insert(hdList);
+
+    Line *hdLine = hdList->first();
+    if (hdLine != NULL)
+        hdLine->hiddenUpdate(batch);
+
+    hiddenQueue.deQueue();
+    hiddenGroupQueue.deQueue();
+}
+
+void SystemTimer::nextDelta(unsigned int &deltas) throw (OscillationException)
+{
+    deltas++;
+    if (deltaLimit == 0 || deltas <= deltaLimit)
+        return;
+
+    // The lines which change in the few delta cycles after the limit is crossed are the
+    // ones which oscillate. They are recorded for the diagnostic.
+    if (deltas - deltaLimit > TRACED_DELTAS)
+        oscillate();
+
+    tracing = true;
+}
+
+void SystemTimer::oscillate(void) throw (OscillationException)
+{
+    vector<string> names;
+    int unnamed = 0;
+
+    set< List<Line*>* >::const_iterator iter;
+    for (iter = traced.begin(); iter != traced.end(); ++iter)
     {
-        hiddenTime++;
-        List<Line*> *hdList = hiddenQueue.getFirstInQueue();
+        map< List<Line*>*, string >::const_iterator name = lineNames.find(*iter);
+        if (name != lineNames.end())
+            names.push_back(name->second);
+        else
+            unnamed++;
+    }
 
-        Line *hdLine = hdList->first();
-        if (hdLine != NULL)
-            hdLine->hiddenUpdate();
+    sort(names.begin(), names.end());
 
+    traced.clear();
+    tracing = false;
+    clearHiddenQueue();
+
+    throw OscillationException(time, deltaLimit, names, unnamed);
+}
+
+void SystemTimer::clearHiddenQueue(void)
+{
+    while (hiddenQueue.getSize() != 0)
+    {
         hiddenQueue.deQueue();
+        hiddenGroupQueue.deQueue();
     }
 
+    nonblockingWrites.clear();
     hiddenTime = 0;
 }
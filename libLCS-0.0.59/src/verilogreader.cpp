@@ -0,0 +1,855 @@
+//////////////////////////////////////////////////////////////////////////////////
+// This file is distributed as part of the libLCS library.
+// libLCS is C++ Logic Circuit Simulation library.
+//
+// Copyright (c) 2006-2007, B. R. Siva Chandra
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+// In case you would like to contact the author, use the following e-mail
+// address: sivachandra_br@yahoo.com
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <lcs/netreader.h>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace lcs;
+using namespace std;
+
+namespace
+{
+
+enum TokenType { IDENT_TOKEN, NUMBER_TOKEN, SYMBOL_TOKEN, END_TOKEN };
+
+struct Token
+{
+    TokenType type;
+    string text;
+    int line;
+};
+
+// Splits a Verilog input into identifiers, numbers (including sized constants like
+// 4'b10x1) and single character symbols. Comments, compiler directives and attributes
+// are dropped.
+class VerilogLexer
+{
+public:
+    VerilogLexer(istream &in) : buf_(in.rdbuf()), line_(1), peeked_(false) {}
+
+    const Token& peek(void)
+    {
+        if (!peeked_)
+        {
+            read(token_);
+            peeked_ = true;
+        }
+
+        return token_;
+    }
+
+    Token next(void)
+    {
+        peek();
+        peeked_ = false;
+
+        return token_;
+    }
+
+    int getLine(void) { return peek().line; }
+
+private:
+    int get(void)
+    {
+        int c = buf_->sbumpc();
+        if (c == '\n')
+            line_++;
+
+        return c;
+    }
+
+    int look(void) { return buf_->sgetc(); }
+
+    void skip(void)
+    {
+        const int eof = char_traits<char>::eof();
+
+        while (true)
+        {
+            int c = look();
+
+            if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                get();
+            else if (c == '/' || c == '`' || c == '(')
+            {
+                if (c == '`')
+                {
+                    while (look() != eof && look() != '\n')
+                        get();
+                    continue;
+                }
+
+                get();
+                int d = look();
+
+                if (c == '/' && d == '/')
+                {
+                    while (look() != eof && look() != '\n')
+                        get();
+                }
+                else if ((c == '/' || c == '(') && d == '*')
+                {
+                    // A block comment, or an attribute instance.
+                    get();
+                    int prev = 0;
+                    while (look() != eof)
+                    {
+                        int e = get();
+                        if (prev == '*' && e == (c == '/' ? '/' : ')'))
+                            break;
+                        prev = e;
+                    }
+                }
+                else
+                {
+                    buf_->sungetc();
+                    return;
+                }
+            }
+            else
+                return;
+        }
+    }
+
+    static bool isIdent(int c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+               || c == '_' || c == '$';
+    }
+
+    void read(Token &token)
+    {
+        skip();
+
+        token.text.clear();
+        token.line = line_;
+
+        int c = look();
+        if (c == char_traits<char>::eof())
+        {
+            token.type = END_TOKEN;
+            return;
+        }
+
+        if (c == '\\')
+        {
+            // An escaped identifier ends at white space.
+            get();
+            while (look() != char_traits<char>::eof() && look() != ' ' && look() != '\t'
+                   && look() != '\r' && look() != '\n')
+                token.text += static_cast<char>(get());
+
+            token.type = IDENT_TOKEN;
+        }
+        else if ((c >= '0' && c <= '9') || c == '\'')
+        {
+            while (look() >= '0' && look() <= '9')
+                token.text += static_cast<char>(get());
+
+            if (look() == '\'')
+            {
+                token.text += static_cast<char>(get());
+                if (look() == 's' || look() == 'S')
+                    get();
+                if (look() != char_traits<char>::eof())
+                    token.text += static_cast<char>(get());
+
+                while (isIdent(look()) || look() == '?')
+                    token.text += static_cast<char>(get());
+            }
+
+            token.type = NUMBER_TOKEN;
+        }
+        else if (isIdent(c))
+        {
+            while (isIdent(look()))
+                token.text += static_cast<char>(get());
+
+            token.type = IDENT_TOKEN;
+        }
+        else
+        {
+            token.text += static_cast<char>(get());
+            token.type = SYMBOL_TOKEN;
+        }
+    }
+
+    streambuf *buf_;
+    int line_;
+    Token token_;
+    bool peeked_;
+};
+
+struct Instance
+{
+    Circuit *parent;
+    string module, name;
+    bool named;
+    vector< pair< string, vector<int> > > connections;
+    int line;
+};
+
+class VerilogParser
+{
+public:
+    VerilogParser(istream &in, CircuitLibrary &lib) : lexer_(in), lib_(lib), cur_(NULL) {}
+
+    Circuit& parse(void) throw (NetlistException);
+
+private:
+    void error(const string &message, int line = -1) throw (NetlistException)
+    {
+        ostringstream ss;
+        ss << "Verilog line " << (line < 0 ? lexer_.getLine() : line) << ": " << message;
+        throw NetlistException(ss.str());
+    }
+
+    bool accept(const char *text)
+    {
+        if (lexer_.peek().type != END_TOKEN && lexer_.peek().text == text)
+        {
+            lexer_.next();
+            return true;
+        }
+
+        return false;
+    }
+
+    void expect(const char *text)
+    {
+        if (!accept(text))
+            error(string("Expected '") + text + "' but found '" + lexer_.peek().text + "'.");
+    }
+
+    string identifier(void)
+    {
+        if (lexer_.peek().type != IDENT_TOKEN)
+            error("Expected an identifier but found '" + lexer_.peek().text + "'.");
+
+        return lexer_.next().text;
+    }
+
+    int number(void)
+    {
+        if (lexer_.peek().type != NUMBER_TOKEN || lexer_.peek().text.find('\'') != string::npos)
+            error("Expected a number but found '" + lexer_.peek().text + "'.");
+
+        return atoi(lexer_.next().text.c_str());
+    }
+
+    int constant(LineState state)
+    {
+        map<int, int>::iterator iter = constants_.find(state);
+        if (iter != constants_.end())
+            return iter->second;
+
+        int net = cur_->addConstant(state);
+        constants_[state] = net;
+
+        return net;
+    }
+
+    void module(void);
+
+    void declaration(const string &kind);
+
+    void declare(const string &kind, const string &name, int msb, int lsb);
+
+    void constantBits(const string &text, vector<int> &bits);
+
+    void term(vector<int> &bits);
+
+    void assign(void);
+
+    void gate(const string &kind);
+
+    void instance(const string &module);
+
+    void resolve(const Instance &inst);
+
+    VerilogLexer lexer_;
+    CircuitLibrary &lib_;
+    Circuit *cur_;
+    map< string, pair<int, int> > ranges_;
+    map<int, int> constants_;
+    vector<Circuit*> modules_;
+    map< const Circuit*, vector<string> > headers_;
+    vector<Instance> instances_;
+    set<string> instantiated_;
+};
+
+void VerilogParser::declare(const string &kind, const string &name, int msb, int lsb)
+{
+    int width = (msb > lsb ? msb - lsb : lsb - msb) + 1;
+
+    if (cur_->findNet(name) >= 0)
+    {
+        // For example, an output which is declared a wire as well.
+        pair<int, int> range = ranges_[name];
+        if (kind != "wire" && kind != "reg" && cur_->findPort(name) >= 0)
+            error("Port " + name + " is declared more than once.");
+        if (range.first != msb || range.second != lsb)
+            error("Net " + name + " is redeclared with a different range.");
+
+        return;
+    }
+
+    if (kind == "input")
+        cur_->addInput(name, width);
+    else if (kind == "output")
+        cur_->addOutput(name, width);
+    else
+        cur_->addNet(name, width);
+
+    ranges_[name] = make_pair(msb, lsb);
+
+    if (kind == "supply0" || kind == "supply1")
+    {
+        int net = cur_->findNet(name);
+        for (int i = 0; i < width; i++)
+            cur_->addCell(BUFFER_CELL, constant(kind == "supply1" ? HIGH : LOW), net + i);
+    }
+}
+
+void VerilogParser::declaration(const string &kind)
+{
+    if (kind == "input" || kind == "output")
+        accept("wire");
+
+    int msb = 0, lsb = 0;
+    if (accept("["))
+    {
+        msb = number();
+        expect(":");
+        lsb = number();
+        expect("]");
+    }
+
+    do
+    {
+        string name = identifier();
+        declare(kind, name, msb, lsb);
+
+        // A net declaration assignment.
+        if (kind == "wire" && lexer_.peek().text == "=")
+        {
+            lexer_.next();
+
+            vector<int> lhs, rhs;
+            int net = cur_->findNet(name);
+            for (int i = 0; i < (msb > lsb ? msb - lsb : lsb - msb) + 1; i++)
+                lhs.push_back(net + i);
+
+            bool invert = accept("~");
+            term(rhs);
+
+            for (unsigned int i = 0; i < lhs.size(); i++)
+                cur_->addCell(invert ? NOT_CELL : BUFFER_CELL, i < rhs.size() ? rhs[i] : constant(LOW), lhs[i]);
+        }
+    } while (accept(","));
+
+    expect(";");
+}
+
+void VerilogParser::constantBits(const string &text, vector<int> &bits)
+{
+    string::size_type quote = text.find('\'');
+    if (quote == string::npos)
+    {
+        // An unsized decimal constant is 32 bits wide.
+        unsigned long value = strtoul(text.c_str(), NULL, 10);
+        for (int i = 0; i < 32; i++)
+            bits.push_back(constant((value >> i) & 1 ? HIGH : LOW));
+
+        return;
+    }
+
+    int width = (quote == 0) ? 32 : atoi(text.substr(0, quote).c_str());
+    char base = (quote + 1 < text.size()) ? text[quote + 1] : 'd';
+    string digits = text.substr(quote + 2);
+
+    vector<LineState> value;
+    if (base == 'd' || base == 'D')
+    {
+        unsigned long v = strtoul(digits.c_str(), NULL, 10);
+        for (int i = 0; i < 32; i++)
+            value.push_back((v >> i) & 1 ? HIGH : LOW);
+    }
+    else
+    {
+        int shift = (base == 'b' || base == 'B') ? 1 : (base == 'o' || base == 'O') ? 3
+                  : (base == 'h' || base == 'H') ? 4 : 0;
+        if (shift == 0)
+            error("Invalid constant " + text + ".");
+
+        for (int i = static_cast<int>(digits.size()) - 1; i >= 0; i--)
+        {
+            char d = digits[i];
+            if (d == '_')
+                continue;
+
+            LineState special = LOW;
+            int v = 0;
+            if (d == 'x' || d == 'X')
+                special = UNKNOWN;
+            else if (d == 'z' || d == 'Z' || d == '?')
+                special = HIGH_IMPEDENCE;
+            else if (d >= '0' && d <= '9')
+                v = d - '0';
+            else if (d >= 'a' && d <= 'f')
+                v = d - 'a' + 10;
+            else if (d >= 'A' && d <= 'F')
+                v = d - 'A' + 10;
+
+            if (v >= (1 << shift))
+                error("Invalid constant " + text + ".");
+
+            for (int b = 0; b < shift; b++)
+                value.push_back(special != LOW ? special : ((v >> b) & 1 ? HIGH : LOW));
+        }
+    }
+
+    for (int i = 0; i < width; i++)
+        bits.push_back(constant(i < static_cast<int>(value.size()) ? value[i] : LOW));
+}
+
+void VerilogParser::term(vector<int> &bits)
+{
+    if (accept("{"))
+    {
+        // A replication, or a concatenation whose last part holds the least significant
+        // bits.
+        if (lexer_.peek().type == NUMBER_TOKEN)
+        {
+            int count = number();
+            expect("{");
+
+            vector<int> part;
+            term(part);
+            expect("}");
+            expect("}");
+
+            for (int i = 0; i < count; i++)
+                bits.insert(bits.end(), part.begin(), part.end());
+
+            return;
+        }
+
+        vector< vector<int> > parts;
+        do
+        {
+            parts.push_back(vector<int>());
+            term(parts.back());
+        } while (accept(","));
+
+        expect("}");
+
+        for (int i = static_cast<int>(parts.size()) - 1; i >= 0; i--)
+            bits.insert(bits.end(), parts[i].begin(), parts[i].end());
+
+        return;
+    }
+
+    if (lexer_.peek().type == NUMBER_TOKEN)
+    {
+        constantBits(lexer_.next().text, bits);
+        return;
+    }
+
+    string name = identifier();
+    int net = cur_->findNet(name);
+
+    if (net < 0)
+    {
+        // An implicit net.
+        if (lexer_.peek().text == "[")
+            error("Undeclared net " + name + ".");
+
+        declare("wire", name, 0, 0);
+        bits.push_back(cur_->findNet(name));
+        return;
+    }
+
+    pair<int, int> range = ranges_[name];
+    int msb = range.first, lsb = range.second;
+
+    if (!accept("["))
+    {
+        for (int i = 0; i <= (msb > lsb ? msb - lsb : lsb - msb); i++)
+            bits.push_back(net + i);
+
+        return;
+    }
+
+    int first = number(), last = first;
+    if (accept(":"))
+        last = number();
+    expect("]");
+
+    int low = msb < lsb ? msb : lsb, high = msb < lsb ? lsb : msb;
+    if (first < low || first > high || last < low || last > high)
+        error("Select out of the range of " + name + ".");
+
+    int step = (first >= last) ? 1 : -1;
+    for (int i = last; ; i += step)
+    {
+        bits.push_back(net + (msb >= lsb ? i - lsb : lsb - i));
+        if (i == first)
+            break;
+    }
+}
+
+void VerilogParser::assign(void)
+{
+    do
+    {
+        vector<int> lhs, rhs;
+        term(lhs);
+        expect("=");
+
+        bool invert = accept("~");
+        term(rhs);
+
+        for (unsigned int i = 0; i < lhs.size(); i++)
+            cur_->addCell(invert ? NOT_CELL : BUFFER_CELL, i < rhs.size() ? rhs[i] : constant(LOW), lhs[i]);
+    } while (accept(","));
+
+    expect(";");
+}
+
+void VerilogParser::gate(const string &kind)
+{
+    CellType type = BUFFER_CELL;
+    if (kind == "and") type = AND_CELL;
+    else if (kind == "nand") type = NAND_CELL;
+    else if (kind == "or") type = OR_CELL;
+    else if (kind == "nor") type = NOR_CELL;
+    else if (kind == "xor") type = PARITY_CELL;
+    else if (kind == "xnor") type = NPARITY_CELL;
+    else if (kind == "not") type = NOT_CELL;
+
+    unsigned int delay = 0;
+    if (accept("#"))
+    {
+        bool paren = accept("(");
+        delay = static_cast<unsigned int>(number());
+        if (paren)
+            expect(")");
+    }
+
+    do
+    {
+        if (lexer_.peek().type == IDENT_TOKEN)
+            lexer_.next();
+
+        vector<int> terminals;
+        expect("(");
+        do
+        {
+            vector<int> bits;
+            term(bits);
+            if (bits.size() != 1)
+                error("The terminals of a " + kind + " gate should be single bits.");
+
+            terminals.push_back(bits[0]);
+        } while (accept(","));
+        expect(")");
+
+        if (terminals.size() < 2)
+            error("The " + kind + " gate should have at least two terminals.");
+
+        // The buf and not gates have several outputs and one input; the others have one
+        // output and several inputs.
+        if (type == BUFFER_CELL || type == NOT_CELL)
+        {
+            for (unsigned int i = 0; i + 1 < terminals.size(); i++)
+                cur_->addCell(type, terminals.back(), terminals[i], delay);
+        }
+        else
+            cur_->addCell(type, vector<int>(terminals.begin() + 1, terminals.end()), terminals[0], delay);
+    } while (accept(","));
+
+    expect(";");
+}
+
+void VerilogParser::instance(const string &module)
+{
+    if (lexer_.peek().text == "#")
+        error("Parameterized instances are not supported.");
+
+    instantiated_.insert(module);
+
+    do
+    {
+        Instance inst;
+        inst.parent = cur_;
+        inst.module = module;
+        inst.line = lexer_.getLine();
+        inst.name = identifier();
+
+        expect("(");
+        inst.named = (lexer_.peek().text == ".");
+
+        if (lexer_.peek().text != ")")
+        {
+            do
+            {
+                string port;
+                vector<int> bits;
+
+                if (inst.named)
+                {
+                    expect(".");
+                    port = identifier();
+                    expect("(");
+                    if (lexer_.peek().text != ")")
+                        term(bits);
+                    expect(")");
+                }
+                else if (lexer_.peek().text != "," && lexer_.peek().text != ")")
+                    term(bits);
+
+                inst.connections.push_back(make_pair(port, bits));
+            } while (accept(","));
+        }
+
+        expect(")");
+        instances_.push_back(inst);
+    } while (accept(","));
+
+    expect(";");
+}
+
+void VerilogParser::module(void)
+{
+    cur_ = &lib_.define(identifier());
+    modules_.push_back(cur_);
+    ranges_.clear();
+    constants_.clear();
+
+    vector<string> &header = headers_[cur_];
+
+    if (accept("("))
+    {
+        string kind;
+        int msb = 0, lsb = 0;
+
+        while (lexer_.peek().text != ")")
+        {
+            string text = lexer_.peek().text;
+
+            if (text == "input" || text == "output" || text == "inout")
+            {
+                // An ANSI style port declaration.
+                lexer_.next();
+                if (text == "inout")
+                    error("Bidirectional ports are not supported.");
+
+                kind = text;
+                msb = lsb = 0;
+                accept("wire");
+                if (accept("["))
+                {
+                    msb = number();
+                    expect(":");
+                    lsb = number();
+                    expect("]");
+                }
+            }
+
+            string name = identifier();
+            if (kind.size() != 0)
+                declare(kind, name, msb, lsb);
+            header.push_back(name);
+
+            if (!accept(","))
+                break;
+        }
+
+        expect(")");
+    }
+
+    expect(";");
+
+    while (!accept("endmodule"))
+    {
+        if (lexer_.peek().type == END_TOKEN)
+            error("Missing endmodule.");
+
+        string word = identifier();
+
+        if (word == "input" || word == "output" || word == "wire" || word == "tri"
+            || word == "supply0" || word == "supply1")
+            declaration(word == "tri" ? "wire" : word);
+        else if (word == "assign")
+            assign();
+        else if (word == "and" || word == "nand" || word == "or" || word == "nor" || word == "xor"
+                 || word == "xnor" || word == "buf" || word == "not")
+            gate(word);
+        else if (word == "inout" || word == "reg" || word == "always" || word == "initial"
+                 || word == "parameter" || word == "defparam" || word == "function" || word == "task"
+                 || word == "generate")
+            error("The " + word + " construct is not supported.");
+        else
+            instance(word);
+    }
+
+    // The ports which are listed in the header but never declared.
+    for (unsigned int i = 0; i < header.size(); i++)
+    {
+        if (cur_->findPort(header[i]) < 0)
+            error("Port " + header[i] + " of module " + cur_->getName() + " is not declared.");
+    }
+}
+
+void VerilogParser::resolve(const Instance &inst)
+{
+    Circuit *def = lib_.find(inst.module);
+    Circuit *parent = inst.parent;
+
+    if (def == NULL)
+    {
+        if (inst.module != "dff" || inst.connections.size() != 3)
+            error("Undefined module " + inst.module + ".", inst.line);
+
+        // The ISCAS89 flipflop, with the ports (CK, Q, D).
+        vector<int> ck, q, d;
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            const string &port = inst.connections[i].first;
+            const vector<int> &bits = inst.connections[i].second;
+            int index = !inst.named ? static_cast<int>(i) : (port == "CK" ? 0 : port == "Q" ? 1 : port == "D" ? 2 : -1);
+
+            if (index < 0 || bits.size() != 1)
+                error("Invalid connection to the dff instance " + inst.name + ".", inst.line);
+
+            (index == 0 ? ck : index == 1 ? q : d) = bits;
+        }
+
+        if (ck.size() == 0 || q.size() == 0 || d.size() == 0)
+            error("Invalid connection to the dff instance " + inst.name + ".", inst.line);
+
+        vector<int> inputs(2);
+        inputs[0] = d[0];
+        inputs[1] = ck[0];
+        parent->addCell(DFF_CELL, inputs, q[0]);
+
+        return;
+    }
+
+    map< const Circuit*, vector<string> >::const_iterator header = headers_.find(def);
+    int id = parent->addInstance(inst.name, *def);
+
+    for (unsigned int i = 0; i < inst.connections.size(); i++)
+    {
+        const vector<int> &bits = inst.connections[i].second;
+        if (bits.size() == 0)
+            continue;
+
+        string port = inst.connections[i].first;
+        if (!inst.named)
+        {
+            int count = (header != headers_.end()) ? static_cast<int>(header->second.size()) : def->getPortCount();
+            if (static_cast<int>(i) >= count)
+                error("Too many connections to the instance " + inst.name + ".", inst.line);
+
+            port = (header != headers_.end()) ? header->second[i] : def->getPortName(i);
+        }
+
+        parent->connect(id, port, bits);
+    }
+}
+
+Circuit& VerilogParser::parse(void) throw (NetlistException)
+{
+    try
+    {
+        while (lexer_.peek().type != END_TOKEN)
+        {
+            if (identifier() != "module")
+                error("Expected a module.");
+
+            module();
+        }
+    }
+    catch (NetlistException &e)
+    {
+        string message = e.getMessage();
+        if (message.compare(0, 8, "Verilog ") == 0)
+            throw;
+
+        error(message.substr(0, message.size() - 1));
+    }
+
+    if (modules_.size() == 0)
+        throw NetlistException("The Verilog input does not have a module.");
+
+    // The instances are connected once all the modules are known.
+    for (unsigned int i = 0; i < instances_.size(); i++)
+    {
+        try
+        {
+            resolve(instances_[i]);
+        }
+        catch (NetlistException &e)
+        {
+            string message = e.getMessage();
+            if (message.compare(0, 8, "Verilog ") == 0)
+                throw;
+
+            error(message.substr(0, message.size() - 1), instances_[i].line);
+        }
+    }
+
+    for (unsigned int i = 0; i < modules_.size(); i++)
+    {
+        if (instantiated_.find(modules_[i]->getName()) == instantiated_.end())
+            return *modules_[i];
+    }
+
+    return *modules_[0];
+}
+
+}
+
+Circuit& NetlistReader::readVerilog(istream &in, CircuitLibrary &lib) throw (NetlistException)
+{
+    VerilogParser parser(in, lib);
+    return parser.parse();
+}
+
+Circuit& NetlistReader::readVerilog(const string &fileName, CircuitLibrary &lib)
+                                    throw (NetlistException)
+{
+    ifstream in(fileName.c_str());
+    if (!in)
+        throw NetlistException("Unable to open " + fileName + ".");
+
+    return readVerilog(in, lib);
+}